@@ -33,6 +33,7 @@
     #include "libdnf5/base/text_validator_callback.hpp"
     #include "libdnf5/base/text_validator.hpp"
     #include "libdnf5/base/interaction_callbacks.hpp"
+    #include "libdnf5/base/tracer.hpp"
     #include "libdnf5/base/solver_problems.hpp"
     #include "libdnf5/base/log_event.hpp"
     #include "libdnf5/base/transaction.hpp"
@@ -195,6 +196,10 @@
 
 wrap_unique_ptr(InteractionCallbacksUniquePtr, libdnf5::base::InteractionCallbacks);
 
+%ignore libdnf5::base::Tracer::Scope;
+%include "libdnf5/base/tracer.hpp"
+%template(VectorTraceSpan) std::vector<libdnf5::base::TraceSpan>;
+
 %include "libdnf5/base/base.hpp"
 
 %include "libdnf5/base/solver_problems.hpp"
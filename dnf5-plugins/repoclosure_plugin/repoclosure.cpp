@@ -30,6 +30,10 @@
 #include <libdnf5/utils/format.hpp>
 
 #include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 
 namespace dnf5 {
@@ -168,23 +172,24 @@ void RepoclosureCommand::run() {
     }
 
 
-    // cache query results: reldepid -> whether the reldep is satisfied
-    std::unordered_map<int, bool> resolved;
+    // Cache of checked reldeps: reldep id -> index into unsatisfied_reldeps, or SATISFIED. Each distinct
+    // reldep is resolved and formatted only once. The loop stays serial because the first provider lookup
+    // of a relational dependency writes its result into the libsolv pool, and these lookups are the bulk
+    // of the work.
+    constexpr std::size_t SATISFIED = std::numeric_limits<std::size_t>::max();
+    std::unordered_map<int, std::size_t> resolved;
+    std::vector<std::string> unsatisfied_reldeps;
     std::vector<std::pair<libdnf5::rpm::Package, std::vector<std::string>>> unresolved_packages;
     for (const auto & pkg : to_check_query) {
         std::vector<std::string> unsatisfied;
         for (const auto & reldep : pkg.get_requires()) {
-            int reldep_id = reldep.get_id().id;
-            auto resolved_it = resolved.find(reldep_id);
-            bool satisfied;
-            if (resolved_it == resolved.end()) {
-                satisfied = available_query.is_dep_satisfied(reldep);
-                resolved.emplace(reldep_id, satisfied);
-            } else {
-                satisfied = resolved_it->second;
+            auto [resolved_it, inserted] = resolved.try_emplace(reldep.get_id().id, SATISFIED);
+            if (inserted && !available_query.is_dep_satisfied(reldep)) {
+                resolved_it->second = unsatisfied_reldeps.size();
+                unsatisfied_reldeps.emplace_back(reldep.to_string());
             }
-            if (!satisfied) {
-                unsatisfied.emplace_back(reldep.to_string());
+            if (resolved_it->second != SATISFIED) {
+                unsatisfied.emplace_back(unsatisfied_reldeps[resolved_it->second]);
             }
         }
         if (!unsatisfied.empty()) {
@@ -0,0 +1,119 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "journal.hpp"
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace dnf5 {
+
+namespace {
+
+struct FileStamp {
+    std::uintmax_t size;
+    std::int64_t mtime;
+};
+
+std::optional<FileStamp> get_file_stamp(const std::filesystem::path & path) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    return FileStamp{size, static_cast<std::int64_t>(mtime.time_since_epoch().count())};
+}
+
+}  // namespace
+
+
+ReposyncJournal::ReposyncJournal(std::filesystem::path path) : path(std::move(path)) {
+    std::ifstream journal_stream(this->path);
+    for (std::string line; std::getline(journal_stream, line);) {
+        std::vector<std::string> fields;
+        std::size_t start = 0;
+        for (int i = 0; i < 4; ++i) {
+            auto end = line.find('\t', start);
+            if (end == std::string::npos) {
+                break;
+            }
+            fields.emplace_back(line.substr(start, end - start));
+            start = end + 1;
+        }
+        if (fields.size() != 4 || start >= line.size()) {
+            continue;
+        }
+        try {
+            entries[line.substr(start)] = Entry{
+                .checksum = std::move(fields[0]),
+                .size = std::stoull(fields[1]),
+                .mtime = std::stoll(fields[2]),
+                .verified = fields[3] == "1"};
+        } catch (const std::logic_error &) {
+            continue;
+        }
+    }
+}
+
+
+const ReposyncJournal::Entry * ReposyncJournal::find_valid(
+    const std::filesystem::path & pkg_path, const std::string & checksum) const {
+    auto it = entries.find(pkg_path.string());
+    if (it == entries.end() || it->second.checksum != checksum) {
+        return nullptr;
+    }
+    auto stamp = get_file_stamp(pkg_path);
+    if (!stamp || stamp->size != it->second.size || stamp->mtime != it->second.mtime) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+
+bool ReposyncJournal::open() {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    stream.open(path, std::ios::trunc);
+    return static_cast<bool>(stream);
+}
+
+
+void ReposyncJournal::keep(const std::filesystem::path & pkg_path, const Entry & entry) {
+    write(pkg_path, entry);
+}
+
+
+void ReposyncJournal::record(const std::filesystem::path & pkg_path, const std::string & checksum, bool verified) {
+    if (auto stamp = get_file_stamp(pkg_path)) {
+        write(pkg_path, Entry{.checksum = checksum, .size = stamp->size, .mtime = stamp->mtime, .verified = verified});
+    }
+}
+
+
+void ReposyncJournal::write(const std::filesystem::path & pkg_path, const Entry & entry) {
+    stream << entry.checksum << '\t' << entry.size << '\t' << entry.mtime << '\t' << (entry.verified ? '1' : '0')
+           << '\t' << pkg_path.string() << '\n';
+}
+
+}  // namespace dnf5
@@ -0,0 +1,78 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef DNF5_PLUGINS_REPOSYNC_PLUGIN_JOURNAL_HPP
+#define DNF5_PLUGINS_REPOSYNC_PLUGIN_JOURNAL_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace dnf5 {
+
+/// Journal of the packages that reposync completely downloaded (and verified), so that an interrupted
+/// or repeated synchronization skips them without rehashing. Each line contains tab separated checksum,
+/// size, mtime, verified flag and absolute path of the downloaded package.
+class ReposyncJournal {
+public:
+    struct Entry {
+        std::string checksum;
+        std::uintmax_t size;
+        std::int64_t mtime;
+        bool verified;
+    };
+
+    /// Load the journal stored in `path`. Malformed lines (e.g. the last one written during an interruption)
+    /// are ignored.
+    explicit ReposyncJournal(std::filesystem::path path);
+
+    /// Return the entry recorded for `pkg_path` if it has the `checksum` and the file did not change since,
+    /// nullptr otherwise.
+    const Entry * find_valid(const std::filesystem::path & pkg_path, const std::string & checksum) const;
+
+    /// Truncate the journal file and start writing entries into it. The loaded entries remain available
+    /// to find_valid(). Return false if the file cannot be written.
+    bool open();
+
+    /// Write back a loaded entry returned by find_valid().
+    void keep(const std::filesystem::path & pkg_path, const Entry & entry);
+
+    /// Record the current state of the downloaded file `pkg_path`.
+    void record(const std::filesystem::path & pkg_path, const std::string & checksum, bool verified);
+
+    /// Flush the written entries to the journal file, so that they survive an interruption.
+    void flush() { stream.flush(); }
+
+    const std::filesystem::path & get_path() const noexcept { return path; }
+
+private:
+    void write(const std::filesystem::path & pkg_path, const Entry & entry);
+
+    std::filesystem::path path;
+    // loaded entries by the absolute path of the downloaded package
+    std::unordered_map<std::string, Entry> entries;
+    std::ofstream stream;
+};
+
+}  // namespace dnf5
+
+
+#endif  // DNF5_PLUGINS_REPOSYNC_PLUGIN_JOURNAL_HPP
@@ -19,7 +19,11 @@
 
 #include "reposync.hpp"
 
+#include "journal.hpp"
+
 #include <libdnf5-cli/exception.hpp>
+#include <libdnf5-cli/utils/units.hpp>
+#include <libdnf5/base/base.hpp>
 #include <libdnf5/common/sack/exclude_flags.hpp>
 #include <libdnf5/conf/const.hpp>
 #include <libdnf5/conf/option_string.hpp>
@@ -31,12 +35,28 @@
 #include <libdnf5/utils/bgettext/bgettext-lib.h>
 #include <libdnf5/utils/bgettext/bgettext-mark-domain.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <future>
 #include <string>
 #include <string_view>
 #include <vector>
 
 namespace {
 
+// Name of the journal file stored in the repository cache directory. It is kept outside of the download path,
+// which is published as a mirror and is shared by all repositories with --norepopath.
+constexpr const char * JOURNAL_FILE_NAME = "reposync.journal";
+
+// Maximum number of packages handed to a single PackageDownloader. It bounds the memory used by download
+// targets and progress bars and allows verifying one window while the next one is being downloaded.
+constexpr std::size_t DOWNLOAD_WINDOW_SIZE = 512;
+
+std::string get_journal_checksum(const libdnf5::rpm::Package & pkg) {
+    auto checksum = pkg.get_checksum();
+    return checksum.get_type_str() + ":" + checksum.get_checksum();
+}
+
 static std::string join_url(const std::string & base, const std::string & path) {
     if (base.back() == '/' && path.front() == '/') {
         return base + path.substr(1);
@@ -145,6 +165,15 @@ void ReposyncCommand::set_argument_parser() {
     metadata_path_arg->set_arg_value_help("<DIR>");
     metadata_path_arg->link_value(metadata_path_option);
     cmd.register_named_arg(metadata_path_arg);
+
+    auto * package_store_arg = parser.add_new_named_arg("package_store");
+    package_store_arg->set_long_name("package-store");
+    package_store_arg->set_description(
+        "Content-addressed store of packages shared among repositories, identical packages are downloaded only once");
+    package_store_arg->set_has_value(true);
+    package_store_arg->set_arg_value_help("<DIR>");
+    package_store_arg->link_value(&ctx.get_base().get_config().get_package_store_dir_option());
+    cmd.register_named_arg(package_store_arg);
 }
 
 void ReposyncCommand::configure() {
@@ -274,23 +303,125 @@ ReposyncCommand::download_list_type ReposyncCommand::get_packages_list(const lib
     return result;
 }
 
-void ReposyncCommand::download_packages(const ReposyncCommand::download_list_type & pkg_list) {
-    libdnf5::repo::PackageDownloader downloader(get_context().get_base());
-    downloader.force_keep_packages(true);
-    // do not stop on the first error but download as much packages as available
-    downloader.set_fail_fast(false);
-    for (const auto & [pth, pkg] : pkg_list) {
-        downloader.add(pkg, pth.parent_path());
+bool ReposyncCommand::download_packages(const libdnf5::repo::Repo & repo, const download_list_type & pkg_list) {
+    auto & base = get_context().get_base();
+    const bool gpgcheck = gpgcheck_option->get_value();
+    ReposyncJournal journal(std::filesystem::path(repo.get_cachedir()) / JOURNAL_FILE_NAME);
+
+    // The journal is rewritten with the entries that are still valid, new entries are appended as windows complete.
+    if (!journal.open()) {
+        std::cerr << libdnf5::utils::sformat(_("Failed to write reposync journal '{}'"), journal.get_path().string())
+                  << std::endl;
     }
-    downloader.download();
-    const auto failed_packages = downloader.get_failed_packages();
-    if (!failed_packages.empty()) {
-        for (const auto & pkg : failed_packages) {
-            std::cerr << libdnf5::utils::sformat(_("Failed to download package: {}"), pkg.get_full_nevra())
-                      << std::endl;
+
+    // Packages to process paired with the flag whether they need to be downloaded. Packages unchanged since
+    // they were recorded in the journal are only verified if it was not done yet.
+    std::vector<std::pair<const download_list_type::value_type *, bool>> to_process;
+    for (const auto & item : pkg_list) {
+        const auto & [pth, pkg] = item;
+        if (const auto * entry = journal.find_valid(pth, get_journal_checksum(pkg))) {
+            journal.keep(pth, *entry);
+            if (gpgcheck && !entry->verified) {
+                to_process.emplace_back(&item, false);
+            }
+        } else {
+            to_process.emplace_back(&item, true);
+        }
+    }
+    journal.flush();
+
+    bool pgp_ok{true};
+    auto record_window = [&](const download_window_type & window, const pgp_failures_type & pgp_failures) {
+        for (const auto & failure : pgp_failures) {
+            std::cerr << failure.second << std::endl;
+            pgp_ok = false;
+        }
+        for (const auto * item : window) {
+            const auto & [pth, pkg] = *item;
+            if (std::find_if(pgp_failures.begin(), pgp_failures.end(), [&pth](const auto & failure) {
+                    return failure.first == pth;
+                }) != pgp_failures.end()) {
+                continue;
+            }
+            journal.record(pth, get_journal_checksum(pkg), gpgcheck);
+        }
+        journal.flush();
+    };
+
+    // OpenPGP check of a downloaded window runs in the background while the next window is being downloaded.
+    // The check uses its own Base that only holds a copy of the installroot, so the worker shares no pool,
+    // configuration or logger with the PackageDownloader. At most one check is pending, so the verification
+    // Base is never used by two threads at once.
+    libdnf5::Base verification_base;
+    verification_base.get_config().get_installroot_option().set(
+        base.get_config().get_installroot_option().get_value());
+    const libdnf5::rpm::RpmSignature rpm_signature(verification_base);
+    std::future<std::pair<download_window_type, pgp_failures_type>> pending_check;
+    bool download_failed{false};
+    std::size_t store_reused_count{0};
+    unsigned long long store_reused_bytes{0};
+    for (std::size_t window_start = 0; window_start < to_process.size(); window_start += DOWNLOAD_WINDOW_SIZE) {
+        const auto window_end = std::min(window_start + DOWNLOAD_WINDOW_SIZE, to_process.size());
+
+        libdnf5::repo::PackageDownloader downloader(base);
+        downloader.force_keep_packages(true);
+        // do not stop on the first error but download as much packages as available
+        downloader.set_fail_fast(false);
+        download_window_type window;
+        bool download_needed{false};
+        for (auto idx = window_start; idx < window_end; ++idx) {
+            const auto [item, needs_download] = to_process[idx];
+            if (needs_download) {
+                downloader.add(item->second, item->first.parent_path());
+                download_needed = true;
+            }
+            window.push_back(item);
+        }
+
+        if (download_needed) {
+            downloader.download();
+            store_reused_count += downloader.get_store_reused_count();
+            store_reused_bytes += downloader.get_store_reused_bytes();
+            for (const auto & pkg : downloader.get_failed_packages()) {
+                std::cerr << libdnf5::utils::sformat(_("Failed to download package: {}"), pkg.get_full_nevra())
+                          << std::endl;
+                std::erase_if(window, [&pkg](const auto * item) { return item->second == pkg; });
+                download_failed = true;
+            }
+        }
+
+        if (pending_check.valid()) {
+            const auto [checked_window, pgp_failures] = pending_check.get();
+            record_window(checked_window, pgp_failures);
+        }
+        if (gpgcheck) {
+            pending_check = std::async(std::launch::async, [&rpm_signature, window = std::move(window)]() mutable {
+                auto pgp_failures = pgp_check_packages(rpm_signature, window);
+                return std::make_pair(std::move(window), std::move(pgp_failures));
+            });
+        } else {
+            record_window(window, {});
         }
+    }
+    if (pending_check.valid()) {
+        const auto [checked_window, pgp_failures] = pending_check.get();
+        record_window(checked_window, pgp_failures);
+    }
+
+    if (!base.get_config().get_package_store_dir_option().empty()) {
+        const auto [size, unit] = libdnf5::cli::utils::units::to_size(static_cast<int64_t>(store_reused_bytes));
+        std::cout << libdnf5::utils::sformat(
+                         _("Reused {0} package(s) of {1:.1f} {2} from the package store"),
+                         store_reused_count,
+                         size,
+                         unit)
+                  << std::endl;
+    }
+
+    if (download_failed) {
         throw libdnf5::cli::CommandExitError(1, M_("Failed to download one or more packages"));
     }
+    return pgp_ok;
 }
 
 void ReposyncCommand::delete_old_local_packages(
@@ -324,25 +455,26 @@ void ReposyncCommand::delete_old_local_packages(
     }
 }
 
-bool ReposyncCommand::pgp_check_packages(const download_list_type & pkg_list) {
-    bool ret = true;
+ReposyncCommand::pgp_failures_type ReposyncCommand::pgp_check_packages(
+    const libdnf5::rpm::RpmSignature & rpm_signature, const download_window_type & window) {
+    pgp_failures_type failures;
     std::error_code ec;
-    libdnf5::rpm::RpmSignature rpm_signature(get_context().get_base());
-    for (const auto & [pth, pkg] : pkg_list) {
+    for (const auto * item : window) {
+        const auto & pth = item->first;
         if (std::filesystem::exists(pth, ec)) {
             auto check_result = rpm_signature.check_package_signature(pth);
             if (check_result != libdnf5::rpm::RpmSignature::CheckResult::OK) {
-                std::cerr << libdnf5::utils::sformat(
-                                 _("Removing '{}' with failing OpenPGP check: {}"),
-                                 pth.string(),
-                                 rpm_signature.check_result_to_string(check_result))
-                          << std::endl;
+                failures.emplace_back(
+                    pth,
+                    libdnf5::utils::sformat(
+                        _("Removing '{}' with failing OpenPGP check: {}"),
+                        pth.string(),
+                        rpm_signature.check_result_to_string(check_result)));
                 std::filesystem::remove(pth, ec);
-                ret = false;
             }
         }
     }
-    return ret;
+    return failures;
 }
 
 void ReposyncCommand::download_metadata(libdnf5::repo::Repo & repo) {
@@ -416,14 +548,12 @@ void ReposyncCommand::run() {
             if (download_metadata_option->get_value()) {
                 download_metadata(*repo);
             }
-            download_packages(pkg_list);
+            const bool pgp_ok = download_packages(*repo, pkg_list);
             if (delete_option->get_value()) {
                 delete_old_local_packages(*repo, pkg_list);
             }
-            if (gpgcheck_option->get_value()) {
-                if (!pgp_check_packages(pkg_list)) {
-                    throw libdnf5::cli::CommandExitError(1, M_("OpenPGP signature check failed"));
-                }
+            if (!pgp_ok) {
+                throw libdnf5::cli::CommandExitError(1, M_("OpenPGP signature check failed"));
             }
         }
     }
@@ -26,10 +26,13 @@
 #include <libdnf5-cli/session.hpp>
 #include <libdnf5/repo/repo.hpp>
 #include <libdnf5/rpm/package.hpp>
+#include <libdnf5/rpm/rpm_signature.hpp>
 
 #include <filesystem>
 #include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace dnf5 {
 
@@ -44,6 +47,9 @@ public:
 
 private:
     using download_list_type = std::map<std::filesystem::path, libdnf5::rpm::Package>;
+    using download_window_type = std::vector<const download_list_type::value_type *>;
+    // paths of the packages removed due to failed OpenPGP check with the corresponding messages
+    using pgp_failures_type = std::vector<std::pair<std::filesystem::path, std::string>>;
 
     std::unique_ptr<libdnf5::cli::session::BoolOption> newest_option{nullptr};
     std::unique_ptr<libdnf5::cli::session::BoolOption> remote_time_option{nullptr};
@@ -60,9 +66,10 @@ private:
     std::filesystem::path repo_download_path(const libdnf5::repo::Repo & repo);
     void limit_to_latest(libdnf5::rpm::PackageQuery & query);
     download_list_type get_packages_list(const libdnf5::repo::Repo & repo);
-    void download_packages(const download_list_type & pkg_list);
+    bool download_packages(const libdnf5::repo::Repo & repo, const download_list_type & pkg_list);
     void delete_old_local_packages(const libdnf5::repo::Repo & repo, const download_list_type & pkg_list);
-    bool pgp_check_packages(const download_list_type & pkg_list);
+    static pgp_failures_type pgp_check_packages(
+        const libdnf5::rpm::RpmSignature & rpm_signature, const download_window_type & window);
     void download_metadata(libdnf5::repo::Repo & repo);
 };
 
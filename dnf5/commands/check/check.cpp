@@ -21,6 +21,7 @@
 
 #include <fmt/format.h>
 #include <libdnf5/rpm/nevra.hpp>
+#include <libdnf5/rpm/package_query.hpp>
 #include <libdnf5/utils/bgettext/bgettext-lib.h>
 #include <libdnf5/utils/bgettext/bgettext-mark-domain.h>
 #include <rpm/header.h>
@@ -31,11 +32,15 @@
 #include <rpm/rpmte.h>
 #include <rpm/rpmts.h>
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <set>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace dnf5 {
@@ -53,7 +58,7 @@ struct PkgId {
     std::string nevra;
     std::invoke_result_t<decltype(&rpmteDBOffset), rpmte> rpmdb_idx;
 
-    bool operator==(const PkgId & p) const noexcept { return rpmdb_idx == p.rpmdb_idx; }
+    bool operator==(const PkgId & p) const noexcept { return rpmdb_idx == p.rpmdb_idx && nevra == p.nevra; }
 
     std::strong_ordering operator<=>(const PkgId & p) const noexcept {
         auto cmp = nevra <=> p.nevra;
@@ -83,6 +88,9 @@ bool dependencies{false};
 bool duplicates{false};
 bool obsoleted{false};
 
+// check the rpm database directly using librpm instead of the loaded system repository
+bool use_rpmdb{false};
+
 // Contains "provides" to recognize the installonly package.
 // It is initialized with values from the configuration.
 std::vector<std::string> installonly_pkgs_provides;
@@ -228,6 +236,234 @@ void group_pkgs_same_name_arch(Header h) {
     }
 }
 
+
+inline PkgId get_pkg_id(const rpm::Package & pkg) {
+    return {pkg.get_full_nevra(), static_cast<decltype(PkgId::rpmdb_idx)>(pkg.get_rpmdbid())};
+}
+
+
+inline bool is_package_installonly(const rpm::Package & pkg) {
+    for (const auto & provide : pkg.get_provides()) {
+        for (const auto & installonly_pkg_provide : installonly_pkgs_provides) {
+            if (installonly_pkg_provide == provide.get_name()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+// Returns the installed packages matching each of the `deps`, keyed by the reldep id.
+// All the reldeps are first resolved together using a single whatprovides lookup. Only the reldeps
+// that can match one of the found packages are then resolved one by one, usually there are none.
+// If `match_names` is set, the names of the packages must match the names of the reldeps (obsoletes).
+std::unordered_map<int, std::vector<rpm::Package>> find_installed_providers(
+    const rpm::PackageQuery & installed, const rpm::ReldepList & deps, bool match_names) {
+    std::unordered_map<int, std::vector<rpm::Package>> providers;
+    if (deps.empty()) {
+        return providers;
+    }
+
+    rpm::PackageQuery candidates(installed);
+    candidates.filter_provides(deps);
+    if (candidates.empty()) {
+        return providers;
+    }
+
+    // Names the candidates can match by. Rich and file dependencies cannot be matched by a name.
+    std::unordered_set<std::string> candidate_names;
+    for (const auto & candidate : candidates) {
+        if (match_names) {
+            candidate_names.insert(candidate.get_name());
+        } else {
+            for (const auto & provide : candidate.get_provides()) {
+                candidate_names.insert(provide.get_name());
+            }
+        }
+    }
+
+    for (const auto & dep : deps) {
+        const std::string dep_name = dep.get_name();
+        const bool is_file_or_rich = dep_name.starts_with('/') || rpm::Reldep::is_rich_dependency(dep.to_string());
+        if ((match_names || !is_file_or_rich) && !candidate_names.contains(dep_name)) {
+            continue;
+        }
+        rpm::PackageQuery dep_providers(candidates);
+        if (match_names) {
+            dep_providers.filter_name(dep_name);
+        }
+        dep_providers.filter_provides(dep);
+        if (!dep_providers.empty()) {
+            providers.emplace(dep.get_id().id, std::vector<rpm::Package>(dep_providers.begin(), dep_providers.end()));
+        }
+    }
+    return providers;
+}
+
+
+// Finds problems of the installed packages using the loaded system repository.
+// The reported problems are the same as those reported by `find_problems()` on the rpm database:
+// - every unsatisfied require of a package is reported for the package itself,
+// - a conflict of package `Q` matching package `P` is reported for `P` with `Q` as the causing package,
+// - an obsolete of package `Q` matching the name and version of package `P` is reported for `P` with `Q` as
+//   the causing package.
+// Self conflicts and self obsoletes are skipped.
+void find_problems_in_system_repo(rpm::PackageQuery & installed, const std::vector<rpm::Package> & installed_pkgs) {
+    // The same requires are shared by many packages, resolve each of them only once.
+    std::unordered_map<int, bool> dep_satisfied_cache;
+
+    // Conflicts and obsoletes of all the packages, each distinct reldep is resolved only once.
+    rpm::ReldepList conflicts(installed.get_base());
+    rpm::ReldepList obsoletes(installed.get_base());
+    std::unordered_set<int> seen_conflicts;
+    std::unordered_set<int> seen_obsoletes;
+
+    for (const auto & pkg : installed_pkgs) {
+        if (dependencies) {
+            for (const auto & require : pkg.get_requires()) {
+                // rpmlib() requires are features of rpm itself, they are not provided by any package
+                if (std::string_view(require.get_name()).starts_with("rpmlib(")) {
+                    continue;
+                }
+                auto [it, inserted] = dep_satisfied_cache.try_emplace(require.get_id().id, false);
+                if (inserted) {
+                    it->second = installed.is_dep_satisfied(require);
+                }
+                if (!it->second) {
+                    problems[get_pkg_id(pkg)].insert(Problem{
+                        .type = ProblemType::MISSING_REQUIRE, .nevra = "", .file_or_provide = require.to_string()});
+                }
+            }
+
+            for (const auto & conflict : pkg.get_conflicts()) {
+                if (seen_conflicts.insert(conflict.get_id().id).second) {
+                    conflicts.add(conflict);
+                }
+            }
+        }
+
+        if (obsoleted) {
+            for (const auto & obsolete : pkg.get_obsoletes()) {
+                if (seen_obsoletes.insert(obsolete.get_id().id).second) {
+                    obsoletes.add(obsolete);
+                }
+            }
+        }
+    }
+
+    const auto conflicting_pkgs = find_installed_providers(installed, conflicts, false);
+    // Obsoletes match package names. Every package provides "name = [epoch:]version-release",
+    // so filtering by provides within the same name matches the obsoleted versions.
+    const auto obsoleted_pkgs = find_installed_providers(installed, obsoletes, true);
+    if (conflicting_pkgs.empty() && obsoleted_pkgs.empty()) {
+        return;
+    }
+
+    for (const auto & pkg : installed_pkgs) {
+        if (dependencies && !conflicting_pkgs.empty()) {
+            for (const auto & conflict : pkg.get_conflicts()) {
+                auto it = conflicting_pkgs.find(conflict.get_id().id);
+                if (it == conflicting_pkgs.end()) {
+                    continue;
+                }
+                for (const auto & conflicting_pkg : it->second) {
+                    if (conflicting_pkg == pkg) {
+                        // skip self conflicts
+                        continue;
+                    }
+                    problems[get_pkg_id(conflicting_pkg)].insert(Problem{
+                        .type = ProblemType::CONFLICT,
+                        .nevra = pkg.get_full_nevra(),
+                        .file_or_provide = conflict.to_string()});
+                }
+            }
+        }
+
+        if (obsoleted && !obsoleted_pkgs.empty()) {
+            for (const auto & obsolete : pkg.get_obsoletes()) {
+                auto it = obsoleted_pkgs.find(obsolete.get_id().id);
+                if (it == obsoleted_pkgs.end()) {
+                    continue;
+                }
+                for (const auto & obsoleted_pkg : it->second) {
+                    if (obsoleted_pkg == pkg) {
+                        // skip self obsolete
+                        continue;
+                    }
+                    problems[get_pkg_id(obsoleted_pkg)].insert(Problem{
+                        .type = ProblemType::OBSOLETED,
+                        .nevra = pkg.get_full_nevra(),
+                        .file_or_provide = obsolete.to_string()});
+                }
+            }
+        }
+    }
+}
+
+
+// Groups installed packages from the system repository with the same "name" and "architecture".
+// For "installonly" packages, only one "nevra" is inserted.
+void group_pkgs_same_name_arch(const rpm::Package & pkg) {
+    auto & nevras = installed_na_packages[fmt::format("{}.{}", pkg.get_name(), pkg.get_arch())];
+    if (nevras.empty() || !is_package_installonly(pkg)) {
+        nevras.push_back(get_pkg_id(pkg));
+    }
+}
+
+
+// Finds problems using the rpm database. Every installed header is added to an empty transaction and checked.
+void check_rpmdb(Context & ctx) {
+    auto ts = rpmtsCreate();
+    auto & config = ctx.get_base().get_config();
+    rpmtsSetRootDir(ts, config.get_installroot_option().get_value().c_str());
+
+    rpmdbMatchIterator mi = rpmtsInitIterator(ts, RPMDBI_PACKAGES, NULL, 0);
+    std::unique_ptr<std::remove_pointer_t<rpmdbMatchIterator>, decltype(&rpmdbFreeIterator)> mi_owner(
+        mi, &rpmdbFreeIterator);
+    while (Header h = rpmdbNextIterator(mi)) {
+        if (dependencies || obsoleted) {
+            find_problems(ts, h);
+        }
+        if (duplicates) {
+            group_pkgs_same_name_arch(h);
+        }
+    }
+    mi_owner.reset();
+
+    rpmtsFree(ts);
+}
+
+
+// Finds problems using the already loaded system repository.
+void check_system_repo(Context & ctx) {
+    rpm::PackageQuery installed(ctx.get_base(), rpm::PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
+    installed.filter_installed();
+
+    // Process the packages ordered by the same key as the reported problems: "nevra" and the rpm database index.
+    // The order does not change the report, only one of the installonly packages of a "name.arch" group
+    // is kept and such a group is never reported.
+    std::vector<std::pair<PkgId, rpm::Package>> keyed_pkgs;
+    for (const auto & pkg : installed) {
+        keyed_pkgs.emplace_back(get_pkg_id(pkg), pkg);
+    }
+    std::sort(keyed_pkgs.begin(), keyed_pkgs.end(), [](const auto & a, const auto & b) { return a.first < b.first; });
+    std::vector<rpm::Package> installed_pkgs;
+    installed_pkgs.reserve(keyed_pkgs.size());
+    for (auto & [pkg_id, pkg] : keyed_pkgs) {
+        installed_pkgs.push_back(std::move(pkg));
+    }
+
+    if (dependencies || obsoleted) {
+        find_problems_in_system_repo(installed, installed_pkgs);
+    }
+    if (duplicates) {
+        for (const auto & pkg : installed_pkgs) {
+            group_pkgs_same_name_arch(pkg);
+        }
+    }
+}
+
 }  // namespace
 
 
@@ -253,6 +489,11 @@ void CheckCommand::set_argument_parser() {
         create_option(parser, "dependencies", "Show missing dependencies and conflicts", dependencies));
     cmd.register_named_arg(create_option(parser, "duplicates", "Show duplicated packages", duplicates));
     cmd.register_named_arg(create_option(parser, "obsoleted", "Show obsoleted packages", obsoleted));
+    cmd.register_named_arg(create_option(
+        parser,
+        "rpmdb",
+        "Check the rpm database directly instead of the loaded system repository (slower)",
+        use_rpmdb));
 }
 
 
@@ -261,26 +502,24 @@ void CheckCommand::configure() {
     if (!(dependencies || duplicates || obsoleted)) {
         dependencies = duplicates = obsoleted = true;
     }
+    if (!use_rpmdb) {
+        auto & context = get_context();
+        context.set_load_system_repo(true);
+        context.set_load_available_repos(Context::LoadAvailableRepos::NONE);
+    }
 }
 
 
 void CheckCommand::run() {
     auto & ctx = get_context();
 
-    auto ts = rpmtsCreate();
-    auto & config = ctx.get_base().get_config();
-    rpmtsSetRootDir(ts, config.get_installroot_option().get_value().c_str());
+    problems.clear();
+    installed_na_packages.clear();
 
-    rpmdbMatchIterator mi = rpmtsInitIterator(ts, RPMDBI_PACKAGES, NULL, 0);
-    std::unique_ptr<std::remove_pointer_t<rpmdbMatchIterator>, decltype(&rpmdbFreeIterator)> mi_owner(
-        mi, &rpmdbFreeIterator);
-    while (Header h = rpmdbNextIterator(mi)) {
-        if (dependencies || obsoleted) {
-            find_problems(ts, h);
-        }
-        if (duplicates) {
-            group_pkgs_same_name_arch(h);
-        }
+    if (use_rpmdb) {
+        check_rpmdb(ctx);
+    } else {
+        check_system_repo(ctx);
     }
 
     if (duplicates) {
@@ -300,8 +539,6 @@ void CheckCommand::run() {
         }
     }
 
-    rpmtsFree(ts);
-
     // Print problems
     if (!problems.empty()) {
         std::size_t problem_count{0};
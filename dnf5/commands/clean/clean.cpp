@@ -50,7 +50,9 @@ struct CacheType {
 
 const CacheType CACHE_TYPES[]{
     {"all", "Delete all cached data from the repositories cache", CleanCommand::CLEAN_ALL},
-    {"packages", "Delete packages from the repositories cache", CleanCommand::CLEAN_PACKAGES},
+    {"packages",
+     "Delete packages and headers of local RPM files from the repositories cache",
+     CleanCommand::CLEAN_PACKAGES},
     {"metadata",
      "Delete the metadata and dbcache from the repositories cache",
      static_cast<CleanCommand::Actions>(CleanCommand::CLEAN_METADATA | CleanCommand::CLEAN_DBCACHE)},
@@ -154,6 +156,7 @@ void CleanCommand::run() {
             }
             if (required_actions & CLEAN_PACKAGES) {
                 statistics += cache.remove_packages();
+                statistics += cache.remove_rpm_headers();
             }
             if (required_actions & CLEAN_DBCACHE) {
                 statistics += cache.remove_solv_files();
@@ -170,6 +173,15 @@ void CleanCommand::run() {
         }
     }
 
+    // packages removed from the repositories cache may leave unused packages in the shared package store
+    if (required_actions & (CLEAN_ALL | CLEAN_PACKAGES)) {
+        try {
+            statistics += libdnf5::repo::RepoCache::remove_unused_store_packages(ctx.get_base().get_weak_ptr());
+        } catch (const std::exception & ex) {
+            std::cerr << libdnf5::utils::sformat(_("Failed to cleanup the package store: {}"), ex.what()) << std::endl;
+        }
+    }
+
     if (ec) {
         if (ec.value() == ENOENT) {
             std::cout << libdnf5::utils::sformat(
@@ -412,6 +412,13 @@ void RepoqueryCommand::set_argument_parser() {
     cmd.register_named_arg(query_format);
     formatting_conflicts->push_back(query_format);
 
+    unsorted = std::make_unique<libdnf5::cli::session::BoolOption>(
+        *this,
+        "unsorted",
+        '\0',
+        "Write --queryformat output for each package as soon as it is formatted, without sorting and deduplication.",
+        false);
+
     changelogs = std::make_unique<libdnf5::cli::session::BoolOption>(
         *this, "changelogs", '\0', "Display package changelogs.", false);
     repoquery_formatting->register_argument(changelogs->get_arg());
@@ -491,6 +498,11 @@ void RepoqueryCommand::configure() {
         context.get_base().get_repo_sack()->enable_source_repos();
     }
 
+    if (unsorted->get_value() && query_format_option->get_priority() < libdnf5::Option::Priority::COMMANDLINE) {
+        throw libdnf5::cli::ArgumentParserMissingDependentArgumentError(
+            M_("Option \"--unsorted\" has to be used with \"--queryformat\""));
+    }
+
     if (changelogs->get_value()) {
         context.get_base().get_config().get_optional_metadata_types_option().add_item(
             libdnf5::Option::Priority::RUNTIME, libdnf5::METADATA_TYPE_OTHER);
@@ -887,7 +899,12 @@ void RepoqueryCommand::run() {
     } else if (!pkg_attr_option->get_value().empty()) {
         libdnf5::cli::output::print_pkg_attr_uniq_sorted(stdout, result_query, pkg_attr_option->get_value());
     } else {
-        libdnf5::cli::output::print_pkg_set_with_format(stdout, result_query, query_format_option->get_value());
+        if (unsorted->get_value()) {
+            libdnf5::cli::output::print_pkg_set_with_format_unsorted(
+                stdout, result_query, query_format_option->get_value());
+        } else {
+            libdnf5::cli::output::print_pkg_set_with_format(stdout, result_query, query_format_option->get_value());
+        }
     }
 }
 
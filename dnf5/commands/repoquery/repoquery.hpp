@@ -78,6 +78,7 @@ private:
     std::unique_ptr<libdnf5::cli::session::BoolOption> disable_modular_filtering{nullptr};
 #endif
     std::unique_ptr<libdnf5::cli::session::BoolOption> changelogs{nullptr};
+    std::unique_ptr<libdnf5::cli::session::BoolOption> unsorted{nullptr};
     std::unique_ptr<libdnf5::cli::session::BoolOption> recursive{nullptr};
 
     libdnf5::OptionBool * querytags_option{nullptr};
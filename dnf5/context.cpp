@@ -740,6 +740,22 @@ bool Context::get_show_new_leaves() const {
     return p_impl->get_show_new_leaves();
 }
 
+void Context::set_profile(bool enable) {
+    p_impl->set_profile(enable);
+}
+
+bool Context::get_profile() const {
+    return p_impl->get_profile();
+}
+
+void Context::set_profile_trace_path(const std::string & path) {
+    p_impl->set_profile_trace_path(path);
+}
+
+const std::string & Context::get_profile_trace_path() const {
+    return p_impl->get_profile_trace_path();
+}
+
 Plugins & Context::get_plugins() {
     return p_impl->get_plugins();
 }
@@ -65,6 +65,14 @@ public:
 
     const std::vector<std::string> & get_dump_repo_config_id_list() const { return dump_repo_config_id_list; }
 
+    void set_profile(bool enable) { this->profile = enable; }
+
+    bool get_profile() const { return profile; }
+
+    void set_profile_trace_path(const std::string & path) { this->profile_trace_path = path; }
+
+    const std::string & get_profile_trace_path() const { return profile_trace_path; }
+
     void set_dump_variables(bool enable) { this->dump_variables = enable; }
 
     bool get_dump_variables() const { return dump_variables; }
@@ -160,6 +168,8 @@ private:
     bool dump_main_config{false};
     std::vector<std::string> dump_repo_config_id_list;
     bool dump_variables{false};
+    bool profile{false};
+    std::string profile_trace_path;
     bool show_new_leaves{false};
     std::string get_cmd_line();
 
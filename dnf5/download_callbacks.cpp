@@ -38,6 +38,9 @@ void * DownloadCallbacks::add_new_download(
         multi_progress_bar = std::make_unique<libdnf5::cli::progressbar::MultiProgressBar>(
             libdnf5::cli::progressbar::MultiProgressBar::TrackingMode::ON_CHANGE);
         multi_progress_bar->set_total_bar_visible_limit(show_total_bar_limit);
+        // 10 FPS seems to be smooth enough, progress reported in between is coalesced
+        multi_progress_bar->set_max_frame_rate(10);
+        multi_progress_bar->set_incremental_rendering(true);
     }
     auto progress_bar = std::make_unique<libdnf5::cli::progressbar::DownloadProgressBar>(
         total_to_download > 0 ? total_to_download : -1, description);
@@ -58,9 +61,7 @@ int DownloadCallbacks::progress(void * user_cb_data, double total_to_download, d
         multi_progress_bar->bar_start(progress_bar);
     }
     multi_progress_bar->bar_set_ticks(progress_bar, static_cast<int64_t>(downloaded));
-    if (is_time_to_print()) {
-        print();
-    }
+    print();
     return ReturnCode::OK;
 }
 
@@ -109,18 +110,6 @@ void DownloadCallbacks::reset_progress_bar() {
     }
 }
 
-bool DownloadCallbacks::is_time_to_print() {
-    auto now = std::chrono::steady_clock::now();
-    auto delta = now - prev_print_time;
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(delta).count();
-    if (ms > 100) {
-        // 100ms equals to 10 FPS and that seems to be smooth enough
-        prev_print_time = now;
-        return true;
-    }
-    return false;
-}
-
 void DownloadCallbacks::print() {
     multi_progress_bar->print();
     printed = true;
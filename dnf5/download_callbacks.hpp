@@ -23,8 +23,6 @@
 #include <libdnf5-cli/progressbar/multi_progress_bar.hpp>
 #include <libdnf5/repo/download_callbacks.hpp>
 
-#include <chrono>
-
 namespace dnf5 {
 
 class DownloadCallbacks : public libdnf5::repo::DownloadCallbacks {
@@ -44,11 +42,9 @@ private:
 
     int mirror_failure(void * user_cb_data, const char * msg, const char * url, const char * metadata) override;
 
-    bool is_time_to_print();
     void print();
 
     std::unique_ptr<libdnf5::cli::progressbar::MultiProgressBar> multi_progress_bar;
-    std::chrono::time_point<std::chrono::steady_clock> prev_print_time{std::chrono::steady_clock::now()};
     bool printed{false};
 
     bool number_widget_visible{false};
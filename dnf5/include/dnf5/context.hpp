@@ -130,6 +130,16 @@ public:
 
     bool get_show_new_leaves() const;
 
+    /// Set to true to print time spent in individual processing phases at exit
+    void set_profile(bool enable);
+
+    bool get_profile() const;
+
+    /// Set a path to a file to write time spent in individual processing phases to at exit
+    void set_profile_trace_path(const std::string & path);
+
+    const std::string & get_profile_trace_path() const;
+
     Plugins & get_plugins();
 
     libdnf5::Goal * get_goal(bool new_if_not_exist = true);
@@ -96,6 +96,7 @@
 #include <filesystem>
 #include <iostream>
 #include <map>
+#include <set>
 #include <utility>
 
 constexpr const char * DNF5_LOGGER_FILENAME = "dnf5.log";
@@ -598,6 +599,39 @@ void RootCommand::set_argument_parser() {
         global_options_group->register_argument(debug_solver);
     }
 
+    {
+        auto profile = parser.add_new_named_arg("profile");
+        profile->set_long_name("profile");
+        profile->set_description(_("Print time spent in individual processing phases to stderr at exit"));
+        profile->set_parse_hook_func([&ctx](
+                                         [[maybe_unused]] ArgumentParser::NamedArg * arg,
+                                         [[maybe_unused]] const char * option,
+                                         [[maybe_unused]] const char * value) {
+            ctx.set_profile(true);
+            ctx.get_base().get_tracer().set_enabled(true);
+            return true;
+        });
+        global_options_group->register_argument(profile);
+    }
+
+    {
+        auto profile_trace = parser.add_new_named_arg("profile-trace");
+        profile_trace->set_long_name("profile-trace");
+        profile_trace->set_has_value(true);
+        profile_trace->set_arg_value_help("FILE");
+        profile_trace->set_description(
+            _("Write time spent in individual processing phases to FILE in the Chrome trace event JSON format"));
+        profile_trace->set_parse_hook_func([&ctx](
+                                               [[maybe_unused]] ArgumentParser::NamedArg * arg,
+                                               [[maybe_unused]] const char * option,
+                                               const char * value) {
+            ctx.set_profile_trace_path(value);
+            ctx.get_base().get_tracer().set_enabled(true);
+            return true;
+        });
+        global_options_group->register_argument(profile_trace);
+    }
+
     {
         auto dump_config = parser.add_new_named_arg("dump-main-config");
         dump_config->set_long_name("dump-main-config");
@@ -1013,6 +1047,65 @@ static void dump_variables(Context & context) {
     }
 }
 
+static void print_profile(const std::vector<libdnf5::base::TraceSpan> & spans) {
+    std::set<std::uint32_t> thread_indexes;
+    for (const auto & span : spans) {
+        thread_indexes.insert(span.thread_index);
+    }
+
+    std::cerr << _("======== Time spent in processing phases: ========") << std::endl;
+    for (const auto thread_index : thread_indexes) {
+        if (thread_indexes.size() > 1) {
+            std::cerr << libdnf5::utils::sformat(_("Thread {}:"), thread_index) << std::endl;
+        }
+        for (const auto & span : spans) {
+            if (span.thread_index != thread_index) {
+                continue;
+            }
+            const auto label = span.detail.empty() ? span.name : fmt::format("{} ({})", span.name, span.detail);
+            std::cerr << fmt::format(
+                             "{:>{}}{:<{}} {:>10.3f} ms",
+                             "",
+                             span.depth * 2,
+                             label,
+                             48 - std::min<std::size_t>(span.depth * 2, 40),
+                             static_cast<double>(span.duration_us) / 1000.0)
+                      << std::endl;
+        }
+    }
+}
+
+/// Reports the recorded processing phases when the main processing scope is left,
+/// including the case of an error.
+class ProfileReporter {
+public:
+    explicit ProfileReporter(Context & context) : context(context) {}
+
+    ~ProfileReporter() {
+        auto & tracer = context.get_base().get_tracer();
+        if (!tracer.is_enabled()) {
+            return;
+        }
+        try {
+            if (context.get_profile()) {
+                print_profile(tracer.get_spans());
+            }
+            if (const auto & path = context.get_profile_trace_path(); !path.empty()) {
+                tracer.write_chrome_trace(path);
+            }
+        } catch (const std::exception & ex) {
+            std::cerr << libdnf5::utils::sformat(_("Failed to report processing phases: {}"), ex.what())
+                      << std::endl;
+        }
+    }
+
+    ProfileReporter(const ProfileReporter &) = delete;
+    ProfileReporter & operator=(const ProfileReporter &) = delete;
+
+private:
+    Context & context;
+};
+
 static void print_new_leaves(Context & context) {
     libdnf5::rpm::PackageQuery pkg_query(context.get_base());
     pkg_query.filter_installed();
@@ -1457,6 +1550,8 @@ int main(int argc, char * argv[]) try {
             }
         }
 
+        dnf5::ProfileReporter profile_reporter(context);
+
         base.set_interaction_callbacks(std::make_unique<dnf5::InteractionCallbacks>(context));
 
         auto download_callbacks_uptr = std::make_unique<dnf5::DownloadCallbacks>();
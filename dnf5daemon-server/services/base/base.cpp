@@ -228,6 +228,7 @@ sdbus::MethodReply Base::impl_clean(
                     cache.remove_all();
                 } else if (cache_type == "packages") {
                     cache.remove_packages();
+                    cache.remove_rpm_headers();
                 } else if (cache_type == "metadata") {
                     cache.remove_metadata();
                 } else if (cache_type == "dbcache") {
@@ -239,6 +240,13 @@ sdbus::MethodReply Base::impl_clean(
                 remove_errs.emplace_back(fmt::format(" - \"{0}\": {1}", dir_entry.path().native(), ex.what()));
             }
         }
+        if (cache_type == "all" || cache_type == "packages") {
+            try {
+                libdnf5::repo::RepoCache::remove_unused_store_packages(base->get_weak_ptr());
+            } catch (const std::exception & ex) {
+                remove_errs.emplace_back(fmt::format(" - package store: {}", ex.what()));
+            }
+        }
         if (ec) {
             error_msg = fmt::format("Cannot iterate the cache directory: \"{}\".", cachedir.string());
         } else if (!remove_errs.empty()) {
@@ -29,9 +29,15 @@ namespace libdnf5::cli::output {
 
 LIBDNF_CLI_API bool requires_filelists(const std::string & queryformat);
 
+/// Print packages formatted by `queryformat`. The output lines are sorted and deduplicated.
 LIBDNF_CLI_API void print_pkg_set_with_format(
     std::FILE * target, const libdnf5::rpm::PackageSet & pkgs, const std::string & queryformat);
 
+/// Print packages formatted by `queryformat` in the order of the package set.
+/// The output is written directly for each package and it is not deduplicated.
+LIBDNF_CLI_API void print_pkg_set_with_format_unsorted(
+    std::FILE * target, const libdnf5::rpm::PackageSet & pkgs, const std::string & queryformat);
+
 LIBDNF_CLI_API void print_pkg_attr_uniq_sorted(
     std::FILE * target, const libdnf5::rpm::PackageSet & pkgs, const std::string & getter_name);
 
@@ -90,6 +90,15 @@ public:
     /// It can be greater than the current number of registered progress bars.
     std::size_t get_total_num_of_bars() const noexcept;
 
+    /// Limits the number of frames per second rendered by print(). Updates made between two frames are coalesced
+    /// and rendered by the first print() call after the interval elapses. State changes and messages are never
+    /// delayed, so final states of bars are always printed. Value 0 (default) renders on every print() call.
+    void set_max_frame_rate(std::size_t value) noexcept;
+
+    /// Enables incremental rendering in interactive mode.
+    /// Only the lines that changed since the previous render are rewritten instead of redrawing all of them.
+    void set_incremental_rendering(bool value) noexcept;
+
     /// @name Methods to work with registered bars
     /// Preferred way to modify a bar registered in this MultiProgressBar.
     /// Use these instead of calling ProgressBar methods directly, so that
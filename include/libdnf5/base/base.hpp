@@ -22,6 +22,7 @@
 
 #include "libdnf5/base/base_weak.hpp"
 #include "libdnf5/base/interaction_callbacks.hpp"
+#include "libdnf5/base/tracer.hpp"
 #include "libdnf5/common/exception.hpp"
 #include "libdnf5/common/impl_ptr.hpp"
 #include "libdnf5/common/weak_ptr.hpp"
@@ -162,6 +163,9 @@ public:
     /// Gets base variables. They can be used in configuration files. Syntax in the config - ${var_name} or $var_name.
     VarsWeakPtr get_vars();
 
+    /// Gets the tracer that records durations of libdnf5 processing phases. It is disabled by default.
+    base::Tracer & get_tracer();
+
     libdnf5::BaseWeakPtr get_weak_ptr();
 
     /// @brief Load libdnf5 plugin config, extract name of the plugin and check if it is enabled
@@ -0,0 +1,133 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef LIBDNF5_BASE_TRACER_HPP
+#define LIBDNF5_BASE_TRACER_HPP
+
+#include "libdnf5/defs.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace libdnf5::base {
+
+/// A finished traced phase of libdnf5 processing.
+struct TraceSpan {
+    /// Name of the phase, e.g. "load_config" or "resolve".
+    std::string name;
+
+    /// Optional detail, e.g. id of the repository being loaded.
+    std::string detail;
+
+    /// Start of the span in microseconds since the tracer was enabled.
+    std::int64_t start_us;
+
+    /// Duration of the span in microseconds.
+    std::int64_t duration_us;
+
+    /// Nesting level of the span within its thread, 0 for top-level spans.
+    std::uint32_t depth;
+
+    /// Sequential number of the thread that recorded the span, 0 is the first thread that recorded a span.
+    std::uint32_t thread_index;
+};
+
+
+/// Lightweight tracing of libdnf5 processing phases (loading configuration, plugins and repositories,
+/// computing provides, solving, ...). The tracer is disabled by default. A disabled tracer costs
+/// a single flag check per traced phase.
+class LIBDNF_API Tracer {
+public:
+    /// Records a span from its construction to its destruction if the tracer is enabled.
+    class LIBDNF_API Scope {
+    public:
+        Scope(Tracer & tracer, const char * name) : tracer(tracer.is_enabled() ? &tracer : nullptr), name(name) {
+            if (this->tracer) {
+                start();
+            }
+        }
+
+        Scope(Tracer & tracer, const char * name, const std::string & detail)
+            : tracer(tracer.is_enabled() ? &tracer : nullptr),
+              name(name) {
+            if (this->tracer) {
+                this->detail = detail;
+                start();
+            }
+        }
+
+        ~Scope() {
+            if (tracer) {
+                finish();
+            }
+        }
+
+        Scope(const Scope &) = delete;
+        Scope & operator=(const Scope &) = delete;
+
+    private:
+        void start();
+        void finish() noexcept;
+
+        Tracer * tracer;
+        const char * name;
+        std::string detail;
+        std::chrono::steady_clock::time_point start_time;
+    };
+
+    Tracer();
+    ~Tracer();
+
+    Tracer(const Tracer &) = delete;
+    Tracer & operator=(const Tracer &) = delete;
+
+    /// Enables or disables recording of spans. Enabling a disabled tracer resets the time origin
+    /// of the recorded spans, already recorded spans are kept.
+    void set_enabled(bool enabled);
+
+    /// @return `true` if spans are being recorded.
+    bool is_enabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    /// @return Recorded spans ordered by their start time.
+    std::vector<TraceSpan> get_spans() const;
+
+    /// Removes all recorded spans.
+    void clear();
+
+    /// Writes the recorded spans in the Chrome trace event JSON format. The file can be loaded
+    /// into chrome://tracing or https://ui.perfetto.dev.
+    /// @param path  Path to the output file.
+    /// @exception libdnf5::FileSystemError  An error occurred while writing the file.
+    void write_chrome_trace(const std::string & path) const;
+
+private:
+    class LIBDNF_LOCAL Impl;
+    std::unique_ptr<Impl> p_impl;
+    std::atomic<bool> enabled{false};
+};
+
+}  // namespace libdnf5::base
+
+#endif  // LIBDNF5_BASE_TRACER_HPP
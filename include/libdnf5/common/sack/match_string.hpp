@@ -22,6 +22,7 @@
 
 #include "query_cmp.hpp"
 
+#include "libdnf5/common/impl_ptr.hpp"
 #include "libdnf5/defs.h"
 
 #include <string>
@@ -30,6 +31,41 @@
 
 namespace libdnf5::sack {
 
+/// Matches strings against one or more patterns using a `QueryCmp` comparison.
+/// The patterns are prepared once when the matcher is constructed: regular expressions are compiled,
+/// patterns of the case-insensitive comparisons are lowercased and globs without wildcards are compared
+/// as plain strings. A matcher is meant to be reused for testing many values.
+class LIBDNF_API StringMatcher {
+public:
+    /// @param cmp      The comparison, it can be combined with the `QueryCmp::NOT` modifier.
+    /// @param pattern  The pattern the values are compared to.
+    /// @exception std::regex_error  The pattern of a `REGEX` or `IREGEX` comparison is not a valid regular expression.
+    StringMatcher(QueryCmp cmp, const std::string & pattern);
+
+    /// @param cmp       The comparison, it can be combined with the `QueryCmp::NOT` modifier.
+    /// @param patterns  The patterns the values are compared to.
+    /// @exception std::regex_error  A pattern of a `REGEX` or `IREGEX` comparison is not a valid regular expression.
+    StringMatcher(QueryCmp cmp, const std::vector<std::string> & patterns);
+
+    StringMatcher(const StringMatcher & src);
+    StringMatcher(StringMatcher && src) noexcept;
+    StringMatcher & operator=(const StringMatcher & src);
+    StringMatcher & operator=(StringMatcher && src) noexcept;
+    ~StringMatcher();
+
+    /// @return `true` if the `value` matches at least one of the patterns.
+    ///         With the `QueryCmp::NOT` modifier `true` if it matches none of them.
+    bool match(const std::string & value) const;
+
+    /// @return `true` if at least one of the `values` matches at least one of the patterns.
+    ///         With the `QueryCmp::NOT` modifier `true` if none of them matches any of the patterns.
+    bool match(const std::vector<std::string> & values) const;
+
+private:
+    class LIBDNF_LOCAL Impl;
+    ImplPtr<Impl> p_impl;
+};
+
 LIBDNF_API bool match_string(const std::string & value, QueryCmp cmp, const std::string & pattern);
 LIBDNF_API bool match_string(const std::string & value, QueryCmp cmp, const std::vector<std::string> & patterns);
 LIBDNF_API bool match_string(const std::vector<std::string> & values, QueryCmp cmp, const std::string & pattern);
@@ -90,9 +90,10 @@ private:
 
 template <typename T>
 inline void Query<T>::filter(Query<T>::FilterFunctionString * getter, const std::string & pattern, QueryCmp cmp) {
+    const StringMatcher matcher(cmp, pattern);
     for (auto it = get_data().begin(); it != get_data().end();) {
         auto value = getter(*it);
-        if (match_string(value, cmp, pattern)) {
+        if (matcher.match(value)) {
             ++it;
         } else {
             // TODO(jrohel): Modifying of iterated dataset. Performance? Can be implement better?
@@ -104,9 +105,10 @@ inline void Query<T>::filter(Query<T>::FilterFunctionString * getter, const std:
 
 template <typename T>
 inline void Query<T>::filter(Query<T>::FilterFunctionVectorString * getter, const std::string & pattern, QueryCmp cmp) {
+    const StringMatcher matcher(cmp, pattern);
     for (auto it = get_data().begin(); it != get_data().end();) {
         auto values = getter(*it);
-        if (match_string(values, cmp, pattern)) {
+        if (matcher.match(values)) {
             ++it;
         } else {
             it = get_data().erase(it);
@@ -117,9 +119,10 @@ inline void Query<T>::filter(Query<T>::FilterFunctionVectorString * getter, cons
 template <typename T>
 inline void Query<T>::filter(
     Query<T>::FilterFunctionString * getter, const std::vector<std::string> & patterns, QueryCmp cmp) {
+    const StringMatcher matcher(cmp, patterns);
     for (auto it = get_data().begin(); it != get_data().end();) {
         auto value = getter(*it);
-        if (match_string(value, cmp, patterns)) {
+        if (matcher.match(value)) {
             ++it;
         } else {
             it = get_data().erase(it);
@@ -130,9 +133,10 @@ inline void Query<T>::filter(
 template <typename T>
 inline void Query<T>::filter(
     Query<T>::FilterFunctionVectorString * getter, const std::vector<std::string> & patterns, QueryCmp cmp) {
+    const StringMatcher matcher(cmp, patterns);
     for (auto it = get_data().begin(); it != get_data().end();) {
         auto values = getter(*it);
-        if (match_string(values, cmp, patterns)) {
+        if (matcher.match(values)) {
             ++it;
         } else {
             it = get_data().erase(it);
@@ -203,9 +207,10 @@ inline void Query<T>::filter(Query<T>::FilterFunctionBool * getter, bool pattern
 
 template <typename T>
 inline void Query<T>::filter(Query<T>::FilterFunctionCString * getter, const std::string & pattern, QueryCmp cmp) {
+    const StringMatcher matcher(cmp, pattern);
     for (auto it = get_data().begin(); it != get_data().end();) {
         auto value = getter(*it);
-        if (match_string(value, cmp, pattern)) {
+        if (matcher.match(value)) {
             ++it;
         } else {
             it = get_data().erase(it);
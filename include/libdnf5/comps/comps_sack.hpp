@@ -29,6 +29,12 @@
 #include <set>
 #include <string>
 
+namespace libdnf5 {
+
+class InternalBaseUser;
+
+}  // namespace libdnf5
+
 namespace libdnf5::comps {
 
 
@@ -110,7 +116,9 @@ public:
 
 private:
     friend EnvironmentQuery;
+    friend Group;
     friend GroupQuery;
+    friend libdnf5::InternalBaseUser;
 
     class LIBDNF_LOCAL Impl;
     std::unique_ptr<Impl> p_impl;
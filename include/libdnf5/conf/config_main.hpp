@@ -207,6 +207,8 @@ public:
     const OptionBool & get_upgrade_group_objects_upgrade_option() const;
     OptionPath & get_destdir_option();
     const OptionPath & get_destdir_option() const;
+    OptionPath & get_package_store_dir_option();
+    const OptionPath & get_package_store_dir_option() const;
     OptionString & get_comment_option();
     const OptionString & get_comment_option() const;
     OptionBool & get_downloadonly_option();
@@ -250,6 +252,8 @@ public:
     const OptionPath & get_cachedir_option() const;
     OptionBool & get_fastestmirror_option();
     const OptionBool & get_fastestmirror_option() const;
+    OptionSeconds & get_mirror_health_max_age_option();
+    const OptionSeconds & get_mirror_health_max_age_option() const;
     OptionStringAppendList & get_excludeenvs_option();
     const OptionStringAppendList & get_excludeenvs_option() const;
     OptionStringAppendList & get_excludegroups_option();
@@ -56,6 +56,13 @@ public:
     /// Meaningful when fail_fast is false; empty if all succeeded.
     std::vector<libdnf5::rpm::Package> get_failed_packages() const;
 
+    /// Number of packages that were placed from the package store (see the `package_store_dir`
+    /// configuration option) instead of being downloaded in the last download() call.
+    std::size_t get_store_reused_count() const noexcept;
+
+    /// Sum of download sizes of the packages placed from the package store in the last download() call.
+    unsigned long long get_store_reused_bytes() const noexcept;
+
     /// Configure whether to fail the whole download on a first error or keep downloading.
     /// @param value If true, download will fail on the first error, otherwise it continues.
     /// This is set to true by default.
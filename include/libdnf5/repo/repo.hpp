@@ -346,6 +346,16 @@ private:
     /// @return PackageId of the added package.
     LIBDNF_LOCAL libdnf5::rpm::Package add_rpm_package(const std::string & path, bool with_hdrid);
 
+    /// Adds multiple RPM packages to the repository. Unlike calling add_rpm_package() for each path,
+    /// the headers are read in parallel and cached, so unchanged files are not read again next time.
+    /// @param paths The paths to the RPM files.
+    /// @param with_hdrid If true, libsolv calculates header checksum and stores it.
+    /// @throws RepoRpmError for the first RPM file that can't be read or is corrupted.
+    ///         The packages preceding it are added.
+    /// @return The added packages in the order of `paths`.
+    LIBDNF_LOCAL std::vector<libdnf5::rpm::Package> add_rpm_packages(
+        const std::vector<std::string> & paths, bool with_hdrid);
+
     LIBDNF_LOCAL void make_solv_repo();
 
     LIBDNF_LOCAL void load_available_repo();
@@ -101,6 +101,20 @@ public:
     /// @return Number of deleted files and directories. Number of errors.
     RemoveStatistics remove_solv_files();
 
+    /// Removes the cache of headers read from local RPM files (e.g. packages passed on the command line).
+    /// It is stored among the solvable files, remove_solv_files() removes it as well.
+    ///
+    /// @return Number of deleted files and directories. Number of errors.
+    RemoveStatistics remove_rpm_headers();
+
+    /// Removes packages no longer linked from any download destination from the package store configured
+    /// by the `package_store_dir` option. Nothing is removed if the store is not configured.
+    /// The store is shared by all repositories, so it is not tied to the cache directory of this instance.
+    ///
+    /// @param base  WeakPtr on the Base instance.
+    /// @return Number of deleted files and directories. Number of errors.
+    static RemoveStatistics remove_unused_store_packages(const libdnf5::BaseWeakPtr & base);
+
     /// Removes metadata, packages, solvable files, and attributes from the cache.
     /// If the repository cache directory becomes empty, it will also be deleted.
     ///
@@ -0,0 +1,79 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef LIBDNF5_RPM_PACKAGE_ATTR_READER_HPP
+#define LIBDNF5_RPM_PACKAGE_ATTR_READER_HPP
+
+#include "package.hpp"
+
+#include "libdnf5/base/base_weak.hpp"
+#include "libdnf5/common/impl_ptr.hpp"
+#include "libdnf5/defs.h"
+
+#include <string>
+
+
+namespace libdnf5::rpm {
+
+/// Reads a package attribute directly from the package metadata.
+///
+/// The attribute name is resolved to the metadata key once, when the reader is created.
+/// Reading the attribute of a package then appends the value to an output buffer
+/// without creating intermediate strings or dependency lists.
+/// The reader is not thread-safe, the metadata can be loaded on demand while reading.
+///
+/// It is a supported part of the public API for API users printing attributes of many packages
+/// selected by the user at runtime, such as `dnf5 repoquery --queryformat` in libdnf5-cli.
+/// The Package getters are the API for other uses. The values are the same as returned by the
+/// corresponding Package getters and the supported attribute names are kept stable.
+/// The reader needs the package metadata, which is not accessible outside of libdnf5.
+/// @since 5.4.4.0
+class LIBDNF_API PackageAttrReader {
+public:
+    /// Returns `true` if the attribute `attr_name` can be read by PackageAttrReader.
+    /// The names are the names of the Package getters without the `get_` prefix, with the exceptions
+    /// of "downloadsize", "installsize", "buildtime" and "installtime".
+    /// @since 5.4.4.0
+    static bool is_supported(const std::string & attr_name);
+
+    /// @param base       Base the read packages belong to.
+    /// @param attr_name  Name of the attribute, see is_supported().
+    /// @throw libdnf5::UserAssertionError if the attribute is not supported.
+    /// @since 5.4.4.0
+    PackageAttrReader(const libdnf5::BaseWeakPtr & base, const std::string & attr_name);
+    ~PackageAttrReader();
+
+    PackageAttrReader(const PackageAttrReader & src);
+    PackageAttrReader & operator=(const PackageAttrReader & src);
+    PackageAttrReader(PackageAttrReader && src) noexcept;
+    PackageAttrReader & operator=(PackageAttrReader && src) noexcept;
+
+    /// Appends the value of the attribute of `package` to `out`.
+    /// Dependencies are appended one per line, each followed by a new line character.
+    /// @since 5.4.4.0
+    void append(const Package & package, std::string & out) const;
+
+private:
+    class LIBDNF_LOCAL Impl;
+    ImplPtr<Impl> p_impl;
+};
+
+}  // namespace libdnf5::rpm
+
+#endif  // LIBDNF5_RPM_PACKAGE_ATTR_READER_HPP
@@ -24,9 +24,21 @@
 #include "libdnf5-cli/output/repoquery.hpp"
 
 #include <libdnf5/common/exception.hpp>
+#include <libdnf5/rpm/package_attr_reader.hpp>
 #include <libdnf5/utils/bgettext/bgettext-mark-domain.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
 #include <set>
+#include <string_view>
+#include <thread>
 #include <variant>
 
 namespace libdnf5::cli::output {
@@ -157,8 +169,9 @@ bool replace_tag_in_format(
 }
 
 
-std::pair<std::vector<Getter>, std::string> parse_queryformat(const std::string & queryformat) {
-    std::vector<Getter> getters;
+// Returns names of the tags used in the queryformat (keys of NAME_TO_GETTER) and the fmt format string.
+std::pair<std::vector<std::string>, std::string> parse_queryformat(const std::string & queryformat) {
+    std::vector<std::string> tag_names;
     std::string format;
     // format max possible len is 2 * queryformat.size() (if it contained just curly braces)
     format.resize(2 * queryformat.size());
@@ -189,7 +202,7 @@ std::pair<std::vector<Getter>, std::string> parse_queryformat(const std::string
             auto getter = NAME_TO_GETTER.find(libdnf5::utils::string::tolower(getter_name));
             if (getter != NAME_TO_GETTER.end()) {
                 if (replace_tag_in_format(format, format_size, tag_start, tag_name_start)) {
-                    getters.push_back(getter->second);
+                    tag_names.push_back(getter->first);
                     continue;  // continue to skip adding the current qf_char ('}')
                 }
             }
@@ -216,68 +229,428 @@ std::pair<std::vector<Getter>, std::string> parse_queryformat(const std::string
     // Resize the format to resulting size to trim excess characters.
     format.resize(format_size);
 
-    return {getters, format};
+    return {tag_names, format};
 }
 
 }  // namespace
 
 bool requires_filelists(const std::string & queryformat) {
-    auto [getters, _] = parse_queryformat(queryformat);
-    for (auto getter : getters) {
-        auto * getter_pointer = std::get_if<VecStrGetter>(&getter);
-        if (getter_pointer && (*getter_pointer == &libdnf5::rpm::Package::get_files)) {
-            return true;
+    auto [tag_names, _] = parse_queryformat(queryformat);
+    return std::find(tag_names.begin(), tag_names.end(), "files") != tag_names.end();
+}
+
+
+namespace {
+
+// Number of packages that are handed over to a formatting worker at once.
+constexpr std::size_t FORMAT_CHUNK_SIZE = 2048;
+
+// Appends value of one queryformat tag of the package to the output buffer.
+using TagAppender = std::function<void(const libdnf5::rpm::Package &, std::string &)>;
+
+
+TagAppender make_tag_appender(const Getter & getter) {
+    return std::visit(
+        [](const auto & getter_func) -> TagAppender {
+            using T = std::decay_t<decltype(getter_func)>;
+            if constexpr (std::is_same_v<T, ReldepListGetter>) {
+                return [getter_func](const libdnf5::rpm::Package & package, std::string & out) {
+                    for (const auto & reldep : (package.*getter_func)()) {
+                        out.append(reldep.to_string());
+                        out.push_back('\n');
+                    }
+                };
+            } else if constexpr (std::is_same_v<T, VecStrGetter>) {
+                return [getter_func](const libdnf5::rpm::Package & package, std::string & out) {
+                    for (const auto & str : (package.*getter_func)()) {
+                        out.append(str);
+                        out.push_back('\n');
+                    }
+                };
+            } else if constexpr (std::is_same_v<T, UnsignedLongLongGetter>) {
+                return [getter_func](const libdnf5::rpm::Package & package, std::string & out) {
+                    fmt::format_to(std::back_inserter(out), "{}", (package.*getter_func)());
+                };
+            } else if constexpr (std::is_same_v<T, TransactionItemReasonGetter>) {
+                return [getter_func](const libdnf5::rpm::Package & package, std::string & out) {
+                    out.append(transaction_item_reason_to_string((package.*getter_func)()));
+                };
+            } else if constexpr (std::is_same_v<T, StrGetterLambda>) {
+                return [getter_func](const libdnf5::rpm::Package & package, std::string & out) {
+                    out.append(getter_func(package));
+                };
+            } else {
+                return [getter_func](const libdnf5::rpm::Package & package, std::string & out) {
+                    out.append((package.*getter_func)());
+                };
+            }
+        },
+        getter);
+}
+
+
+// Values of queryformat tags of a chunk of packages. The values are read from the libsolv pool
+// in the main thread, the pool is not thread-safe (temporary string space, lazily loaded repodata).
+// The lines are then formatted from the collected values by a worker thread.
+struct ValueChunk {
+    std::size_t packages_count{0};
+    std::string values;                   // concatenated values of all tags of all packages
+    std::vector<std::size_t> value_ends;  // end offset of each value in `values`
+};
+
+
+// Queryformat compiled into a sequence of steps. Each step consists of a literal text and
+// the value of one tag. Compared to formatting through fmt::dynamic_format_arg_store there is
+// no per package argument store, no variant dispatch and, for tags read by PackageAttrReader,
+// no allocated Package getter results.
+class QueryFormatPlan {
+public:
+    QueryFormatPlan(const libdnf5::BaseWeakPtr & base, const std::string & queryformat) {
+        auto [tag_names, format] = parse_queryformat(queryformat);
+
+        // The `format` contains only "{}", "{:<N}" and "{:>N}" replacement fields (one for each
+        // tag) and escaped "{{" and "}}" braces, see replace_tag_in_format().
+        std::size_t tag_idx = 0;
+        std::string literal;
+        for (std::string::size_type idx = 0; idx < format.size(); ++idx) {
+            const char format_char = format[idx];
+            if ((format_char == '{' || format_char == '}') && idx + 1 < format.size() &&
+                format[idx + 1] == format_char) {
+                literal.push_back(format_char);
+                ++idx;
+            } else if (format_char == '{') {
+                auto field_end = format.find('}', idx);
+                libdnf_assert(
+                    field_end != std::string::npos && tag_idx < tag_names.size(), "Invalid queryformat field");
+                Step step;
+                step.literal = std::move(literal);
+                literal.clear();
+                const auto & tag_name = tag_names[tag_idx++];
+                // Tags stored in the package metadata are resolved to the metadata keys now and read
+                // directly from the solvables, the others are read using the Package getters.
+                if (libdnf5::rpm::PackageAttrReader::is_supported(tag_name)) {
+                    step.reader.emplace(base, tag_name);
+                } else {
+                    step.appender = make_tag_appender(NAME_TO_GETTER.at(tag_name));
+                }
+                // Align spec ":<N" or ":>N", the width can be omitted
+                if (field_end > idx + 2) {
+                    step.align = format[idx + 2];
+                    if (field_end > idx + 3) {
+                        step.width = std::stoul(format.substr(idx + 3, field_end - idx - 3));
+                    }
+                }
+                steps.push_back(std::move(step));
+                idx = field_end;
+            } else {
+                literal.push_back(format_char);
+            }
+        }
+        trailing_literal = std::move(literal);
+    }
+
+    /// Returns `true` if the output depends on the package.
+    bool has_tags() const noexcept { return !steps.empty(); }
+
+    /// Appends values of all tags of the package to the chunk. Must be called from the main thread.
+    void collect(const libdnf5::rpm::Package & package, ValueChunk & chunk) const {
+        for (const auto & step : steps) {
+            if (step.reader) {
+                step.reader->append(package, chunk.values);
+            } else {
+                step.appender(package, chunk.values);
+            }
+            chunk.value_ends.push_back(chunk.values.size());
+        }
+        ++chunk.packages_count;
+    }
+
+    /// Formats lines of all packages of the chunk and passes them to `consume_line` in the order
+    /// the packages were collected. Works only with the collected values, can run in a worker thread.
+    template <typename LineConsumer>
+    void format(const ValueChunk & chunk, LineConsumer && consume_line) const {
+        std::string line;
+        std::size_t value_idx = 0;
+        std::size_t value_begin = 0;
+        for (std::size_t pkg_idx = 0; pkg_idx < chunk.packages_count; ++pkg_idx) {
+            line.clear();
+            for (const auto & step : steps) {
+                const auto value_end = chunk.value_ends[value_idx++];
+                std::string_view value(chunk.values.data() + value_begin, value_end - value_begin);
+                value_begin = value_end;
+                line.append(step.literal);
+                if (step.width == 0) {
+                    line.append(value);
+                } else if (step.align == '<') {
+                    // fmt pads according to the display width of the value
+                    fmt::format_to(std::back_inserter(line), "{:<{}}", value, step.width);
+                } else {
+                    fmt::format_to(std::back_inserter(line), "{:>{}}", value, step.width);
+                }
+            }
+            line.append(trailing_literal);
+            consume_line(line);
+        }
+    }
+
+    /// Returns the output for a format without tags.
+    const std::string & get_trailing_literal() const noexcept { return trailing_literal; }
+
+private:
+    struct Step {
+        std::string literal;  // text preceding the tag
+        std::optional<libdnf5::rpm::PackageAttrReader> reader;
+        TagAppender appender;  // used when the tag cannot be read by the `reader`
+        char align{0};
+        std::size_t width{0};
+    };
+
+    std::vector<Step> steps;
+    std::string trailing_literal;
+};
+
+
+// Collects values of the next chunk of packages starting at `iter`.
+ValueChunk collect_chunk(
+    const QueryFormatPlan & plan,
+    libdnf5::rpm::PackageSet::iterator & iter,
+    const libdnf5::rpm::PackageSet::iterator & end) {
+    ValueChunk chunk;
+    for (; iter != end && chunk.packages_count < FORMAT_CHUNK_SIZE; ++iter) {
+        plan.collect(*iter, chunk);
+    }
+    return chunk;
+}
+
+
+// Fixed pool of worker threads processing chunks. The threads are started on demand, up to
+// the hardware concurrency. Results are taken in the order the chunks were submitted.
+template <typename Result>
+class ChunkWorkers {
+public:
+    ChunkWorkers() : max_workers(std::max(1U, std::thread::hardware_concurrency())) {}
+
+    ChunkWorkers(const ChunkWorkers &) = delete;
+    ChunkWorkers & operator=(const ChunkWorkers &) = delete;
+
+    ~ChunkWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        job_added.notify_all();
+        for (auto & thread : threads) {
+            thread.join();
+        }
+    }
+
+    /// Maximum number of submitted chunks that were not taken yet. Limits the memory held by
+    /// the formatted chunks while the caller is not able to consume them.
+    std::size_t get_max_pending() const noexcept { return 2 * max_workers; }
+
+    /// Number of submitted chunks that were not taken yet.
+    std::size_t size() const noexcept { return jobs.size(); }
+
+    bool empty() const noexcept { return jobs.empty(); }
+
+    void submit(std::function<Result()> task) {
+        auto job = std::make_shared<Job>();
+        job->task = std::move(task);
+        jobs.push_back(job);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            waiting.push(std::move(job));
+        }
+        if (threads.size() < max_workers) {
+            threads.emplace_back(&ChunkWorkers::run_worker, this);
+        }
+        job_added.notify_one();
+    }
+
+    /// Returns `true` if the oldest submitted chunk is processed and can be taken without blocking.
+    bool is_front_done() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return jobs.front()->done;
+    }
+
+    /// Waits for the oldest submitted chunk and returns its result.
+    Result take_front() {
+        auto job = std::move(jobs.front());
+        jobs.pop_front();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            job_done.wait(lock, [&job] { return job->done; });
         }
+        if (job->error) {
+            std::rethrow_exception(job->error);
+        }
+        return std::move(job->result);
     }
 
-    return false;
+private:
+    struct Job {
+        std::function<Result()> task;
+        Result result{};
+        std::exception_ptr error;
+        bool done{false};
+    };
+
+    void run_worker() {
+        while (true) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                job_added.wait(lock, [this] { return stopping || !waiting.empty(); });
+                if (stopping) {
+                    return;
+                }
+                job = std::move(waiting.front());
+                waiting.pop();
+            }
+            try {
+                job->result = job->task();
+            } catch (...) {
+                job->error = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                job->done = true;
+            }
+            job_done.notify_all();
+        }
+    }
+
+    const std::size_t max_workers;
+    std::vector<std::thread> threads;
+    std::deque<std::shared_ptr<Job>> jobs;  // submitted and not taken jobs in the submit order
+
+    std::mutex mutex;  // guards `waiting`, `stopping` and `Job::done`
+    std::condition_variable job_added;
+    std::condition_variable job_done;
+    std::queue<std::shared_ptr<Job>> waiting;  // jobs not picked by a worker yet
+    bool stopping{false};
+};
+
+
+// Formats the lines of a chunk, sorts and deduplicates them. Works only with already collected
+// values, it does not touch the libsolv pool and thus can run in a worker thread.
+std::vector<std::string> format_sort_unique(const QueryFormatPlan & plan, const ValueChunk & chunk) {
+    std::vector<std::string> lines;
+    lines.reserve(chunk.packages_count);
+    plan.format(chunk, [&lines](const std::string & line) { lines.emplace_back(line); });
+    std::sort(lines.begin(), lines.end());
+    lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
+    return lines;
 }
 
 
+// Formats the lines of a chunk into one output buffer. Can run in a worker thread.
+std::string format_concatenated(const QueryFormatPlan & plan, const ValueChunk & chunk) {
+    std::string output;
+    plan.format(chunk, [&output](const std::string & line) { output.append(line); });
+    return output;
+}
+
+
+// Merges already sorted and deduplicated runs and streams unique lines to the target.
+void print_merged_runs(std::FILE * target, std::vector<std::vector<std::string>> & runs) {
+    // (index of the run, index of the line in the run)
+    using Cursor = std::pair<std::size_t, std::size_t>;
+    auto greater = [&runs](const Cursor & lhs, const Cursor & rhs) {
+        return runs[lhs.first][lhs.second] > runs[rhs.first][rhs.second];
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)> heads(greater);
+    for (std::size_t idx = 0; idx < runs.size(); ++idx) {
+        if (!runs[idx].empty()) {
+            heads.emplace(idx, 0);
+        }
+    }
+
+    const std::string * last_printed = nullptr;
+    while (!heads.empty()) {
+        auto [run_idx, line_idx] = heads.top();
+        heads.pop();
+        const auto & line = runs[run_idx][line_idx];
+        if (!last_printed || *last_printed != line) {
+            std::fwrite(line.data(), 1, line.size(), target);
+            last_printed = &line;
+        }
+        if (line_idx + 1 < runs[run_idx].size()) {
+            heads.emplace(run_idx, line_idx + 1);
+        }
+    }
+}
+
+}  // namespace
+
+
 void print_pkg_set_with_format(
     std::FILE * target, const libdnf5::rpm::PackageSet & pkgs, const std::string & queryformat) {
-    auto [getters, format] = parse_queryformat(queryformat);
+    const QueryFormatPlan plan(pkgs.get_base(), queryformat);
+    if (!plan.has_tags()) {
+        if (!pkgs.empty()) {
+            fmt::print(target, "{}", plan.get_trailing_literal());
+        }
+        return;
+    }
 
-    std::set<std::string> output;
-    // Format and print each package.
-    fmt::dynamic_format_arg_store<fmt::format_context> arg_store;
-    arg_store.reserve(getters.size(), getters.size());
-    for (auto package : pkgs) {
-        arg_store.clear();
-        for (const auto & getter : getters) {
-            std::visit(
-                [&arg_store, &package](const auto & getter_func) {
-                    using T = std::decay_t<decltype(getter_func)>;
-                    if constexpr (std::is_same_v<T, ReldepListGetter>) {
-                        std::string joined;
-                        for (const auto & reldep : (package.*getter_func)()) {
-                            joined.append(std::move(reldep.to_string()));
-                            joined.push_back('\n');
-                        }
-                        arg_store.push_back(joined);
-                    } else if constexpr (std::is_same_v<T, VecStrGetter>) {
-                        std::string joined;
-                        for (const auto & str : (package.*getter_func)()) {
-                            joined.append(std::move(str));
-                            joined.push_back('\n');
-                        }
-                        arg_store.push_back(joined);
-                    } else if constexpr (std::is_same_v<T, TransactionItemReasonGetter>) {
-                        arg_store.push_back(std::move(transaction_item_reason_to_string((package.*getter_func)())));
-                    } else if constexpr (std::is_same_v<T, StrGetterLambda>) {
-                        arg_store.push_back((getter_func)(package));
-                    } else {
-                        arg_store.push_back((package.*getter_func)());
-                    }
-                },
-                getter);
+    // Values are collected in this thread by chunks. Formatting, sorting and deduplication
+    // of each chunk is done by the workers. The sorted chunks (runs) are finally merged
+    // and streamed to the target.
+    std::vector<std::vector<std::string>> runs;
+    ChunkWorkers<std::vector<std::string>> workers;
+    auto iter = pkgs.begin();
+    const auto end = pkgs.end();
+    while (iter != end) {
+        auto chunk = collect_chunk(plan, iter, end);
+        if (iter == end && runs.empty() && workers.empty()) {
+            // The whole set fits into one chunk, processing in a worker is not worth it
+            runs.push_back(format_sort_unique(plan, chunk));
+            break;
+        }
+        if (workers.size() >= workers.get_max_pending()) {
+            runs.push_back(workers.take_front());
         }
+        workers.submit([&plan, chunk = std::move(chunk)] { return format_sort_unique(plan, chunk); });
+    }
+    while (!workers.empty()) {
+        runs.push_back(workers.take_front());
+    }
+
+    print_merged_runs(target, runs);
+}
+
 
-        output.insert(fmt::vformat(format, arg_store));
+void print_pkg_set_with_format_unsorted(
+    std::FILE * target, const libdnf5::rpm::PackageSet & pkgs, const std::string & queryformat) {
+    const QueryFormatPlan plan(pkgs.get_base(), queryformat);
+    if (!plan.has_tags()) {
+        for (auto iter = pkgs.begin(); iter != pkgs.end(); ++iter) {
+            std::fwrite(plan.get_trailing_literal().data(), 1, plan.get_trailing_literal().size(), target);
+        }
+        return;
     }
 
-    for (const auto & line : output) {
-        fmt::print(target, "{}", line);
+    // Chunks formatted by the workers are written in the order of the packages as soon as
+    // all the preceding chunks are written.
+    auto write = [target](const std::string & output) { std::fwrite(output.data(), 1, output.size(), target); };
+    ChunkWorkers<std::string> workers;
+    auto iter = pkgs.begin();
+    const auto end = pkgs.end();
+    while (iter != end) {
+        auto chunk = collect_chunk(plan, iter, end);
+        if (iter == end && workers.empty()) {
+            // The whole set fits into one chunk, processing in a worker is not worth it
+            write(format_concatenated(plan, chunk));
+            break;
+        }
+        while (!workers.empty() && (workers.size() >= workers.get_max_pending() || workers.is_front_done())) {
+            write(workers.take_front());
+        }
+        workers.submit([&plan, chunk = std::move(chunk)] { return format_concatenated(plan, chunk); });
+    }
+    while (!workers.empty()) {
+        write(workers.take_front());
     }
 }
 
@@ -27,8 +27,11 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <limits>
+#include <string>
+#include <string_view>
 #include <utility>
 
 
@@ -38,6 +41,14 @@ class MultiProgressBar::Impl {
 public:
     Impl(TrackingMode tracking_mode);
 
+    /// Returns true if print() should render now, false if the update can be coalesced into a later frame.
+    bool is_time_to_render();
+
+    /// Writes the rendered text to the stream, rewriting only the in-progress lines that changed
+    /// since the previous render. The first `completed_length` characters of text_buffer are completed bars.
+    void write_changed_lines(
+        std::ostream & stream, std::size_t last_num_of_lines_to_clear, std::size_t completed_length);
+
     const TrackingMode tracking_mode;
 
     std::size_t total_bar_visible_limit{0};
@@ -57,6 +68,19 @@ public:
 
     // Reused across operator<< calls to retain allocated capacity between renders
     std::ostringstream text_buffer;
+
+    // Render scheduling used by print(), zero interval means no limit
+    std::chrono::steady_clock::duration min_render_interval{0};
+    std::chrono::steady_clock::time_point last_render_time{};
+    // A state or message change, or a bar reaching its total ticks, that is printed without waiting for the next frame
+    bool render_forced{false};
+
+    // Incremental rendering: in-progress lines printed by the previous render.
+    // Empty if they don't map one-to-one to terminal lines (e.g. wrapped messages), a full redraw follows then.
+    bool incremental_rendering{false};
+    std::vector<std::string> last_frame_lines;
+    std::vector<std::string> frame_lines;
+    std::string frame_output;
 };
 
 
@@ -79,6 +103,12 @@ BarNumberType cast_to_bar_number(auto value) {
     return static_cast<BarNumberType>(value);
 }
 
+/// Returns true if the bar is switched to the SUCCESS state during the next render.
+bool is_about_to_finish(const ProgressBar & bar) noexcept {
+    return bar.get_auto_finish() && bar.get_state() == ProgressBarState::STARTED && bar.get_total_ticks() >= 0 &&
+           bar.get_ticks() >= bar.get_total_ticks();
+}
+
 }  // namespace
 
 
@@ -88,6 +118,98 @@ MultiProgressBar::Impl::Impl(TrackingMode tracking_mode) : tracking_mode(trackin
 }
 
 
+bool MultiProgressBar::Impl::is_time_to_render() {
+    if (min_render_interval == std::chrono::steady_clock::duration::zero()) {
+        return true;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (!render_forced && now - last_render_time < min_render_interval) {
+        return false;
+    }
+    render_forced = false;
+    last_render_time = now;
+    return true;
+}
+
+
+void MultiProgressBar::Impl::write_changed_lines(
+    std::ostream & stream, std::size_t last_num_of_lines_to_clear, std::size_t completed_length) {
+    const std::string_view text = text_buffer.view();
+    const std::string_view in_progress = text.substr(completed_length);
+
+    frame_lines.clear();
+    for (std::size_t begin = 0;;) {
+        const auto end = in_progress.find('\n', begin);
+        frame_lines.emplace_back(in_progress.substr(begin, end == std::string_view::npos ? end : end - begin));
+        if (end == std::string_view::npos) {
+            break;
+        }
+        begin = end + 1;
+    }
+
+    frame_output.clear();
+    if (completed_length > 0 || last_frame_lines.empty()) {
+        // Completed bars are printed in place of the in-progress lines and shift them down, redraw everything.
+        std::size_t lines_up{0};
+        bool clear{true};
+        if (!last_frame_lines.empty()) {
+            lines_up = last_frame_lines.size() - 1;
+        } else if (last_num_of_lines_to_clear > 0) {
+            lines_up = last_num_of_lines_to_clear - 1;
+        } else {
+            clear = false;
+        }
+        if (clear) {
+            if (lines_up > 0) {
+                frame_output += "\033[" + std::to_string(lines_up) + "A";
+            }
+            frame_output += "\r\033[0J";
+        }
+        frame_output += text;
+    } else {
+        std::size_t first_changed{0};
+        while (first_changed < frame_lines.size() && first_changed < last_frame_lines.size() &&
+               frame_lines[first_changed] == last_frame_lines[first_changed]) {
+            ++first_changed;
+        }
+        if (first_changed < frame_lines.size() || frame_lines.size() != last_frame_lines.size()) {
+            // The cursor is at the end of the last line of the previous frame. The last line is always
+            // rewritten to leave the cursor at its end.
+            const auto cursor_line = last_frame_lines.size() - 1;
+            first_changed = std::min({first_changed, frame_lines.size() - 1, cursor_line});
+            if (cursor_line > first_changed) {
+                frame_output += "\033[" + std::to_string(cursor_line - first_changed) + "A";
+            }
+            frame_output += '\r';
+            for (auto idx = first_changed; idx < frame_lines.size(); ++idx) {
+                if (idx > first_changed) {
+                    frame_output += '\n';
+                }
+                const bool is_last = idx + 1 == frame_lines.size();
+                if (!is_last && idx < last_frame_lines.size() && frame_lines[idx] == last_frame_lines[idx]) {
+                    continue;
+                }
+                // the frame shrank, the last line also clears the remaining lines of the previous frame
+                frame_output += is_last && frame_lines.size() < last_frame_lines.size() ? "\033[0J" : "\033[2K";
+                frame_output += frame_lines[idx];
+            }
+        }
+    }
+
+    if (!frame_output.empty()) {
+        stream << frame_output;  // Single syscall to output all commands
+    }
+
+    // A frame finished with a new line leaves the cursor on an extra empty line
+    const bool ends_with_new_line = !in_progress.empty() && in_progress.back() == '\n';
+    if (frame_lines.size() == num_of_lines_to_clear + (ends_with_new_line ? 1 : 0)) {
+        std::swap(last_frame_lines, frame_lines);
+    } else {
+        last_frame_lines.clear();
+    }
+}
+
+
 MultiProgressBar::MultiProgressBar(TrackingMode tracking_mode) : p_impl(new Impl(tracking_mode)) {
     if (tty::is_interactive()) {
         std::cerr << tty::cursor_hide;
@@ -111,6 +233,9 @@ MultiProgressBar::TrackingMode MultiProgressBar::get_tracking_mode() const noexc
 
 
 void MultiProgressBar::print() {
+    if (!p_impl->is_time_to_render()) {
+        return;
+    }
     std::cerr << *this;
     std::cerr << std::flush;
 }
@@ -172,8 +297,26 @@ std::size_t MultiProgressBar::get_total_num_of_bars() const noexcept {
 }
 
 
+void MultiProgressBar::set_max_frame_rate(std::size_t value) noexcept {
+    if (value == 0) {
+        p_impl->min_render_interval = std::chrono::steady_clock::duration::zero();
+    } else {
+        p_impl->min_render_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                          std::chrono::seconds(1)) /
+                                      static_cast<std::chrono::steady_clock::rep>(value);
+    }
+}
+
+
+void MultiProgressBar::set_incremental_rendering(bool value) noexcept {
+    p_impl->incremental_rendering = value;
+    p_impl->last_frame_lines.clear();
+}
+
+
 std::ostream & operator<<(std::ostream & stream, MultiProgressBar & mbar) {
     const bool is_interactive{tty::is_interactive()};
+    const bool incremental{is_interactive && mbar.p_impl->incremental_rendering};
     auto terminal_width = static_cast<std::size_t>(tty::get_width());
     auto total_num_of_bars = mbar.p_impl->total.get_total();
 
@@ -181,7 +324,9 @@ std::ostream & operator<<(std::ostream & stream, MultiProgressBar & mbar) {
     // This is to avoid multiple writes to the terminal, which can cause flickering.
     std::ostringstream & text_buffer = mbar.p_impl->text_buffer;
 
-    if (is_interactive && mbar.p_impl->num_of_lines_to_clear > 0) {
+    // In incremental mode the cursor is moved when writing the changed lines
+    const auto last_num_of_lines_to_clear = mbar.p_impl->num_of_lines_to_clear;
+    if (is_interactive && !incremental && mbar.p_impl->num_of_lines_to_clear > 0) {
         if (mbar.p_impl->num_of_lines_to_clear > 1) {
             // Move the cursor up by the number of lines we want to write over
             text_buffer << "\033[" << (mbar.p_impl->num_of_lines_to_clear - 1) << "A";
@@ -220,6 +365,7 @@ std::ostream & operator<<(std::ostream & stream, MultiProgressBar & mbar) {
         ++mbar.p_impl->bars_done_count;
         it = mbar.p_impl->bars_todo.erase(it);
     }
+    const auto completed_length = text_buffer.view().size();
 
     // then print incomplete
     for (auto & bar : mbar.p_impl->bars_todo) {
@@ -296,7 +442,11 @@ std::ostream & operator<<(std::ostream & stream, MultiProgressBar & mbar) {
         }
     }
 
-    stream << text_buffer.str();  // Single syscall to output all commands
+    if (incremental) {
+        mbar.p_impl->write_changed_lines(stream, last_num_of_lines_to_clear, completed_length);
+    } else {
+        stream << text_buffer.str();  // Single syscall to output all commands
+    }
 
     text_buffer.str("");
     text_buffer.clear();
@@ -319,6 +469,9 @@ void MultiProgressBar::bar_set_ticks(ProgressBar & bar, int64_t value) {
         p_impl->inactive_ticks += (value > 0 ? value : 0) - (old_ticks > 0 ? old_ticks : 0);
     }
     bar.set_ticks(value);
+    if (is_about_to_finish(bar)) {
+        p_impl->render_forced = true;
+    }
 }
 
 
@@ -341,6 +494,9 @@ void MultiProgressBar::bar_set_total_ticks(ProgressBar & bar, int64_t value) {
         p_impl->inactive_total_ticks += (value > 0 ? value : 0) - (old_ticks > 0 ? old_ticks : 0);
     }
     bar.set_total_ticks(value);
+    if (is_about_to_finish(bar)) {
+        p_impl->render_forced = true;
+    }
 }
 
 
@@ -363,6 +519,9 @@ void MultiProgressBar::bar_start(ProgressBar & bar) {
         p_impl->bars_todo.push_back(&bar);
     }
     bar.start();
+    if (is_about_to_finish(bar)) {
+        p_impl->render_forced = true;
+    }
 }
 
 
@@ -395,6 +554,7 @@ void MultiProgressBar::bar_set_state(ProgressBar & bar, ProgressBarState value)
         p_impl->bars_todo.push_back(&bar);
     }
     bar.set_state(value);
+    p_impl->render_forced = true;
 }
 
 
@@ -416,6 +576,7 @@ void MultiProgressBar::bar_add_message(ProgressBar & bar, MessageType type, cons
         return;
     }
     bar.add_message(type, message);
+    p_impl->render_forced = true;
 }
 
 
@@ -424,6 +585,7 @@ void MultiProgressBar::bar_pop_message(ProgressBar & bar) {
         return;
     }
     bar.pop_message();
+    p_impl->render_forced = true;
 }
 
 
@@ -131,6 +131,7 @@ public:
 
 private:
     friend class AdvisoryCollection;
+    friend class AdvisorySack;
     friend AdvisoryPackage;
 
     Impl(
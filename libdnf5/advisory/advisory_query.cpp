@@ -230,10 +230,16 @@ void AdvisoryQuery::filter_severity(const std::vector<std::string> & severities,
         *get_rpm_pool(p_impl->base), UPDATE_SEVERITY, *AdvisorySet::p_impl, cmp_type, severities);
 }
 
+static bool evr_cmp_matches(int evr_cmp, sack::QueryCmp cmp_type) {
+    return ((evr_cmp > 0) && ((cmp_type & sack::QueryCmp::GT) == sack::QueryCmp::GT)) ||
+           ((evr_cmp < 0) && ((cmp_type & sack::QueryCmp::LT) == sack::QueryCmp::LT)) ||
+           ((evr_cmp == 0) && ((cmp_type & sack::QueryCmp::EQ) == sack::QueryCmp::EQ));
+}
+
 void AdvisoryQuery::filter_packages(const std::vector<libdnf5::rpm::Nevra> & nevras, sack::QueryCmp cmp_type) {
     auto & pool = get_rpm_pool(p_impl->base);
+    auto advisory_sack = p_impl->base->p_impl->get_rpm_advisory_sack();
     libdnf5::solv::SolvMap filter_result(pool.get_nsolvables());
-    std::vector<AdvisoryPackage> adv_pkgs = get_advisory_packages_sorted_by_name_arch_evr_string();
 
     bool cmp_not = (cmp_type & libdnf5::sack::QueryCmp::NOT) == libdnf5::sack::QueryCmp::NOT;
     if (cmp_not) {
@@ -243,24 +249,23 @@ void AdvisoryQuery::filter_packages(const std::vector<libdnf5::rpm::Nevra> & nev
 
     switch (cmp_type) {
         case libdnf5::sack::QueryCmp::EQ:
-            //TODO(amatej): faster EQ specific version (we can compare whole NEVRA)
         case libdnf5::sack::QueryCmp::GT:
         case libdnf5::sack::QueryCmp::LT:
         case libdnf5::sack::QueryCmp::GTE:
         case libdnf5::sack::QueryCmp::LTE: {
             for (const auto & nevra : nevras) {
-                auto low = std::lower_bound(
-                    adv_pkgs.begin(), adv_pkgs.end(), nevra, AdvisoryPackage::Impl::name_arch_compare_lower_nevra);
-                while (low != adv_pkgs.end() && low->get_name() == nevra.get_name() &&
-                       low->get_arch() == nevra.get_arch()) {
-                    int evr_cmp = libdnf5::rpm::evrcmp(*low, nevra);
-
-                    if (((evr_cmp > 0) && ((cmp_type & sack::QueryCmp::GT) == sack::QueryCmp::GT)) ||
-                        ((evr_cmp < 0) && ((cmp_type & sack::QueryCmp::LT) == sack::QueryCmp::LT)) ||
-                        ((evr_cmp == 0) && ((cmp_type & sack::QueryCmp::EQ) == sack::QueryCmp::EQ))) {
-                        filter_result.add_unsafe((*low).get_advisory_id().id);
+                // Name or arch unknown to the pool cannot be in any advisory
+                Id name = pool.str2id(nevra.get_name().c_str(), false);
+                Id arch = pool.str2id(nevra.get_arch().c_str(), false);
+                if (name == 0 || arch == 0) {
+                    continue;
+                }
+                // Nevra evr strings are not normalized, they have to be compared one by one
+                for (const auto & entry : advisory_sack->get_packages(name, arch)) {
+                    if (evr_cmp_matches(
+                            libdnf5::rpm::evrcmp(advisory_sack->make_advisory_package(entry), nevra), cmp_type)) {
+                        filter_result.add_unsafe(entry.advisory);
                     }
-                    ++low;
                 }
             }
 
@@ -279,8 +284,8 @@ void AdvisoryQuery::filter_packages(const std::vector<libdnf5::rpm::Nevra> & nev
 
 void AdvisoryQuery::filter_packages(const libdnf5::rpm::PackageSet & package_set, sack::QueryCmp cmp_type) {
     auto & pool = get_rpm_pool(p_impl->base);
+    auto advisory_sack = p_impl->base->p_impl->get_rpm_advisory_sack();
     libdnf5::solv::SolvMap filter_result(pool.get_nsolvables());
-    std::vector<AdvisoryPackage> adv_pkgs = get_advisory_packages_sorted_by_name_arch_evr();
 
     bool cmp_not = (cmp_type & libdnf5::sack::QueryCmp::NOT) == libdnf5::sack::QueryCmp::NOT;
     if (cmp_not) {
@@ -289,25 +294,25 @@ void AdvisoryQuery::filter_packages(const libdnf5::rpm::PackageSet & package_set
     }
 
     switch (cmp_type) {
-        case libdnf5::sack::QueryCmp::EQ:
-            //TODO(amatej): faster EQ specific version (we can compare whole NEVRA)
+        case libdnf5::sack::QueryCmp::EQ: {
+            // Special faster case for EQ (whole NEVRA is looked up in the advisory package index)
+            for (const auto & package : package_set) {
+                Solvable * solvable = pool.id2solvable(package.get_id().id);
+                for (const auto & entry : advisory_sack->get_packages(solvable->name, solvable->arch, solvable->evr)) {
+                    filter_result.add_unsafe(entry.advisory);
+                }
+            }
+        } break;
         case libdnf5::sack::QueryCmp::GT:
         case libdnf5::sack::QueryCmp::LT:
         case libdnf5::sack::QueryCmp::GTE:
         case libdnf5::sack::QueryCmp::LTE: {
             for (const auto & package : package_set) {
                 Solvable * solvable = pool.id2solvable(package.get_id().id);
-                auto low = std::lower_bound(
-                    adv_pkgs.begin(), adv_pkgs.end(), package, AdvisoryPackage::Impl::name_arch_compare_lower_id);
-                while (low != adv_pkgs.end() && low->p_impl.get()->get_name_id() == solvable->name &&
-                       low->p_impl.get()->get_arch_id() == solvable->arch) {
-                    int libsolv_cmp = pool.evrcmp(low->p_impl.get()->get_evr_id(), solvable->evr, EVRCMP_COMPARE);
-                    if (((libsolv_cmp > 0) && ((cmp_type & sack::QueryCmp::GT) == sack::QueryCmp::GT)) ||
-                        ((libsolv_cmp < 0) && ((cmp_type & sack::QueryCmp::LT) == sack::QueryCmp::LT)) ||
-                        ((libsolv_cmp == 0) && ((cmp_type & sack::QueryCmp::EQ) == sack::QueryCmp::EQ))) {
-                        filter_result.add_unsafe((*low).get_advisory_id().id);
+                for (const auto & entry : advisory_sack->get_packages(solvable->name, solvable->arch)) {
+                    if (evr_cmp_matches(pool.evrcmp(entry.evr, solvable->evr, EVRCMP_COMPARE), cmp_type)) {
+                        filter_result.add_unsafe(entry.advisory);
                     }
-                    ++low;
                 }
             }
 
@@ -326,31 +331,34 @@ void AdvisoryQuery::filter_packages(const libdnf5::rpm::PackageSet & package_set
 
 std::vector<AdvisoryPackage> AdvisoryQuery::get_advisory_packages_sorted(
     const libdnf5::rpm::PackageSet & package_set, sack::QueryCmp cmp_type) const {
-    std::vector<AdvisoryPackage> adv_pkgs = get_advisory_packages_sorted_by_name_arch_evr();
     std::vector<AdvisoryPackage> after_filter;
 
     auto & pool = get_rpm_pool(p_impl->base);
+    auto advisory_sack = p_impl->base->p_impl->get_rpm_advisory_sack();
 
     switch (cmp_type) {
-        case libdnf5::sack::QueryCmp::EQ:
-            //TODO(amatej): faster EQ specific version (we can compare whole NEVRA)
+        case libdnf5::sack::QueryCmp::EQ: {
+            // Special faster case for EQ (whole NEVRA is looked up in the advisory package index)
+            for (const auto & package : package_set) {
+                Solvable * solvable = pool.id2solvable(package.get_id().id);
+                for (const auto & entry : advisory_sack->get_packages(solvable->name, solvable->arch, solvable->evr)) {
+                    if (AdvisorySet::p_impl->contains(entry.advisory)) {
+                        after_filter.push_back(advisory_sack->make_advisory_package(entry));
+                    }
+                }
+            }
+        } break;
         case libdnf5::sack::QueryCmp::GT:
         case libdnf5::sack::QueryCmp::LT:
         case libdnf5::sack::QueryCmp::GTE:
         case libdnf5::sack::QueryCmp::LTE: {
             for (const auto & package : package_set) {
                 Solvable * solvable = pool.id2solvable(package.get_id().id);
-                auto low = std::lower_bound(
-                    adv_pkgs.begin(), adv_pkgs.end(), package, AdvisoryPackage::Impl::name_arch_compare_lower_id);
-                while (low != adv_pkgs.end() && low->p_impl.get()->get_name_id() == solvable->name &&
-                       low->p_impl.get()->get_arch_id() == solvable->arch) {
-                    int libsolv_cmp = pool.evrcmp(low->p_impl.get()->get_evr_id(), solvable->evr, EVRCMP_COMPARE);
-                    if (((libsolv_cmp > 0) && ((cmp_type & sack::QueryCmp::GT) == sack::QueryCmp::GT)) ||
-                        ((libsolv_cmp < 0) && ((cmp_type & sack::QueryCmp::LT) == sack::QueryCmp::LT)) ||
-                        ((libsolv_cmp == 0) && ((cmp_type & sack::QueryCmp::EQ) == sack::QueryCmp::EQ))) {
-                        after_filter.push_back(*low);
+                for (const auto & entry : advisory_sack->get_packages(solvable->name, solvable->arch)) {
+                    if (AdvisorySet::p_impl->contains(entry.advisory) &&
+                        evr_cmp_matches(pool.evrcmp(entry.evr, solvable->evr, EVRCMP_COMPARE), cmp_type)) {
+                        after_filter.push_back(advisory_sack->make_advisory_package(entry));
                     }
-                    ++low;
                 }
             }
         } break;
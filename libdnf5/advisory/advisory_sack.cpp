@@ -19,11 +19,15 @@
 
 #include "advisory_sack.hpp"
 
+#include "advisory_package_private.hpp"
 #include "solv/pool.hpp"
 #include "solv/solv_map.hpp"
 
 #include <solv/dataiterator.h>
 
+#include <algorithm>
+#include <functional>
+
 namespace libdnf5::advisory {
 
 libdnf5::solv::SolvMap & AdvisorySack::get_solvables() {
@@ -60,6 +64,133 @@ libdnf5::solv::SolvMap & AdvisorySack::get_solvables() {
     return data_map;
 }
 
+namespace {
+
+std::uint64_t name_arch_key(Id name, Id arch) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(name)) << 32) | static_cast<std::uint32_t>(arch);
+}
+
+bool entry_compare_lower(const AdvisoryPackageEntry & first, const AdvisoryPackageEntry & second) {
+    if (first.name != second.name) {
+        return first.name < second.name;
+    }
+    if (first.arch != second.arch) {
+        return first.arch < second.arch;
+    }
+    return first.evr < second.evr;
+}
+
+}  // namespace
+
+std::size_t AdvisorySack::NameArchEvrHash::operator()(const NameArchEvr & key) const noexcept {
+    std::size_t hash = std::hash<std::uint64_t>{}(name_arch_key(key.name, key.arch));
+    return hash ^ (std::hash<Id>{}(key.evr) + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+}
+
+void AdvisorySack::build_package_index() {
+    auto & pool = get_rpm_pool(base);
+    auto & advisories = get_solvables();
+
+    sorted_packages.clear();
+    name_arch_ranges.clear();
+    name_arch_evr_ranges.clear();
+
+    // The same walk as AdvisoryCollection::get_packages() but over all collections of all advisories at once.
+    for (Id advisory_id : advisories) {
+        Dataiterator di;
+        dataiterator_init(&di, *pool, 0, advisory_id, UPDATE_COLLECTIONLIST, 0, 0);
+        for (int collection_index = 0; dataiterator_step(&di); collection_index++) {
+            dataiterator_setpos(&di);
+            Dataiterator di_inner;
+            dataiterator_init(&di_inner, *pool, 0, SOLVID_POS, UPDATE_COLLECTION, 0, 0);
+            while (dataiterator_step(&di_inner)) {
+                dataiterator_setpos(&di_inner);
+                sorted_packages.push_back(
+                    {pool.lookup_id(SOLVID_POS, UPDATE_COLLECTION_NAME),
+                     pool.lookup_id(SOLVID_POS, UPDATE_COLLECTION_ARCH),
+                     pool.lookup_id(SOLVID_POS, UPDATE_COLLECTION_EVR),
+                     advisory_id,
+                     collection_index,
+                     pool.lookup_void(SOLVID_POS, UPDATE_REBOOT),
+                     pool.lookup_void(SOLVID_POS, UPDATE_RESTART),
+                     pool.lookup_void(SOLVID_POS, UPDATE_RELOGIN)});
+            }
+            dataiterator_free(&di_inner);
+        }
+        dataiterator_free(&di);
+    }
+
+    // Stable sort keeps packages with the same name, arch and evr in the advisory order
+    std::stable_sort(sorted_packages.begin(), sorted_packages.end(), entry_compare_lower);
+
+    for (std::size_t begin = 0; begin < sorted_packages.size();) {
+        const auto & first = sorted_packages[begin];
+        std::size_t end = begin + 1;
+        while (end < sorted_packages.size() && sorted_packages[end].name == first.name &&
+               sorted_packages[end].arch == first.arch) {
+            ++end;
+        }
+        name_arch_ranges.emplace(name_arch_key(first.name, first.arch), Range(begin, end));
+
+        for (std::size_t evr_begin = begin; evr_begin < end;) {
+            std::size_t evr_end = evr_begin + 1;
+            while (evr_end < end && sorted_packages[evr_end].evr == sorted_packages[evr_begin].evr) {
+                ++evr_end;
+            }
+            name_arch_evr_ranges.emplace(
+                NameArchEvr{first.name, first.arch, sorted_packages[evr_begin].evr}, Range(evr_begin, evr_end));
+            evr_begin = evr_end;
+        }
+
+        begin = end;
+    }
+
+    indexed_solvables_size = pool.get_nsolvables();
+}
+
+const std::vector<AdvisoryPackageEntry> & AdvisorySack::get_sorted_packages() {
+    if (indexed_solvables_size != get_rpm_pool(base).get_nsolvables()) {
+        build_package_index();
+    }
+    return sorted_packages;
+}
+
+std::span<const AdvisoryPackageEntry> AdvisorySack::get_range(const Range & range) const {
+    return std::span<const AdvisoryPackageEntry>(sorted_packages).subspan(range.first, range.second - range.first);
+}
+
+std::span<const AdvisoryPackageEntry> AdvisorySack::get_packages(Id name, Id arch) {
+    get_sorted_packages();
+    auto it = name_arch_ranges.find(name_arch_key(name, arch));
+    if (it == name_arch_ranges.end()) {
+        return {};
+    }
+    return get_range(it->second);
+}
+
+std::span<const AdvisoryPackageEntry> AdvisorySack::get_packages(Id name, Id arch, Id evr) {
+    get_sorted_packages();
+    auto it = name_arch_evr_ranges.find(NameArchEvr{name, arch, evr});
+    if (it == name_arch_evr_ranges.end()) {
+        return {};
+    }
+    return get_range(it->second);
+}
+
+AdvisoryPackage AdvisorySack::make_advisory_package(const AdvisoryPackageEntry & entry) const {
+    return AdvisoryPackage(new AdvisoryPackage::Impl(
+        base,
+        AdvisoryId(entry.advisory),
+        entry.collection_index,
+        entry.name,
+        entry.evr,
+        entry.arch,
+        entry.reboot_suggested,
+        entry.restart_suggested,
+        entry.relogin_suggested,
+        nullptr));
+}
+
 AdvisorySack::AdvisorySack(const libdnf5::BaseWeakPtr & base) : base(base) {}
 
 AdvisorySackWeakPtr AdvisorySack::get_weak_ptr() {
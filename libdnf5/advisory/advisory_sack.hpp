@@ -22,9 +22,17 @@
 
 #include "solv/solv_map.hpp"
 
+#include "libdnf5/advisory/advisory_package.hpp"
 #include "libdnf5/base/base_weak.hpp"
 #include "libdnf5/common/weak_ptr.hpp"
 
+#include <solv/pooltypes.h>
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
 
 namespace libdnf5::advisory {
 
@@ -32,6 +40,20 @@ class AdvisorySack;
 using AdvisorySackWeakPtr = WeakPtr<AdvisorySack, false>;
 
 
+/// Package of an advisory collection as stored in the AdvisorySack package index.
+/// Only libsolv ids are kept, AdvisoryPackage objects are created on demand.
+struct AdvisoryPackageEntry {
+    Id name;
+    Id arch;
+    Id evr;
+    Id advisory;
+    int collection_index;
+    bool reboot_suggested;
+    bool restart_suggested;
+    bool relogin_suggested;
+};
+
+
 class AdvisorySack {
 public:
     explicit AdvisorySack(const libdnf5::BaseWeakPtr & base);
@@ -45,12 +67,47 @@ public:
     /// @return All advisories from pool inside of base.
     libdnf5::solv::SolvMap & get_solvables();
 
+    /// Packages of all advisories from pool inside of base sorted by libsolv `id`s of name, arch and evr.
+    /// The index is built on the first use and rebuilt when solvables are added to the pool.
+    const std::vector<AdvisoryPackageEntry> & get_sorted_packages();
+
+    /// @return Span of get_sorted_packages() with the given name and arch, empty if there is none.
+    std::span<const AdvisoryPackageEntry> get_packages(Id name, Id arch);
+
+    /// @return Span of get_sorted_packages() with the given name, arch and evr, empty if there is none.
+    std::span<const AdvisoryPackageEntry> get_packages(Id name, Id arch, Id evr);
+
+    /// Create an AdvisoryPackage (without filename) from the index entry.
+    AdvisoryPackage make_advisory_package(const AdvisoryPackageEntry & entry) const;
+
 private:
+    struct NameArchEvr {
+        Id name;
+        Id arch;
+        Id evr;
+
+        bool operator==(const NameArchEvr & other) const = default;
+    };
+
+    struct NameArchEvrHash {
+        std::size_t operator()(const NameArchEvr & key) const noexcept;
+    };
+
+    using Range = std::pair<std::size_t, std::size_t>;
+
+    void build_package_index();
+    std::span<const AdvisoryPackageEntry> get_range(const Range & range) const;
+
     libdnf5::BaseWeakPtr base;
     WeakPtrGuard<AdvisorySack, false> sack_guard;
 
     libdnf5::solv::SolvMap data_map{0};
     int cached_solvables_size{0};
+
+    std::vector<AdvisoryPackageEntry> sorted_packages;
+    std::unordered_map<std::uint64_t, Range> name_arch_ranges;
+    std::unordered_map<NameArchEvr, Range, NameArchEvrHash> name_arch_evr_ranges;
+    int indexed_solvables_size{0};
 };
 
 }  // namespace libdnf5::advisory
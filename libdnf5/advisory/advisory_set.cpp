@@ -22,6 +22,7 @@
 
 #include "advisory/advisory_package_private.hpp"
 #include "advisory_set_impl.hpp"
+#include "base/base_impl.hpp"
 #include "base/base_private.hpp"
 #include "solv/solv_map.hpp"
 
@@ -121,6 +122,18 @@ BaseWeakPtr AdvisorySet::get_base() const {
 
 std::vector<AdvisoryPackage> AdvisorySet::get_advisory_packages_sorted_by_name_arch_evr(bool only_applicable) const {
     std::vector<AdvisoryPackage> out;
+
+    if (!only_applicable) {
+        // Take the packages from the per pool index, it is already sorted by name, arch and evr ids
+        auto advisory_sack = InternalBaseUser::get_rpm_advisory_sack(p_impl->base);
+        for (const auto & entry : advisory_sack->get_sorted_packages()) {
+            if (p_impl->contains(entry.advisory)) {
+                out.push_back(advisory_sack->make_advisory_package(entry));
+            }
+        }
+        return out;
+    }
+
     for (Id candidate_id : *p_impl) {
         Advisory advisory2 = Advisory(p_impl->base, AdvisoryId(candidate_id));
         auto collections = advisory2.get_collections();
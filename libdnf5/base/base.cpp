@@ -92,6 +92,8 @@ Base * Base::get_locked_base() noexcept {
 }
 
 void Base::load_config() {
+    base::Tracer::Scope trace(p_impl->tracer, "load_config");
+
     fs::path conf_file_path{p_impl->config.get_config_file_path_option().get_value()};
     fs::path conf_dir_path{CONF_DIRECTORY};
     fs::path distribution_conf_dir_path{LIBDNF5_DISTRIBUTION_CONFIG_DIR};
@@ -238,6 +240,8 @@ void Base::setup() {
     auto & pool = p_impl->pool;
     libdnf_user_assert(!pool, "Base was already initialized");
 
+    base::Tracer::Scope trace(p_impl->tracer, "setup");
+
     // Resolve installroot configuration
     std::string vars_installroot{"/"};
     const std::filesystem::path installroot_path{p_impl->config.get_installroot_option().get_value()};
@@ -288,8 +292,11 @@ void Base::setup() {
         usr_drift_option.set(usr_drift_option.get_priority(), resolved_usr_drift);
     }
 
-    load_plugins();
-    p_impl->plugins.init();
+    {
+        base::Tracer::Scope trace_plugins(p_impl->tracer, "load_plugins");
+        load_plugins();
+        p_impl->plugins.init();
+    }
 
     libdnf5::utils::OnScopeExit run_post_base_setup_cleanup(
         [this]() noexcept { p_impl->plugins.post_base_setup_cleanup(); });
@@ -302,21 +309,27 @@ void Base::setup() {
     installroot.lock("Locked by Base::setup()");
     auto vars = get_vars();
 
-    vars->load(vars_installroot, config.get_varsdir_option().get_value());
+    {
+        base::Tracer::Scope trace_vars(p_impl->tracer, "load_vars");
+        vars->load(vars_installroot, config.get_varsdir_option().get_value());
+    }
 
     // Load vendor change policies
-    fs::path vendor_conf_dir_path{VENDOR_CONF_DIR};
-    fs::path distribution_vendor_conf_dir_path{LIBDNF5_DISTRIBUTION_VENDOR_CONF_DIR};
-    const bool use_installroot_config{!p_impl->config.get_use_host_config_option().get_value()};
-    if (use_installroot_config) {
-        fs::path installroot_path{p_impl->config.get_installroot_option().get_value()};
-        vendor_conf_dir_path = installroot_path / vendor_conf_dir_path.relative_path();
-        distribution_vendor_conf_dir_path = installroot_path / distribution_vendor_conf_dir_path.relative_path();
-    }
-    const auto paths =
-        utils::fs::create_sorted_file_list({vendor_conf_dir_path, distribution_vendor_conf_dir_path}, ".conf");
-    for (const auto & path : paths) {
-        pool->load_vendor_change_policy(path);
+    {
+        base::Tracer::Scope trace_vendor_policies(p_impl->tracer, "load_vendor_change_policies");
+        fs::path vendor_conf_dir_path{VENDOR_CONF_DIR};
+        fs::path distribution_vendor_conf_dir_path{LIBDNF5_DISTRIBUTION_VENDOR_CONF_DIR};
+        const bool use_installroot_config{!p_impl->config.get_use_host_config_option().get_value()};
+        if (use_installroot_config) {
+            fs::path installroot_path{p_impl->config.get_installroot_option().get_value()};
+            vendor_conf_dir_path = installroot_path / vendor_conf_dir_path.relative_path();
+            distribution_vendor_conf_dir_path = installroot_path / distribution_vendor_conf_dir_path.relative_path();
+        }
+        const auto paths =
+            utils::fs::create_sorted_file_list({vendor_conf_dir_path, distribution_vendor_conf_dir_path}, ".conf");
+        for (const auto & path : paths) {
+            pool->load_vendor_change_policy(path);
+        }
     }
 
     config.get_varsdir_option().lock("Locked by Base::setup()");
@@ -401,6 +414,10 @@ VarsWeakPtr Base::get_vars() {
     return {&p_impl->vars, &p_impl->vars_guard};
 }
 
+base::Tracer & Base::get_tracer() {
+    return p_impl->tracer;
+}
+
 libdnf5::BaseWeakPtr Base::get_weak_ptr() {
     return {this, &base_guard};
 }
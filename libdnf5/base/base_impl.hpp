@@ -21,6 +21,7 @@
 #define LIBDNF5_BASE_BASE_IMPL_HPP
 
 #include "../advisory/advisory_sack.hpp"
+#include "comps/comps_sack_impl.hpp"
 #include "plugin/plugins.hpp"
 #include "system/state.hpp"
 
@@ -93,6 +94,7 @@ private:
     libdnf5::advisory::AdvisorySack rpm_advisory_sack;
 
     plugin::Plugins plugins;
+    base::Tracer tracer;
     LogRouter log_router;
     ConfigMain config;
     comps::CompsSack comps_sack;
@@ -126,6 +128,18 @@ public:
     static std::vector<plugin::PluginInfo> & get_plugins_info(Base * base) { return base->p_impl->get_plugins_info(); }
 
     static solv::RpmPool & get_rpm_pool(const libdnf5::BaseWeakPtr & base) { return base->p_impl->get_rpm_pool(); }
+
+    static system::State & get_system_state(const libdnf5::BaseWeakPtr & base) {
+        return base->p_impl->get_system_state();
+    }
+
+    static advisory::AdvisorySackWeakPtr get_rpm_advisory_sack(const libdnf5::BaseWeakPtr & base) {
+        return base->p_impl->get_rpm_advisory_sack();
+    }
+
+    static void invalidate_comps_index(const libdnf5::BaseWeakPtr & base) {
+        base->get_comps_sack()->p_impl->invalidate_index();
+    }
 };
 
 }  // namespace libdnf5
@@ -32,6 +32,7 @@
 #include "solv/id_queue.hpp"
 #include "solv/pool.hpp"
 #include "solver_problems_internal.hpp"
+#include "transaction/replay_package_resolver.hpp"
 #include "transaction/transaction_merge.hpp"
 #include "transaction/transaction_sr.hpp"
 #include "transaction_impl.hpp"
@@ -52,10 +53,12 @@
 
 #include <fnmatch.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace {
 
@@ -82,6 +85,39 @@ void add_obsoletes_to_data(const libdnf5::rpm::PackageQuery & base_query, libdnf
     data |= obsoletes_query;
 }
 
+/// Split `obsoleters`, packages obsoleting some package in `data`, by the names of the packages of `data` they
+/// obsolete. Uses the same matching as PackageQuery::filter_obsoletes().
+std::unordered_map<Id, std::vector<Id>> split_obsoleters_by_name(
+    const libdnf5::rpm::PackageSet & obsoleters, const libdnf5::solv::SolvMap & data) {
+    auto & spool = libdnf5::get_rpm_pool(obsoleters.get_base());
+    ::Pool * pool = *spool;
+    int obsprovides = pool_get_flag(pool, POOL_FLAG_OBSOLETEUSESPROVIDES);
+
+    std::unordered_map<Id, std::vector<Id>> obsoleters_by_name;
+    for (const auto & obsoleter : obsoleters) {
+        Id obsoleter_id = obsoleter.get_id().id;
+        Solvable * solvable = spool.id2solvable(obsoleter_id);
+        for (Id * r_id = solvable->repo->idarraydata + solvable->dep_obsoletes; *r_id; ++r_id) {
+            Id r;
+            Id rr;
+            FOR_PROVIDES(r, rr, *r_id) {
+                if (!data.contains(r)) {
+                    continue;
+                }
+                Solvable * so = spool.id2solvable(r);
+                if (obsprovides == 0 && pool_match_nevr(pool, so, *r_id) == 0) {
+                    continue; /* only matching pkg names */
+                }
+                auto & name_obsoleters = obsoleters_by_name[so->name];
+                if (name_obsoleters.empty() || name_obsoleters.back() != obsoleter_id) {
+                    name_obsoleters.push_back(obsoleter_id);
+                }
+            }
+        }
+    }
+    return obsoleters_by_name;
+}
+
 /// Add install job of debug packages for installed packages to Goal
 ///
 /// @return bool False when no match for any package
@@ -169,6 +205,20 @@ public:
 
     std::pair<GoalProblem, libdnf5::solv::IdQueue> add_install_to_goal(
         base::Transaction & transaction, GoalAction action, const std::string & spec, GoalJobSettings & settings);
+    /// Add install jobs for packages in `query` that were already resolved from `spec` to `nevra`.
+    /// `base_query` is the query `query` was resolved from, it is used to look up obsoleters.
+    /// Callers adding many specs can pass the installed packages of `base_query` in `installed_packages`
+    /// and the obsoleters of `query` in `obsoleters` (used with multilib_policy `best`) to look them up only once.
+    std::pair<GoalProblem, libdnf5::solv::IdQueue> add_install_query_to_goal(
+        base::Transaction & transaction,
+        GoalAction action,
+        const std::string & spec,
+        GoalJobSettings & settings,
+        const rpm::PackageQuery & base_query,
+        rpm::PackageQuery & query,
+        const rpm::Nevra & nevra,
+        const rpm::PackageSet * installed_packages = nullptr,
+        const std::vector<Id> * obsoleters = nullptr);
     std::pair<GoalProblem, libdnf5::solv::IdQueue> add_install_debug_to_goal(
         base::Transaction & transaction, const std::string & spec, GoalJobSettings & settings);
     void add_provide_install_to_goal(const std::string & spec, GoalJobSettings & settings);
@@ -271,7 +321,8 @@ private:
     rpm::solv::GoalPrivate rpm_goal;
     bool allow_erasing{false};
 
-    void install_group_package(base::Transaction & transaction, libdnf5::comps::Package pkg);
+    void install_group_packages(
+        base::Transaction & transaction, const std::vector<libdnf5::comps::Package> & group_packages);
     void remove_group_packages(const rpm::PackageSet & remove_candidates);
 
     libdnf5::solv::SolvMap incoming_vendor_bypassed_solvables{0};
@@ -843,6 +894,18 @@ static std::set<std::string> query_to_vec_of_nevra_str(const libdnf5::rpm::Packa
     return query_set;
 }
 
+static std::set<std::string> packages_to_nevra_strs(const std::vector<libdnf5::rpm::Package> & packages) {
+    std::set<std::string> nevras;
+    for (const auto & pkg : packages) {
+        nevras.insert(pkg.to_string());
+    }
+    return nevras;
+}
+
+static void filter_installed(std::vector<libdnf5::rpm::Package> & packages) {
+    std::erase_if(packages, [](const auto & pkg) { return !pkg.is_installed(); });
+}
+
 GoalProblem Goal::Impl::add_replay_to_goal(
     base::Transaction & transaction,
     const transaction::TransactionReplay & replay,
@@ -853,43 +916,46 @@ GoalProblem Goal::Impl::add_replay_to_goal(
 
     std::unordered_set<std::string> rpm_nevra_cache;
 
+    // The packages stored with the replay are added to the sack before the resolver indexes the sack
+    std::vector<std::optional<libdnf5::rpm::Package>> local_pkgs;
+    local_pkgs.reserve(replay.packages.size());
     for (const auto & package_replay : replay.packages) {
+        if (package_replay.package_path.empty()) {
+            local_pkgs.emplace_back();
+        } else {
+            // Package paths are relative to replay location
+            local_pkgs.emplace_back(base->get_repo_sack()->add_stored_transaction_package(
+                replay_location / package_replay.package_path, package_replay.repo_id));
+        }
+    }
+
+    // Replays can contain thousands of packages, resolve them using an index instead of queries
+    transaction::ReplayPackageResolver package_resolver(base, replay);
+
+    for (std::size_t idx = 0; idx < replay.packages.size(); ++idx) {
+        const auto & package_replay = replay.packages[idx];
+        const auto & local_pkg = local_pkgs[idx];
         rpm_nevra_cache.insert(package_replay.nevra);
         libdnf5::GoalJobSettings settings_per_package = settings;
         settings_per_package.set_clean_requirements_on_remove(libdnf5::GoalSetting::SET_FALSE);
 
-        std::optional<libdnf5::rpm::Package> local_pkg;
-        if (!package_replay.package_path.empty()) {
-            // Package paths are relative to replay location
-            local_pkg = base->get_repo_sack()->add_stored_transaction_package(
-                replay_location / package_replay.package_path, package_replay.repo_id);
-        }
-
         const auto nevras = rpm::Nevra::parse(package_replay.nevra, {rpm::Nevra::Form::NEVRA});
         libdnf_assert(
             nevras.size() == 1,
             "Cannot parse rpm nevra or ambiguous \"{}\" while replaying transaction.",
             package_replay.nevra);
 
-        rpm::PackageQuery query_na(base);
-        query_na.filter_name(nevras[0].get_name());
-        query_na.filter_arch(nevras[0].get_arch());
-        auto query_nevra = query_na;
-        query_nevra.filter_nevra(nevras[0]);
+        auto packages_na = package_resolver.get_name_arch(nevras[0]);
+        auto packages_nevra = package_resolver.get_nevra(nevras[0]);
 
-        if (!package_replay.repo_id.empty()) {
-            repo::RepoQuery enabled_repos(base);
-            enabled_repos.filter_enabled(true);
-            enabled_repos.filter_id(package_replay.repo_id);
-            if (!enabled_repos.empty()) {
-                settings_per_package.set_to_repo_ids({package_replay.repo_id});
-            }
+        if (!package_replay.repo_id.empty() && package_resolver.is_repo_enabled(package_replay.repo_id)) {
+            settings_per_package.set_to_repo_ids({package_replay.repo_id});
         }
 
         if (package_replay.action == transaction::TransactionItemAction::UPGRADE ||
             package_replay.action == transaction::TransactionItemAction::INSTALL ||
             package_replay.action == transaction::TransactionItemAction::DOWNGRADE) {
-            if (query_nevra.empty()) {
+            if (packages_nevra.empty()) {
                 auto problem = transaction.p_impl->report_not_found(
                     GoalAction::REPLAY_INSTALL,
                     package_replay.nevra,
@@ -913,28 +979,22 @@ GoalProblem Goal::Impl::add_replay_to_goal(
             //   based on the transaction packages but check seems easier.
             if (package_replay.action == transaction::TransactionItemAction::INSTALL) {
                 bool na_has_outbound_action = false;
-                query_na.filter_installed();
-                for (const auto & installed_na : query_na) {
-                    na_has_outbound_action |=
-                        std::find_if(replay.packages.begin(), replay.packages.end(), [&installed_na](const auto & r) {
-                            return r.nevra == installed_na.get_nevra() && transaction_item_action_is_outbound(r.action);
-                        }) != replay.packages.end();
+                filter_installed(packages_na);
+                for (const auto & installed_na : packages_na) {
+                    na_has_outbound_action |= package_resolver.has_outbound_action(installed_na.get_nevra());
                     if (na_has_outbound_action) {
                         break;
                     }
                 }
                 if (!na_has_outbound_action) {
-                    auto is_installonly = query_na;
-                    is_installonly.filter_installonly();
-
-                    if (!query_na.empty() && is_installonly.empty()) {
-                        query_nevra.filter_installed();
+                    if (!packages_na.empty() && !package_resolver.contains_installed_installonly(packages_na)) {
+                        filter_installed(packages_nevra);
                         auto problem = GoalProblem::INSTALLED_IN_DIFFERENT_VERSION;
 
-                        if (!query_nevra.empty()) {
+                        if (!packages_nevra.empty()) {
                             problem = GoalProblem::ALREADY_INSTALLED;
                             if (settings.get_override_reasons()) {
-                                if ((*query_nevra.begin()).get_reason() != package_replay.reason) {
+                                if ((*packages_nevra.begin()).get_reason() != package_replay.reason) {
                                     rpm_reason_change_specs.push_back(std::make_tuple(
                                         package_replay.reason,
                                         package_replay.nevra,
@@ -956,7 +1016,7 @@ GoalProblem Goal::Impl::add_replay_to_goal(
                             settings,
                             libdnf5::transaction::TransactionItemType::PACKAGE,
                             package_replay.nevra,
-                            query_to_vec_of_nevra_str(query_na),
+                            packages_to_nevra_strs(packages_na),
                             log_level);
                         if (problem == GoalProblem::ALREADY_INSTALLED) {
                             continue;
@@ -972,7 +1032,7 @@ GoalProblem Goal::Impl::add_replay_to_goal(
             }
             transaction.p_impl->rpm_reason_overrides[package_replay.nevra] = package_replay.reason;
         } else if (package_replay.action == transaction::TransactionItemAction::REINSTALL) {
-            if (query_nevra.empty()) {
+            if (packages_nevra.empty()) {
                 auto problem = transaction.p_impl->report_not_found(
                     GoalAction::REPLAY_REINSTALL,
                     package_replay.nevra,
@@ -991,7 +1051,7 @@ GoalProblem Goal::Impl::add_replay_to_goal(
             }
             transaction.p_impl->rpm_reason_overrides[package_replay.nevra] = package_replay.reason;
         } else if (package_replay.action == transaction::TransactionItemAction::REMOVE) {
-            if (query_nevra.empty()) {
+            if (packages_nevra.empty()) {
                 auto problem = transaction.p_impl->report_not_found(
                     GoalAction::REPLAY_REMOVE,
                     package_replay.nevra,
@@ -1003,12 +1063,12 @@ GoalProblem Goal::Impl::add_replay_to_goal(
                 continue;
             }
 
-            query_nevra.filter_installed();
-            if (query_nevra.empty()) {
+            filter_installed(packages_nevra);
+            if (packages_nevra.empty()) {
                 auto log_level = libdnf5::Logger::Level::WARNING;
-                query_na.filter_installed();
+                filter_installed(packages_na);
                 auto problem =
-                    query_na.empty() ? GoalProblem::NOT_INSTALLED : GoalProblem::INSTALLED_IN_DIFFERENT_VERSION;
+                    packages_na.empty() ? GoalProblem::NOT_INSTALLED : GoalProblem::INSTALLED_IN_DIFFERENT_VERSION;
                 if (!settings.get_ignore_installed()) {
                     log_level = libdnf5::Logger::Level::ERROR;
                     ret |= problem;
@@ -1019,7 +1079,7 @@ GoalProblem Goal::Impl::add_replay_to_goal(
                     settings,
                     libdnf5::transaction::TransactionItemType::PACKAGE,
                     package_replay.nevra,
-                    query_to_vec_of_nevra_str(query_na),
+                    packages_to_nevra_strs(packages_na),
                     log_level);
                 continue;
             }
@@ -1031,7 +1091,7 @@ GoalProblem Goal::Impl::add_replay_to_goal(
             }
             transaction.p_impl->rpm_reason_overrides[package_replay.nevra] = package_replay.reason;
         } else if (package_replay.action == transaction::TransactionItemAction::REPLACED) {
-            if (query_nevra.empty()) {
+            if (packages_nevra.empty()) {
                 auto problem = transaction.p_impl->report_not_found(
                     GoalAction::REPLAY_REMOVE,
                     package_replay.nevra,
@@ -1043,12 +1103,12 @@ GoalProblem Goal::Impl::add_replay_to_goal(
                 continue;
             }
 
-            query_nevra.filter_installed();
-            if (query_nevra.empty()) {
+            filter_installed(packages_nevra);
+            if (packages_nevra.empty()) {
                 auto log_level = libdnf5::Logger::Level::WARNING;
-                query_na.filter_installed();
+                filter_installed(packages_na);
                 auto problem =
-                    query_na.empty() ? GoalProblem::NOT_INSTALLED : GoalProblem::INSTALLED_IN_DIFFERENT_VERSION;
+                    packages_na.empty() ? GoalProblem::NOT_INSTALLED : GoalProblem::INSTALLED_IN_DIFFERENT_VERSION;
                 if (!settings.get_ignore_installed()) {
                     log_level = libdnf5::Logger::Level::ERROR;
                     ret |= problem;
@@ -1059,7 +1119,7 @@ GoalProblem Goal::Impl::add_replay_to_goal(
                     settings,
                     libdnf5::transaction::TransactionItemType::PACKAGE,
                     package_replay.nevra,
-                    query_to_vec_of_nevra_str(query_na),
+                    packages_to_nevra_strs(packages_na),
                     log_level);
                 continue;
             }
@@ -1074,7 +1134,7 @@ GoalProblem Goal::Impl::add_replay_to_goal(
                 }
             }
         } else if (package_replay.action == transaction::TransactionItemAction::REASON_CHANGE) {
-            if (query_nevra.empty()) {
+            if (packages_nevra.empty()) {
                 auto problem = transaction.p_impl->report_not_found(
                     GoalAction::REPLAY_REASON_CHANGE,
                     package_replay.nevra,
@@ -1431,29 +1491,46 @@ GoalProblem Goal::Impl::add_reason_change_specs_to_goal(base::Transaction & tran
 
 std::pair<GoalProblem, libdnf5::solv::IdQueue> Goal::Impl::add_install_to_goal(
     base::Transaction & transaction, GoalAction action, const std::string & spec, GoalJobSettings & settings) {
-    auto sack = base->get_rpm_package_sack();
-    auto & pool = get_rpm_pool(base);
     auto & cfg_main = base->get_config();
     bool skip_unavailable = settings.resolve_skip_unavailable(cfg_main);
     auto log_level = skip_unavailable ? libdnf5::Logger::Level::WARNING : libdnf5::Logger::Level::ERROR;
-    bool best = settings.resolve_best(cfg_main);
-    bool clean_requirements_on_remove = settings.resolve_clean_requirements_on_remove();
 
-    auto multilib_policy = cfg_main.get_multilib_policy_option().get_value();
-    libdnf5::solv::IdQueue result_queue;
     rpm::PackageQuery base_query(base);
-
     rpm::PackageQuery query(base_query);
     auto nevra_pair = query.resolve_pkg_spec(spec, settings, false);
     if (!nevra_pair.first) {
         auto problem = transaction.p_impl->report_not_found(action, spec, settings, log_level);
         if (skip_unavailable) {
-            return {GoalProblem::NO_PROBLEM, result_queue};
+            return {GoalProblem::NO_PROBLEM, libdnf5::solv::IdQueue()};
         } else {
-            return {problem, result_queue};
+            return {problem, libdnf5::solv::IdQueue()};
         }
     }
 
+    return add_install_query_to_goal(transaction, action, spec, settings, base_query, query, nevra_pair.second);
+}
+
+std::pair<GoalProblem, libdnf5::solv::IdQueue> Goal::Impl::add_install_query_to_goal(
+    base::Transaction & transaction,
+    GoalAction action,
+    const std::string & spec,
+    GoalJobSettings & settings,
+    const rpm::PackageQuery & base_query,
+    rpm::PackageQuery & query,
+    const rpm::Nevra & nevra,
+    const rpm::PackageSet * installed_packages,
+    const std::vector<Id> * obsoleters) {
+    auto sack = base->get_rpm_package_sack();
+    auto & pool = get_rpm_pool(base);
+    auto & cfg_main = base->get_config();
+    bool skip_unavailable = settings.resolve_skip_unavailable(cfg_main);
+    auto log_level = skip_unavailable ? libdnf5::Logger::Level::WARNING : libdnf5::Logger::Level::ERROR;
+    bool best = settings.resolve_best(cfg_main);
+    bool clean_requirements_on_remove = settings.resolve_clean_requirements_on_remove();
+
+    auto multilib_policy = cfg_main.get_multilib_policy_option().get_value();
+    libdnf5::solv::IdQueue result_queue;
+
     const auto & to_vendors = settings.get_to_vendors();
 
     // The correct evaluation of rich dependencies can be only performed by solver.
@@ -1465,7 +1542,11 @@ std::pair<GoalProblem, libdnf5::solv::IdQueue> Goal::Impl::add_install_to_goal(
     }
 
     rpm::PackageQuery installed(query);
-    installed.filter_installed();
+    if (installed_packages != nullptr) {
+        installed &= *installed_packages;
+    } else {
+        installed.filter_installed();
+    }
 
     if (!settings.get_to_repo_ids().empty()) {
         query.filter_repo_id(settings.get_to_repo_ids(), sack::QueryCmp::GLOB);
@@ -1523,7 +1604,7 @@ std::pair<GoalProblem, libdnf5::solv::IdQueue> Goal::Impl::add_install_to_goal(
         query |= installed;
     }
 
-    bool has_just_name = nevra_pair.second.has_just_name();
+    bool has_just_name = nevra.has_just_name();
     bool add_obsoletes = cfg_main.get_obsoletes_option().get_value() && has_just_name;
 
     for (auto package_id : *installed.p_impl) {
@@ -1556,7 +1637,7 @@ std::pair<GoalProblem, libdnf5::solv::IdQueue> Goal::Impl::add_install_to_goal(
 
     bool skip_broken = settings.resolve_skip_broken(cfg_main);
 
-    if (multilib_policy == "all" || utils::is_glob_pattern(nevra_pair.second.get_arch().c_str())) {
+    if (multilib_policy == "all" || utils::is_glob_pattern(nevra.get_arch().c_str())) {
         // Apply advisory filters
         if (settings.get_advisory_filter() != nullptr) {
             query.filter_advisories(*settings.get_advisory_filter(), libdnf5::sack::QueryCmp::EQ);
@@ -1639,9 +1720,9 @@ std::pair<GoalProblem, libdnf5::solv::IdQueue> Goal::Impl::add_install_to_goal(
         // TODO(jmracek) Implement all logic for modules and comps groups
     } else if (multilib_policy == "best") {
         if ((!utils::is_file_pattern(spec) && utils::is_glob_pattern(spec.c_str())) ||
-            (nevra_pair.second.get_name().empty() &&
-             (!nevra_pair.second.get_epoch().empty() || !nevra_pair.second.get_version().empty() ||
-              !nevra_pair.second.get_release().empty() || !nevra_pair.second.get_arch().empty()))) {
+            (nevra.get_name().empty() &&
+             (!nevra.get_epoch().empty() || !nevra.get_version().empty() ||
+              !nevra.get_release().empty() || !nevra.get_arch().empty()))) {
             // Apply advisory filters
             if (settings.get_advisory_filter() != nullptr) {
                 query.filter_advisories(*settings.get_advisory_filter(), libdnf5::sack::QueryCmp::EQ);
@@ -1713,7 +1794,13 @@ std::pair<GoalProblem, libdnf5::solv::IdQueue> Goal::Impl::add_install_to_goal(
             rpm_goal.add_install(result_queue, skip_broken, best, clean_requirements_on_remove);
         } else {
             if (add_obsoletes) {
-                add_obsoletes_to_data(base_query, query);
+                if (obsoleters != nullptr) {
+                    for (Id obsoleter_id : *obsoleters) {
+                        query.p_impl->add_unsafe(obsoleter_id);
+                    }
+                } else {
+                    add_obsoletes_to_data(base_query, query);
+                }
             }
 
             // Apply advisory filters
@@ -2674,33 +2761,148 @@ GoalProblem Goal::Impl::add_up_down_distrosync_to_goal(
     return GoalProblem::NO_PROBLEM;
 }
 
-void Goal::Impl::install_group_package(base::Transaction & transaction, libdnf5::comps::Package pkg) {
+void Goal::Impl::install_group_packages(
+    base::Transaction & transaction, const std::vector<libdnf5::comps::Package> & group_packages) {
+    if (group_packages.empty()) {
+        return;
+    }
+
+    auto & pool = get_rpm_pool(base);
     auto pkg_settings = GoalJobSettings();
     pkg_settings.set_with_provides(false);
     pkg_settings.set_with_filenames(false);
     pkg_settings.set_with_binaries(false);
     pkg_settings.set_nevra_forms({rpm::Nevra::Form::NAME});
 
-    // TODO(mblaha): apply pkg.basearchonly when available in comps
-    auto pkg_name = pkg.get_name();
-    auto pkg_condition = pkg.get_condition();
-    if (pkg_condition.empty()) {
-        auto [pkg_problem, pkg_queue] =
-            // TODO(mblaha): add_install_to_goal needs group spec for better problems reporting
-            add_install_to_goal(transaction, GoalAction::INSTALL_BY_COMPS, pkg_name, pkg_settings);
-        rpm_goal.add_transaction_group_reason(pkg_queue);
-    } else {
-        // check whether condition can even be met
-        rpm::PackageQuery condition_query(base);
-        condition_query.filter_name(std::vector<std::string>{pkg_condition});
-        if (!condition_query.empty()) {
-            // remember names to identify GROUP reason of conditional packages
-            rpm::PackageQuery query(base);
-            query.filter_name(std::vector<std::string>{pkg_name});
-            // TODO(mblaha): log absence of pkg in case the query is empty
-            if (!query.empty()) {
-                add_provide_install_to_goal(fmt::format("({} if {})", pkg_name, pkg_condition), pkg_settings);
-                rpm_goal.add_transaction_group_reason(*query.p_impl);
+    // Resolve names of all group packages and conditions in one pass over the packages
+    // instead of running a name query for each of them.
+    std::unordered_map<Id, std::vector<Id>> name_index;
+    for (const auto & pkg : group_packages) {
+        for (const auto & name : {pkg.get_name(), pkg.get_condition()}) {
+            if (Id name_id = name.empty() ? 0 : pool.str2id(name.c_str(), false); name_id != 0) {
+                name_index.try_emplace(name_id);
+            }
+        }
+    }
+    rpm::PackageQuery base_query(base);
+    for (Id id : *base_query.p_impl) {
+        if (auto it = name_index.find(pool.id2solvable(id)->name); it != name_index.end()) {
+            it->second.push_back(id);
+        }
+    }
+    auto find_by_name = [&pool, &name_index](const std::string & name) -> const std::vector<Id> * {
+        auto it = name_index.find(pool.str2id(name.c_str(), false));
+        return it == name_index.end() || it->second.empty() ? nullptr : &it->second;
+    };
+    auto is_plain_name = [](const std::string & name) {
+        return !libdnf5::rpm::Reldep::is_rich_dependency(name) && !utils::is_glob_pattern(name.c_str());
+    };
+    auto is_source = [&pool](Id id) {
+        auto arch = pool.id2solvable(id)->arch;
+        return arch == ARCH_SRC || arch == ARCH_NOSRC;
+    };
+
+    rpm::PackageQuery installed_packages(base_query);
+    installed_packages.filter_installed();
+    rpm::PackageQuery empty_query(base_query);
+    empty_query.clear();
+
+    // Look up the obsoleters of all group packages with one filter_obsoletes() over their union and split them
+    // by name. The obsoleted packages are the same as add_obsoletes_to_data() uses for each name separately:
+    // all packages of a name with an installed package, the latest packages of the highest priority otherwise.
+    const auto & cfg_main = base->get_config();
+    const bool obsoleters_by_name_used =
+        cfg_main.get_obsoletes_option().get_value() && cfg_main.get_multilib_policy_option().get_value() == "best";
+    std::unordered_map<Id, std::vector<Id>> obsoleters_by_name;
+    if (obsoleters_by_name_used) {
+        rpm::PackageQuery installed_names_data(empty_query);
+        rpm::PackageQuery latest_data(empty_query);
+        for (const auto & pkg : group_packages) {
+            const auto * ids = pkg.get_condition().empty() && is_plain_name(pkg.get_name())
+                                   ? find_by_name(pkg.get_name())
+                                   : nullptr;
+            if (ids == nullptr) {
+                continue;
+            }
+            bool has_installed =
+                std::any_of(ids->begin(), ids->end(), [&](Id id) { return installed_packages.p_impl->contains(id); });
+            auto & data = has_installed ? installed_names_data : latest_data;
+            for (Id id : *ids) {
+                if (!is_source(id)) {
+                    data.p_impl->add_unsafe(id);
+                }
+            }
+        }
+        latest_data.filter_priority();
+        latest_data.filter_latest_evr();
+        installed_names_data |= latest_data;
+
+        rpm::PackageQuery obsoleters(base_query);
+        obsoleters.filter_obsoletes(installed_names_data);
+        obsoleters_by_name = split_obsoleters_by_name(obsoleters, *installed_names_data.p_impl);
+    }
+    const std::vector<Id> no_obsoleters;
+
+    for (const auto & pkg : group_packages) {
+        // TODO(mblaha): apply pkg.basearchonly when available in comps
+        auto pkg_name = pkg.get_name();
+        auto pkg_condition = pkg.get_condition();
+        if (pkg_condition.empty()) {
+            // Specs that are not a plain name are resolved the same way as user specs
+            if (!is_plain_name(pkg_name)) {
+                auto [pkg_problem, pkg_queue] =
+                    add_install_to_goal(transaction, GoalAction::INSTALL_BY_COMPS, pkg_name, pkg_settings);
+                rpm_goal.add_transaction_group_reason(pkg_queue);
+                continue;
+            }
+            // the same packages as resolve_pkg_spec() matches for the NAME form, source packages are skipped
+            rpm::PackageQuery query(empty_query);
+            if (const auto * ids = find_by_name(pkg_name)) {
+                for (Id id : *ids) {
+                    if (!is_source(id)) {
+                        query.p_impl->add_unsafe(id);
+                    }
+                }
+            }
+            if (query.empty()) {
+                // TODO(mblaha): add_install_to_goal needs group spec for better problems reporting
+                auto log_level = pkg_settings.resolve_skip_unavailable(base->get_config())
+                                     ? libdnf5::Logger::Level::WARNING
+                                     : libdnf5::Logger::Level::ERROR;
+                transaction.p_impl->report_not_found(GoalAction::INSTALL_BY_COMPS, pkg_name, pkg_settings, log_level);
+                continue;
+            }
+            rpm::Nevra nevra;
+            nevra.set_name(pkg_name);
+            const std::vector<Id> * obsoleters = nullptr;
+            if (obsoleters_by_name_used) {
+                auto it = obsoleters_by_name.find(pool.id2solvable(*query.p_impl->begin())->name);
+                obsoleters = it == obsoleters_by_name.end() ? &no_obsoleters : &it->second;
+            }
+            auto [pkg_problem, pkg_queue] = add_install_query_to_goal(
+                transaction,
+                GoalAction::INSTALL_BY_COMPS,
+                pkg_name,
+                pkg_settings,
+                base_query,
+                query,
+                nevra,
+                &installed_packages,
+                obsoleters);
+            rpm_goal.add_transaction_group_reason(pkg_queue);
+        } else {
+            // check whether condition can even be met
+            if (find_by_name(pkg_condition) != nullptr) {
+                // remember names to identify GROUP reason of conditional packages
+                // TODO(mblaha): log absence of pkg in case the query is empty
+                if (const auto * ids = find_by_name(pkg_name)) {
+                    add_provide_install_to_goal(fmt::format("({} if {})", pkg_name, pkg_condition), pkg_settings);
+                    libdnf5::solv::IdQueue pkg_queue;
+                    for (Id id : *ids) {
+                        pkg_queue.push_back(id);
+                    }
+                    rpm_goal.add_transaction_group_reason(pkg_queue);
+                }
             }
         }
     }
@@ -2724,13 +2926,57 @@ void Goal::Impl::remove_group_packages(const rpm::PackageSet & remove_candidates
 
     // The second step of packages removal - filter out packages that are
     // dependencies of a package that is not also being removed.
+    // A candidate is required if one of its provides, without the file provides, matches a requirement
+    // of a remaining installed package, the same as `filter_requires(candidate.get_provides())`.
+    // Each distinct requirement is looked up only once. The whatprovides index also contains the file
+    // provides, so the providers found in it are checked against their provides. Rich requirements are
+    // matched against the candidates directly, the index combines their providers differently
+    // (e.g. `(a with b)` is provided only by packages providing both).
+    auto & pool = get_rpm_pool(base);
+    base->get_rpm_package_sack()->p_impl->make_provides_ready();
+    libdnf5::solv::SolvMap candidates(pool.get_nsolvables());
+    for (const auto & pkg : remove_candidates) {
+        candidates.add_unsafe(pkg.get_id().id);
+    }
+    libdnf5::solv::SolvMap required(pool.get_nsolvables());
+    auto matches_provides = [&pool](Id candidate_id, Id require) {
+        libdnf5::solv::IdQueue provides;
+        solvable_lookup_deparray(pool.id2solvable(candidate_id), SOLVABLE_PROVIDES, &provides.get_queue(), -1);
+        return std::any_of(provides.begin(), provides.end(), [&pool, require](Id provide) {
+            return pool_match_dep(*pool, provide, require) != 0;
+        });
+    };
+    std::unordered_set<Id> visited_requires;
+    libdnf5::solv::IdQueue dependent_requires;
+    for (Id dependent_id : *dependent_base.p_impl) {
+        dependent_requires.clear();
+        solvable_lookup_idarray(pool.id2solvable(dependent_id), SOLVABLE_REQUIRES, &dependent_requires.get_queue());
+        for (Id require : dependent_requires) {
+            if (require == SOLVABLE_PREREQMARKER || !visited_requires.insert(require).second) {
+                continue;
+            }
+            if (!pool.is_simple_dep(require)) {
+                for (Id candidate_id : candidates) {
+                    if (!required.contains_unsafe(candidate_id) && matches_provides(candidate_id, require)) {
+                        required.add_unsafe(candidate_id);
+                    }
+                }
+                continue;
+            }
+            for (Id * provider = pool_whatprovides_ptr(*pool, require); *provider != 0; ++provider) {
+                if (candidates.contains_unsafe(*provider) && !required.contains_unsafe(*provider) &&
+                    matches_provides(*provider, require)) {
+                    required.add_unsafe(*provider);
+                }
+            }
+        }
+    }
+
     libdnf5::solv::IdQueue packages_to_remove_ids;
     for (const auto & pkg : remove_candidates) {
         // if the package is required by another installed package, it is
         // not removed, but it's reason is changed to DEPENDENCY
-        rpm::PackageQuery dependent(dependent_base);
-        dependent.filter_requires(pkg.get_provides());
-        if (dependent.size() > 0) {
+        if (required.contains_unsafe(pkg.get_id().id)) {
             rpm_goal.add_reason_change(pkg, transaction::TransactionItemReason::DEPENDENCY, std::nullopt);
         } else {
             packages_to_remove_ids.push_back(pkg.get_id().id);
@@ -2749,6 +2995,8 @@ void Goal::Impl::add_group_install_to_goal(
     GoalJobSettings & settings) {
     auto & cfg_main = base->get_config();
     auto allowed_package_types = settings.resolve_group_package_types(cfg_main);
+    // packages of all groups are resolved together in install_group_packages()
+    std::vector<libdnf5::comps::Package> packages;
     for (auto group : group_query) {
         comps::GroupQuery installed_group = comps::GroupQuery(base, false);
         installed_group.filter_groupid(group.get_groupid());
@@ -2773,17 +3021,14 @@ void Goal::Impl::add_group_install_to_goal(
         if (settings.get_group_no_packages()) {
             continue;
         }
-        std::vector<libdnf5::comps::Package> packages;
         // TODO(mblaha): filter packages by p.arch attribute when supported by comps
         for (const auto & p : group.get_packages()) {
             if (any(allowed_package_types & p.get_type())) {
                 packages.emplace_back(std::move(p));
             }
         }
-        for (const auto & pkg : packages) {
-            install_group_package(transaction, pkg);
-        }
     }
+    install_group_packages(transaction, packages);
 }
 
 void Goal::Impl::add_group_remove_to_goal(
@@ -2851,6 +3096,8 @@ void Goal::Impl::add_group_upgrade_to_goal(
     comps::GroupQuery available_groups(base);
     available_groups.filter_installed(false);
 
+    // packages newly added to the upgraded groups, they are resolved together in install_group_packages()
+    std::vector<libdnf5::comps::Package> packages_to_install;
     for (auto installed_group : group_query) {
         auto group_id = installed_group.get_groupid();
         // find available group of the same id
@@ -2899,7 +3146,7 @@ void Goal::Impl::add_group_upgrade_to_goal(
         // install packages newly added to the group
         for (const auto & pkg : available_group.get_packages_of_type(state_group.package_types)) {
             if (!old_set.contains(pkg.get_name())) {
-                install_group_package(transaction, pkg);
+                packages_to_install.push_back(pkg);
             }
         }
 
@@ -2916,6 +3163,7 @@ void Goal::Impl::add_group_upgrade_to_goal(
             add_up_down_distrosync_to_goal(transaction, GoalAction::UPGRADE, pkg.get_name(), pkg_settings);
         }
     }
+    install_group_packages(transaction, packages_to_install);
 }
 
 void Goal::Impl::add_environment_install_to_goal(
@@ -3467,6 +3715,8 @@ bool Goal::get_allow_erasing() const {
 base::Transaction Goal::resolve() {
     libdnf_user_assert(p_impl->base->is_initialized(), "Base instance was not fully initialized by Base::setup()");
 
+    base::Tracer::Scope trace(p_impl->base->get_tracer(), "resolve");
+
     p_impl->rpm_goal = rpm::solv::GoalPrivate(p_impl->base);
 
     base::Transaction transaction(p_impl->base);
@@ -3565,11 +3815,10 @@ base::Transaction Goal::resolve() {
     // proceed only if the transaction could result in removal of unused dependencies
     if (p_impl->rpm_goal.is_clean_deps_present()) {
         libdnf5::solv::IdQueue user_installed_packages;
-        rpm::PackageQuery installed_query(p_impl->base, rpm::PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
-        installed_query.filter_installed();
-        for (const auto & pkg : installed_query) {
-            if (pkg.get_reason() > transaction::TransactionItemReason::DEPENDENCY) {
-                user_installed_packages.push_back(pkg.get_id().id);
+        auto reasons = sack->p_impl->get_installed_reasons();
+        for (size_t id = 0; id < reasons.size(); ++id) {
+            if (reasons[id] > transaction::TransactionItemReason::DEPENDENCY) {
+                user_installed_packages.push_back(static_cast<Id>(id));
             }
         }
         p_impl->rpm_goal.set_user_installed_packages(std::move(user_installed_packages));
@@ -3602,7 +3851,10 @@ base::Transaction Goal::resolve() {
     pool.get_incoming_vendor_bypassed_solvables() = p_impl->incoming_vendor_bypassed_solvables;
     pool.clear_blocked_vendor_changes();
 
-    ret |= p_impl->rpm_goal.resolve();
+    {
+        base::Tracer::Scope trace_solve(p_impl->base->get_tracer(), "solve");
+        ret |= p_impl->rpm_goal.resolve();
+    }
 
     // Write debug solver data
     // Note: Modules debug data are handled separately when resolving module goal in ModuleSack::Impl::module_solve()
@@ -0,0 +1,154 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "libdnf5/base/tracer.hpp"
+
+#include "libdnf5/utils/fs/file.hpp"
+
+#include <json.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+
+namespace libdnf5::base {
+
+namespace {
+
+// Nesting level of the currently open spans in the calling thread.
+thread_local std::uint32_t current_depth{0};
+
+}  // namespace
+
+
+class Tracer::Impl {
+public:
+    std::uint32_t get_thread_index() {
+        auto [it, inserted] =
+            thread_indexes.try_emplace(std::this_thread::get_id(), static_cast<std::uint32_t>(thread_indexes.size()));
+        return it->second;
+    }
+
+    std::mutex mutex;
+    std::chrono::steady_clock::time_point origin{std::chrono::steady_clock::now()};
+    std::vector<TraceSpan> spans;
+    std::unordered_map<std::thread::id, std::uint32_t> thread_indexes;
+};
+
+
+void Tracer::Scope::start() {
+    ++current_depth;
+    start_time = std::chrono::steady_clock::now();
+}
+
+
+void Tracer::Scope::finish() noexcept {
+    const auto end_time = std::chrono::steady_clock::now();
+    --current_depth;
+    try {
+        std::lock_guard<std::mutex> lock(tracer->p_impl->mutex);
+        auto & impl = *tracer->p_impl;
+        impl.spans.push_back(
+            {name,
+             std::move(detail),
+             std::chrono::duration_cast<std::chrono::microseconds>(start_time - impl.origin).count(),
+             std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count(),
+             current_depth,
+             impl.get_thread_index()});
+    } catch (...) {
+        // Tracing is best-effort, a failure to record a span must not break the traced code.
+    }
+}
+
+
+Tracer::Tracer() : p_impl(new Impl) {}
+
+Tracer::~Tracer() = default;
+
+
+void Tracer::set_enabled(bool enabled) {
+    if (enabled && !is_enabled()) {
+        std::lock_guard<std::mutex> lock(p_impl->mutex);
+        p_impl->origin = std::chrono::steady_clock::now();
+    }
+    this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+
+std::vector<TraceSpan> Tracer::get_spans() const {
+    std::vector<TraceSpan> spans;
+    {
+        std::lock_guard<std::mutex> lock(p_impl->mutex);
+        spans = p_impl->spans;
+    }
+    // Spans are recorded when they finish, an enclosing span is recorded after the nested ones.
+    std::stable_sort(spans.begin(), spans.end(), [](const TraceSpan & lhs, const TraceSpan & rhs) {
+        if (lhs.start_us != rhs.start_us) {
+            return lhs.start_us < rhs.start_us;
+        }
+        return lhs.depth < rhs.depth;
+    });
+    return spans;
+}
+
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(p_impl->mutex);
+    p_impl->spans.clear();
+}
+
+
+void Tracer::write_chrome_trace(const std::string & path) const {
+    const auto pid = static_cast<int32_t>(getpid());
+
+    auto * events = json_object_new_array();
+    for (const auto & span : get_spans()) {
+        auto * event = json_object_new_object();
+        json_object_object_add(event, "name", json_object_new_string(span.name.c_str()));
+        json_object_object_add(event, "cat", json_object_new_string("libdnf5"));
+        json_object_object_add(event, "ph", json_object_new_string("X"));
+        json_object_object_add(event, "ts", json_object_new_int64(span.start_us));
+        json_object_object_add(event, "dur", json_object_new_int64(span.duration_us));
+        json_object_object_add(event, "pid", json_object_new_int(pid));
+        json_object_object_add(event, "tid", json_object_new_int(static_cast<int32_t>(span.thread_index)));
+        if (!span.detail.empty()) {
+            auto * args = json_object_new_object();
+            json_object_object_add(args, "detail", json_object_new_string(span.detail.c_str()));
+            json_object_object_add(event, "args", args);
+        }
+        json_object_array_add(events, event);
+    }
+    auto * root = json_object_new_object();
+    json_object_object_add(root, "traceEvents", events);
+    json_object_object_add(root, "displayTimeUnit", json_object_new_string("ms"));
+
+    std::string json(json_object_to_json_string_ext(root, JSON_C_TO_STRING_PLAIN));
+    json_object_put(root);
+
+    utils::fs::File file(path, "w");
+    file.write(json);
+    file.write("\n");
+    file.close();
+}
+
+}  // namespace libdnf5::base
@@ -28,6 +28,7 @@
 
 #include <regex>
 #include <stdexcept>
+#include <string_view>
 
 // TODO: Implement proper FNM_EXTMATCH support to fix MUSL errors.
 #if !defined(FNM_EXTMATCH)
@@ -36,97 +37,223 @@
 
 namespace libdnf5::sack {
 
+namespace {
+
+// Characters with a special meaning in fnmatch patterns (including the FNM_EXTMATCH ones)
+constexpr const char * GLOB_SPECIAL_CHARS = "*?[\\(";
+
+bool is_glob_literal(std::string_view pattern) {
+    return pattern.find_first_of(GLOB_SPECIAL_CHARS) == std::string_view::npos;
+}
+
+}  // namespace
+
+
+class StringMatcher::Impl {
+public:
+    Impl(QueryCmp cmp, const std::vector<std::string> & patterns);
+
+    bool match(const std::string & value) const;
+
+private:
+    friend StringMatcher;
+
+    enum class Method { EXACT, CONTAINS, STARTSWITH, ENDSWITH, GLOB, REGEX };
+
+    struct Pattern {
+        Method method;
+        std::string text;
+        // compare the lowercased value, the text is already lowercased
+        bool lowercase{false};
+        int fnmatch_flags{0};
+        std::regex regex{};
+    };
+
+    void add_pattern(QueryCmp cmp, const std::string & pattern);
+    void add_glob(const std::string & pattern, bool icase);
+
+    bool negate;
+    std::vector<Pattern> patterns;
+};
+
+
+StringMatcher::Impl::Impl(QueryCmp cmp, const std::vector<std::string> & patterns)
+    : negate((cmp & QueryCmp::NOT) == QueryCmp::NOT) {
+    this->patterns.reserve(patterns.size());
+    for (const auto & pattern : patterns) {
+        add_pattern(cmp - QueryCmp::NOT, pattern);
+    }
+    if (patterns.empty()) {
+        // validate the comparison type even if there is nothing to compile
+        add_pattern(cmp - QueryCmp::NOT, "");
+        this->patterns.clear();
+    }
+}
 
-bool match_string(const std::string & value, QueryCmp cmp, const std::string & pattern) {
-    bool result = false;
 
-    switch (cmp - QueryCmp::NOT) {
+void StringMatcher::Impl::add_pattern(QueryCmp cmp, const std::string & pattern) {
+    using libdnf5::utils::string::tolower;
+
+    switch (cmp) {
         case QueryCmp::EXACT:
-            result = value == pattern;
+            patterns.push_back({.method = Method::EXACT, .text = pattern});
             break;
         case QueryCmp::IEXACT:
-            result = libdnf5::utils::string::tolower(value) == libdnf5::utils::string::tolower(pattern);
+            patterns.push_back({.method = Method::EXACT, .text = tolower(pattern), .lowercase = true});
             break;
         case QueryCmp::GLOB:
-            result = fnmatch(pattern.c_str(), value.c_str(), FNM_EXTMATCH) == 0;
+            add_glob(pattern, false);
             break;
         case QueryCmp::IGLOB:
-            result = fnmatch(pattern.c_str(), value.c_str(), FNM_CASEFOLD | FNM_EXTMATCH) == 0;
+            add_glob(pattern, true);
             break;
         case QueryCmp::REGEX:
-            result = std::regex_match(value, std::regex(pattern));
+            patterns.push_back({.method = Method::REGEX, .text = pattern, .regex = std::regex(pattern)});
             break;
         case QueryCmp::IREGEX:
-            result = std::regex_match(value, std::regex(pattern, std::regex::icase));
+            patterns.push_back(
+                {.method = Method::REGEX, .text = pattern, .regex = std::regex(pattern, std::regex::icase)});
             break;
         case QueryCmp::CONTAINS:
-            result = value.find(pattern) != std::string::npos;
+            patterns.push_back({.method = Method::CONTAINS, .text = pattern});
             break;
         case QueryCmp::ICONTAINS:
-            result = libdnf5::utils::string::tolower(value).find(libdnf5::utils::string::tolower(pattern)) !=
-                     std::string::npos;
+            patterns.push_back({.method = Method::CONTAINS, .text = tolower(pattern), .lowercase = true});
             break;
         case QueryCmp::STARTSWITH:
-            result = libdnf5::utils::string::starts_with(value, pattern);
+            patterns.push_back({.method = Method::STARTSWITH, .text = pattern});
             break;
         case QueryCmp::ISTARTSWITH:
-            result = libdnf5::utils::string::starts_with(
-                libdnf5::utils::string::tolower(value), libdnf5::utils::string::tolower(pattern));
+            patterns.push_back({.method = Method::STARTSWITH, .text = tolower(pattern), .lowercase = true});
             break;
         case QueryCmp::ENDSWITH:
-            result = libdnf5::utils::string::ends_with(value, pattern);
+            patterns.push_back({.method = Method::ENDSWITH, .text = pattern});
             break;
         case QueryCmp::IENDSWITH:
-            result = libdnf5::utils::string::ends_with(
-                libdnf5::utils::string::tolower(value), libdnf5::utils::string::tolower(pattern));
+            patterns.push_back({.method = Method::ENDSWITH, .text = tolower(pattern), .lowercase = true});
             break;
         default:
-            libdnf_assert(cmp - QueryCmp::NOT - QueryCmp::ICASE, "NOT and ICASE modifiers cannot be used standalone");
+            libdnf_assert(cmp - QueryCmp::ICASE, "NOT and ICASE modifiers cannot be used standalone");
             libdnf_throw_assert_unsupported_query_cmp_type(cmp);
     }
+}
+
+
+void StringMatcher::Impl::add_glob(const std::string & pattern, bool icase) {
+    using libdnf5::utils::string::tolower;
+
+    // Globs without wildcards and globs with a single trailing '*' are matched without fnmatch
+    if (is_glob_literal(pattern)) {
+        patterns.push_back({.method = Method::EXACT, .text = icase ? tolower(pattern) : pattern, .lowercase = icase});
+    } else if (
+        pattern.back() == '*' && is_glob_literal(std::string_view(pattern).substr(0, pattern.size() - 1))) {
+        auto prefix = pattern.substr(0, pattern.size() - 1);
+        patterns.push_back(
+            {.method = Method::STARTSWITH, .text = icase ? tolower(prefix) : prefix, .lowercase = icase});
+    } else {
+        patterns.push_back(
+            {.method = Method::GLOB,
+             .text = pattern,
+             .fnmatch_flags = icase ? FNM_CASEFOLD | FNM_EXTMATCH : FNM_EXTMATCH});
+    }
+}
+
+
+bool StringMatcher::Impl::match(const std::string & value) const {
+    // the lowercased value is computed only once and only if some pattern needs it
+    std::string lowercased;
+    bool lowercased_valid{false};
+
+    for (const auto & pattern : patterns) {
+        const std::string * subject = &value;
+        if (pattern.lowercase) {
+            if (!lowercased_valid) {
+                lowercased = libdnf5::utils::string::tolower(value);
+                lowercased_valid = true;
+            }
+            subject = &lowercased;
+        }
+
+        bool result = false;
+        switch (pattern.method) {
+            case Method::EXACT:
+                result = *subject == pattern.text;
+                break;
+            case Method::CONTAINS:
+                result = subject->find(pattern.text) != std::string::npos;
+                break;
+            case Method::STARTSWITH:
+                result = subject->starts_with(pattern.text);
+                break;
+            case Method::ENDSWITH:
+                result = subject->ends_with(pattern.text);
+                break;
+            case Method::GLOB:
+                result = fnmatch(pattern.text.c_str(), subject->c_str(), pattern.fnmatch_flags) == 0;
+                break;
+            case Method::REGEX:
+                result = std::regex_match(*subject, pattern.regex);
+                break;
+        }
+        if (result) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+StringMatcher::StringMatcher(QueryCmp cmp, const std::string & pattern)
+    : StringMatcher(cmp, std::vector<std::string>{pattern}) {}
+
+StringMatcher::StringMatcher(QueryCmp cmp, const std::vector<std::string> & patterns)
+    : p_impl(new Impl(cmp, patterns)) {}
+
+StringMatcher::StringMatcher(const StringMatcher & src) = default;
+StringMatcher::StringMatcher(StringMatcher && src) noexcept = default;
+StringMatcher & StringMatcher::operator=(const StringMatcher & src) = default;
+StringMatcher & StringMatcher::operator=(StringMatcher && src) noexcept = default;
+StringMatcher::~StringMatcher() = default;
+
+
+bool StringMatcher::match(const std::string & value) const {
+    return p_impl->match(value) != p_impl->negate;
+}
+
+
+bool StringMatcher::match(const std::vector<std::string> & values) const {
+    for (const auto & value : values) {
+        if (p_impl->match(value)) {
+            return !p_impl->negate;
+        }
+    }
+    return p_impl->negate;
+}
+
 
-    return static_cast<bool>(cmp & QueryCmp::NOT) ? !result : result;
+bool match_string(const std::string & value, QueryCmp cmp, const std::string & pattern) {
+    return StringMatcher(cmp, pattern).match(value);
 }
 
 
 // cmp is positive: return true if the value matches at least one of patterns
 // cmp is negative: return true if value doesn't match any of patterns
 bool match_string(const std::string & value, QueryCmp cmp, const std::vector<std::string> & patterns) {
-    bool result = (cmp & libdnf5::sack::QueryCmp::NOT) == libdnf5::sack::QueryCmp::NOT;
-    for (auto & pattern : patterns) {
-        if (match_string(value, cmp, pattern) != result) {
-            return !result;
-        }
-    }
-    return result;
+    return StringMatcher(cmp, patterns).match(value);
 }
 
 
 // cmp is positive: return true if at least one of the values matches the pattern
 // cmp is negative: return true if neither of the values matches the pattern
 bool match_string(const std::vector<std::string> & values, QueryCmp cmp, const std::string & pattern) {
-    bool result = (cmp & libdnf5::sack::QueryCmp::NOT) == libdnf5::sack::QueryCmp::NOT;
-    for (auto & value : values) {
-        if (match_string(value, cmp, pattern) != result) {
-            return !result;
-        }
-    }
-    return result;
+    return StringMatcher(cmp, pattern).match(values);
 }
 
 
 // cmp is positive: return true if at least one of the values matches at least one of the patterns
 // cmp is negative: return true if none of the values matches none of the patterns
 bool match_string(const std::vector<std::string> & values, QueryCmp cmp, const std::vector<std::string> & patterns) {
-    bool result = (cmp & libdnf5::sack::QueryCmp::NOT) == libdnf5::sack::QueryCmp::NOT;
-    for (auto & value : values) {
-        for (auto & pattern : patterns) {
-            if (match_string(value, cmp, pattern) != result) {
-                return !result;
-            }
-        }
-    }
-    return result;
+    return StringMatcher(cmp, patterns).match(values);
 }
 
 
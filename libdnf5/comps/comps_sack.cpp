@@ -20,11 +20,162 @@
 #include "libdnf5/comps/comps_sack.hpp"
 
 #include "comps_sack_impl.hpp"
+#include "solv/pool.hpp"
 
 #include "libdnf5/comps/group/query.hpp"
 
+extern "C" {
+#include <solv/pool.h>
+#include <solv/repo.h>
+}
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
 namespace libdnf5::comps {
 
+void CompsSack::Impl::update_index() {
+    if (index_valid) {
+        return;
+    }
+
+    libdnf5::solv::CompsPool & pool = get_comps_pool(base);
+    group_index.clear();
+    environment_index.clear();
+    group_packages.clear();
+
+    constexpr std::string_view group_prefix = "group:";
+    constexpr std::string_view environment_prefix = "environment:";
+
+    // For each group and environment id collect the (repoid, solvable_id) pairs of its available definitions
+    std::map<std::string, std::vector<std::pair<std::string_view, Id>>> available_groups;
+    std::map<std::string, std::vector<std::pair<std::string_view, Id>>> available_environments;
+    Id solvable_id;
+    FOR_POOL_SOLVABLES(solvable_id) {
+        Solvable * solvable = pool.id2solvable(solvable_id);
+        // SOLVABLE_NAME is in a form "type:id"
+        std::string_view solvable_name = pool.id2str(solvable->name);
+        CompsIndex * index;
+        std::map<std::string, std::vector<std::pair<std::string_view, Id>>> * available;
+        std::string id;
+        if (solvable_name.starts_with(group_prefix)) {
+            index = &group_index;
+            available = &available_groups;
+            id = solvable_name.substr(group_prefix.size());
+        } else if (solvable_name.starts_with(environment_prefix)) {
+            index = &environment_index;
+            available = &available_environments;
+            id = solvable_name.substr(environment_prefix.size());
+        } else {
+            continue;
+        }
+
+        std::string_view repoid = solvable->repo->name;
+        if (repoid == "@System") {
+            (*index)[id].installed.push_back(solvable_id);
+        } else {
+            (*available)[id].emplace_back(repoid, solvable_id);
+        }
+    }
+
+    for (auto [index, available] :
+         {std::make_pair(&group_index, &available_groups), std::make_pair(&environment_index, &available_environments)}) {
+        for (auto & [id, definitions] : *available) {
+            // Sort the (repoid, solvable_id) pairs by repoid
+            std::sort(definitions.begin(), definitions.end(), std::greater<>());
+            auto & item_available = (*index)[id].available;
+            item_available.reserve(definitions.size());
+            for (const auto & definition : definitions) {
+                item_available.push_back(definition.second);
+            }
+        }
+    }
+
+    index_valid = true;
+}
+
+void CompsSack::Impl::invalidate_index() {
+    index_valid = false;
+    group_index.clear();
+    environment_index.clear();
+    group_packages.clear();
+}
+
+const CompsSack::Impl::CompsIndex & CompsSack::Impl::get_group_index() {
+    update_index();
+    return group_index;
+}
+
+const CompsSack::Impl::CompsIndex & CompsSack::Impl::get_environment_index() {
+    update_index();
+    return environment_index;
+}
+
+const std::vector<Package> & CompsSack::Impl::get_group_packages(const std::vector<GroupId> & group_ids) {
+    update_index();
+
+    std::vector<int> solvable_ids;
+    solvable_ids.reserve(group_ids.size());
+    for (const auto & group_id : group_ids) {
+        solvable_ids.push_back(group_id.id);
+    }
+    auto [it, inserted] = group_packages.try_emplace(std::move(solvable_ids));
+    if (!inserted) {
+        return it->second;
+    }
+
+    libdnf5::solv::CompsPool & pool = get_comps_pool(base);
+    auto & packages = it->second;
+
+    // The same package can be listed by more definitions of the group, the pool Ids identify it
+    std::unordered_set<Id> package_ids_mandatory;
+    std::unordered_set<Id> package_ids_default;
+    std::unordered_set<Id> package_ids_conditional;
+    std::unordered_set<Id> package_ids_optional;
+
+    for (auto group_id : group_ids) {
+        Solvable * solvable = pool.id2solvable(group_id.id);
+
+        // Load MANDATORY packages from solvable->requires
+        if (solvable->dep_requires) {
+            for (Id * r_id = solvable->repo->idarraydata + solvable->dep_requires; *r_id; ++r_id) {
+                const Id name_id = pool.dep2name(*r_id);
+                if (package_ids_mandatory.insert(name_id).second) {
+                    packages.emplace_back(pool.id2str(*r_id), PackageType::MANDATORY, "");
+                }
+            }
+        }
+        // Load DEFAULT and CONDITIONAL packages from solvable->recommends
+        if (solvable->dep_recommends) {
+            for (Id * r_id = solvable->repo->idarraydata + solvable->dep_recommends; *r_id; ++r_id) {
+                if (strcmp(pool.id2rel(*r_id), "") == 0) {
+                    if (package_ids_default.insert(*r_id).second) {
+                        packages.emplace_back(pool.id2str(*r_id), PackageType::DEFAULT, "");
+                    }
+                } else {
+                    if (package_ids_conditional.insert(*r_id).second) {
+                        packages.emplace_back(pool.id2str(*r_id), PackageType::CONDITIONAL, pool.id2evr(*r_id));
+                    }
+                }
+            }
+        }
+        // Load OPTIONAL packages from solvable->suggests
+        if (solvable->dep_suggests) {
+            for (Id * r_id = solvable->repo->idarraydata + solvable->dep_suggests; *r_id; ++r_id) {
+                if (strcmp(pool.id2rel(*r_id), "") == 0) {
+                    if (package_ids_optional.insert(*r_id).second) {
+                        packages.emplace_back(pool.id2str(*r_id), PackageType::OPTIONAL, "");
+                    }
+                }
+            }
+        }
+    }
+    return packages;
+}
+
 void CompsSack::Impl::load_config_excludes() {
     const auto & main_config = base->get_config();
 
@@ -23,8 +23,14 @@
 #include "libdnf5/base/base.hpp"
 #include "libdnf5/comps/comps_sack.hpp"
 #include "libdnf5/comps/environment/query.hpp"
+#include "libdnf5/comps/group/package.hpp"
 #include "libdnf5/comps/group/query.hpp"
 
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
 namespace libdnf5::comps {
 
 
@@ -59,6 +65,32 @@ public:
     void set_user_group_excludes(const GroupQuery & excludes);
     void clear_user_group_excludes();
 
+    /// Solvables of one group or environment id in the comps pool.
+    struct CompsIndexItem {
+        // Solvables from the available repositories, ordered by repoids in descending order
+        // (the same order is used in Group and Environment objects, the preferred definition comes first)
+        std::vector<int> available;
+        // Solvables from the "@System" repository
+        std::vector<int> installed;
+    };
+    using CompsIndex = std::map<std::string, CompsIndexItem>;
+
+    /// Returns the index of groups, maps the groupid to its solvables.
+    /// The index is built by one pass over the comps pool and rebuilt only after it was invalidated.
+    const CompsIndex & get_group_index();
+
+    /// Returns the index of environments, maps the environmentid to its solvables.
+    /// The index is built by one pass over the comps pool and rebuilt only after it was invalidated.
+    const CompsIndex & get_environment_index();
+
+    /// Returns the packages of a group defined by the given solvables.
+    /// The list is computed once for each combination of the solvables and kept until the index is invalidated.
+    const std::vector<Package> & get_group_packages(const std::vector<GroupId> & group_ids);
+
+    /// Drops the indexes and the cached package lists. Must be called whenever solvables are added
+    /// to or removed from the comps pool.
+    void invalidate_index();
+
 private:
     friend comps::CompsSack;
 
@@ -69,6 +101,14 @@ private:
     std::set<std::string> config_group_excludes;        // groups explicitly excluded by config
     std::set<std::string> user_environment_excludes;    // environments explicitly excluded by API user
     std::set<std::string> user_group_excludes;          // groups explicitly excluded by API user
+
+    /// Rebuilds the indexes if they were invalidated since the last build.
+    void update_index();
+
+    bool index_valid{false};  // the indexes match the content of the comps pool
+    CompsIndex group_index;
+    CompsIndex environment_index;
+    std::map<std::vector<int>, std::vector<Package>> group_packages;
 };
 
 
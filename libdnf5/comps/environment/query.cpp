@@ -19,6 +19,7 @@
 
 #include "libdnf5/comps/environment/query.hpp"
 
+#include "../comps_sack_impl.hpp"
 #include "solv/pool.hpp"
 
 #include "libdnf5/base/base.hpp"
@@ -30,10 +31,7 @@ extern "C" {
 #include <solv/pool.h>
 }
 
-#include <map>
 #include <string>
-#include <string_view>
-#include <utility>
 #include <vector>
 
 
@@ -64,71 +62,47 @@ EnvironmentQuery::EnvironmentQuery(const BaseWeakPtr & base, ExcludeFlags flags,
     libdnf5::solv::CompsPool & pool = get_comps_pool(base);
     auto sack = base->get_comps_sack();
 
-    // Map of available environments:
-    //     For each environmentid (SOLVABLE_NAME) have a vector of (repoid, solvable_id) pairs.
-    //     Each pair consists of one solvable_id that represents one definition of the environment
-    //     and repoid of its originating repository.
-    std::map<std::string, std::vector<std::pair<std::string_view, Id>>> available_map;
-    Id solvable_id;
-    Solvable * solvable;
-    std::pair<std::string, std::string> solvable_name_pair;
-    std::string_view repoid;
-
     std::set<std::string> config_excludes = sack->get_config_environment_excludes();
     std::set<std::string> user_excludes = sack->get_user_environment_excludes();
 
-    // Loop over all solvables
-    FOR_POOL_SOLVABLES(solvable_id) {
-        solvable = pool.id2solvable(solvable_id);
-
-        // Do not include solvables from disabled repositories (unless ExcludeFlags::USE_DISABLED_REPOSITORIES).
-        // TODO(pkratoch): Test this works
-        if (solvable->repo->disabled &&
-            !static_cast<bool>(flags & libdnf5::sack::ExcludeFlags::USE_DISABLED_REPOSITORIES)) {
-            continue;
-        }
-        // SOLVABLE_NAME is in a form "type:id"; include only solvables of type "environment"
-        solvable_name_pair = solv::CompsPool::split_solvable_name(pool.lookup_str(solvable_id, SOLVABLE_NAME));
-        if (solvable_name_pair.first != "environment") {
-            continue;
-        }
+    // Do not include solvables from disabled repositories (unless ExcludeFlags::USE_DISABLED_REPOSITORIES).
+    const bool use_disabled_repos = static_cast<bool>(flags & libdnf5::sack::ExcludeFlags::USE_DISABLED_REPOSITORIES);
+    auto is_enabled = [&pool](Id solvable_id) { return !pool.id2solvable(solvable_id)->repo->disabled; };
 
+    // The index maps each environmentid to its solvables, the available ones are sorted by repoids
+    for (const auto & [environmentid, item] : sack->p_impl->get_environment_index()) {
         // Check config excludes
         if (!static_cast<bool>(flags & libdnf5::sack::ExcludeFlags::IGNORE_REGULAR_CONFIG_EXCLUDES) &&
-            config_excludes.contains(solvable_name_pair.second)) {
+            config_excludes.contains(environmentid)) {
             continue;
         }
         // Check user excludes
         if (!static_cast<bool>(flags & libdnf5::sack::ExcludeFlags::IGNORE_REGULAR_USER_EXCLUDES) &&
-            user_excludes.contains(solvable_name_pair.second)) {
+            user_excludes.contains(environmentid)) {
             continue;
         }
 
-        repoid = solvable->repo->name;
-
         // Add installed environments directly, because there is only one solvable for each
-        if (repoid == "@System") {
-            Environment environment(base);
-            environment.add_environment_id(EnvironmentId(solvable_id));
-            add(environment);
-        } else {
-            // Create map of available environments:
-            // for each environmentid (SOLVABLE_NAME), list all corresponding solvable_ids with repoids
-            available_map[solvable_name_pair.second].insert(
-                available_map[solvable_name_pair.second].end(), std::make_pair(repoid, solvable_id));
+        for (const auto solvable_id : item.installed) {
+            if (use_disabled_repos || is_enabled(solvable_id)) {
+                Environment environment(base);
+                environment.add_environment_id(EnvironmentId(solvable_id));
+                add(environment);
+            }
         }
-    }
 
-    // Create environments based on the available_map
-    for (auto & item : available_map) {
+        // Create one environment from all available definitions
         Environment environment(base);
-        // Sort the vector of (repoid, solvable_id) pairs by repoid
-        std::sort(item.second.begin(), item.second.end(), std::greater<>());
-        // Create environment_ids vector from the sorted solvable_ids
-        for (const auto & solvableid_repoid_pair : item.second) {
-            environment.add_environment_id(EnvironmentId(solvableid_repoid_pair.second));
+        bool has_definition = false;
+        for (const auto solvable_id : item.available) {
+            if (use_disabled_repos || is_enabled(solvable_id)) {
+                environment.add_environment_id(EnvironmentId(solvable_id));
+                has_definition = true;
+            }
+        }
+        if (has_definition) {
+            add(environment);
         }
-        add(environment);
     }
 }
 
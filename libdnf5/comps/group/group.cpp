@@ -19,6 +19,7 @@
 
 #include "libdnf5/comps/group/group.hpp"
 
+#include "../comps_sack_impl.hpp"
 #include "solv/pool.hpp"
 #include "utils/string.hpp"
 #include "utils/xml.hpp"
@@ -64,8 +65,6 @@ private:
     // repository is preferred, and coincidentally, this is what we want, because "updates" contains more up-to-date
     // definitions.
     std::vector<GroupId> group_ids;
-
-    std::vector<Package> packages;
 };
 
 Group::Group(const BaseWeakPtr & base) : p_impl(std::make_unique<Impl>(base)) {}
@@ -93,7 +92,6 @@ Group & Group::operator=(Group && src) noexcept = default;
 
 Group & Group::operator+=(const Group & rhs) {
     p_impl->group_ids.insert(p_impl->group_ids.begin(), rhs.p_impl->group_ids.begin(), rhs.p_impl->group_ids.end());
-    p_impl->packages.clear();
     return *this;
 }
 
@@ -183,59 +181,8 @@ bool Group::get_default() const {
 
 
 std::vector<Package> Group::get_packages() {
-    // Return packages if they are already loaded
-    if (!p_impl->packages.empty()) {
-        return p_impl->packages;
-    }
-
-    libdnf5::solv::CompsPool & pool = get_comps_pool(p_impl->base);
-
-    std::set<const char *> package_ids_mandatory;
-    std::set<const char *> package_ids_default;
-    std::set<std::pair<const char *, const char *>> package_ids_conditional;
-    std::set<const char *> package_ids_optional;
-
-    for (auto group_id : p_impl->group_ids) {
-        Solvable * solvable = pool.id2solvable(group_id.id);
-
-        // Load MANDATORY packages from solvable->requires
-        if (solvable->dep_requires) {
-            for (Id * r_id = solvable->repo->idarraydata + solvable->dep_requires; *r_id; ++r_id) {
-                const auto package_name = pool.id2str(*r_id);
-                if (package_ids_mandatory.emplace(package_name).second) {
-                    p_impl->packages.emplace_back(package_name, PackageType::MANDATORY, "");
-                }
-            }
-        }
-        // Load DEFAULT and CONDITIONAL packages from solvable->recommends
-        if (solvable->dep_recommends) {
-            for (Id * r_id = solvable->repo->idarraydata + solvable->dep_recommends; *r_id; ++r_id) {
-                const auto package_name = pool.id2str(*r_id);
-                if (strcmp(pool.id2rel(*r_id), "") == 0) {
-                    if (package_ids_default.emplace(package_name).second) {
-                        p_impl->packages.emplace_back(package_name, PackageType::DEFAULT, "");
-                    }
-                } else {
-                    const auto condition = pool.id2evr(*r_id);
-                    if (package_ids_conditional.emplace(package_name, condition).second) {
-                        p_impl->packages.emplace_back(package_name, PackageType::CONDITIONAL, condition);
-                    }
-                }
-            }
-        }
-        // Load OPTIONAL packages from solvable->suggests
-        if (solvable->dep_suggests) {
-            for (Id * r_id = solvable->repo->idarraydata + solvable->dep_suggests; *r_id; ++r_id) {
-                const auto package_name = pool.id2str(*r_id);
-                if (strcmp(pool.id2rel(*r_id), "") == 0) {
-                    if (package_ids_optional.emplace(package_name).second) {
-                        p_impl->packages.emplace_back(package_name, PackageType::OPTIONAL, "");
-                    }
-                }
-            }
-        }
-    }
-    return p_impl->packages;
+    // The package lists are computed once and kept by the comps sack
+    return p_impl->base->get_comps_sack()->p_impl->get_group_packages(p_impl->group_ids);
 }
 
 
@@ -377,7 +324,6 @@ libdnf5::transaction::TransactionItemReason Group::get_reason() const {
 
 void Group::add_group_id(const GroupId & group_id) {
     p_impl->group_ids.push_back(group_id);
-    p_impl->packages.clear();
 }
 
 }  // namespace libdnf5::comps
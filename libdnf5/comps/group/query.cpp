@@ -19,6 +19,7 @@
 
 #include "libdnf5/comps/group/query.hpp"
 
+#include "../comps_sack_impl.hpp"
 #include "solv/pool.hpp"
 
 #include "libdnf5/base/base.hpp"
@@ -30,10 +31,7 @@ extern "C" {
 #include <solv/pool.h>
 }
 
-#include <map>
 #include <string>
-#include <string_view>
-#include <utility>
 #include <vector>
 
 
@@ -66,71 +64,47 @@ GroupQuery::GroupQuery(const BaseWeakPtr & base, ExcludeFlags flags, bool empty)
     libdnf5::solv::CompsPool & pool = get_comps_pool(base);
     auto sack = base->get_comps_sack();
 
-    // Map of available groups:
-    //     For each groupid (SOLVABLE_NAME) have a vector of (repoid, solvable_id) pairs.
-    //     Each pair consists of one solvable_id that represents one definition of the group
-    //     and repoid of its originating repository.
-    std::map<std::string, std::vector<std::pair<std::string_view, Id>>> available_map;
-    Id solvable_id;
-    Solvable * solvable;
-    std::pair<std::string, std::string> solvable_name_pair;
-    std::string_view repoid;
-
     std::set<std::string> config_excludes = sack->get_config_group_excludes();
     std::set<std::string> user_excludes = sack->get_user_group_excludes();
 
-    // Loop over all solvables
-    FOR_POOL_SOLVABLES(solvable_id) {
-        solvable = pool.id2solvable(solvable_id);
-
-        // Do not include solvables from disabled repositories (unless ExcludeFlags::USE_DISABLED_REPOSITORIES).
-        // TODO(pkratoch): Test this works
-        if (solvable->repo->disabled &&
-            !static_cast<bool>(flags & libdnf5::sack::ExcludeFlags::USE_DISABLED_REPOSITORIES)) {
-            continue;
-        }
-        // SOLVABLE_NAME is in a form "type:id"; include only solvables of type "group"
-        solvable_name_pair = solv::CompsPool::split_solvable_name(pool.lookup_str(solvable_id, SOLVABLE_NAME));
-        if (solvable_name_pair.first != "group") {
-            continue;
-        }
+    // Do not include solvables from disabled repositories (unless ExcludeFlags::USE_DISABLED_REPOSITORIES).
+    const bool use_disabled_repos = static_cast<bool>(flags & libdnf5::sack::ExcludeFlags::USE_DISABLED_REPOSITORIES);
+    auto is_enabled = [&pool](Id solvable_id) { return !pool.id2solvable(solvable_id)->repo->disabled; };
 
+    // The index maps each groupid to its solvables, the available ones are sorted by repoids
+    for (const auto & [groupid, item] : sack->p_impl->get_group_index()) {
         // Check config excludes
         if (!static_cast<bool>(flags & libdnf5::sack::ExcludeFlags::IGNORE_REGULAR_CONFIG_EXCLUDES) &&
-            config_excludes.contains(solvable_name_pair.second)) {
+            config_excludes.contains(groupid)) {
             continue;
         }
         // Check user excludes
         if (!static_cast<bool>(flags & libdnf5::sack::ExcludeFlags::IGNORE_REGULAR_USER_EXCLUDES) &&
-            user_excludes.contains(solvable_name_pair.second)) {
+            user_excludes.contains(groupid)) {
             continue;
         }
 
-        repoid = solvable->repo->name;
-
         // Add installed groups directly, because there is only one solvable for each
-        if (repoid == "@System") {
-            Group group(base);
-            group.add_group_id(GroupId(solvable_id));
-            add(group);
-        } else {
-            // Create map of available groups:
-            // for each groupid (SOLVABLE_NAME), list all corresponding solvable_ids with repoids
-            available_map[solvable_name_pair.second].insert(
-                available_map[solvable_name_pair.second].end(), std::make_pair(repoid, solvable_id));
+        for (const auto solvable_id : item.installed) {
+            if (use_disabled_repos || is_enabled(solvable_id)) {
+                Group group(base);
+                group.add_group_id(GroupId(solvable_id));
+                add(group);
+            }
         }
-    }
 
-    // Create groups based on the available_map
-    for (auto & item : available_map) {
+        // Create one group from all available definitions
         Group group(base);
-        // Sort the vector of (repoid, solvable_id) pairs by repoid
-        std::sort(item.second.begin(), item.second.end(), std::greater<>());
-        // Create group_ids vector from the sorted solvable_ids
-        for (const auto & solvableid_repoid_pair : item.second) {
-            group.add_group_id(GroupId(solvableid_repoid_pair.second));
+        bool has_definition = false;
+        for (const auto solvable_id : item.available) {
+            if (use_disabled_repos || is_enabled(solvable_id)) {
+                group.add_group_id(GroupId(solvable_id));
+                has_definition = true;
+            }
+        }
+        if (has_definition) {
+            add(group);
         }
-        add(group);
     }
 }
 
@@ -164,12 +138,13 @@ libdnf5::BaseWeakPtr GroupQuery::get_base() {
 }
 
 void GroupQuery::filter_package_name(const std::vector<std::string> & patterns, sack::QueryCmp cmp) {
+    const sack::StringMatcher matcher(cmp, patterns);
     for (auto it = get_data().begin(); it != get_data().end();) {
         // Copy group so we can call `get_packages()`, this is needed because `it` is from a std::set and thus const
-        // but `get_packages()` modifies its group (it stores cache of its packages).
+        // but `get_packages()` is not a const method. The package lists themselves are cached by the comps sack.
         Group group = *it;
         bool keep = std::ranges::any_of(
-            group.get_packages(), [&](const auto & pkg) { return match_string(pkg.get_name(), cmp, patterns); });
+            group.get_packages(), [&](const auto & pkg) { return matcher.match(pkg.get_name()); });
         if (keep) {
             ++it;
         } else {
@@ -224,6 +224,7 @@ class ConfigMain::Impl {
 
     OptionBool upgrade_group_objects_upgrade{true};  // :api
     OptionPath destdir{nullptr};
+    OptionPath package_store_dir{nullptr};
     OptionString comment{nullptr};
     OptionBool downloadonly{false};  // runtime only option
     OptionBool ignorearch{false};
@@ -246,6 +247,7 @@ class ConfigMain::Impl {
     OptionNumber<std::uint32_t> retries{10};
     OptionPath cachedir{geteuid() == 0 ? SYSTEM_CACHEDIR : libdnf5::xdg::get_user_cache_dir() / "libdnf5"};
     OptionBool fastestmirror{false};
+    OptionSeconds mirror_health_max_age{60 * 60 * 24 * 7};  // 7 days
     OptionStringAppendList excludeenvs{std::vector<std::string>{}};
     OptionStringAppendList excludegroups{std::vector<std::string>{}};
     OptionStringAppendList excludepkgs{std::vector<std::string>{}};
@@ -410,6 +412,7 @@ ConfigMain::Impl::Impl(Config & owner) : owner(owner) {
     owner.opt_binds().add("history_list_view", history_list_view);
     owner.opt_binds().add("upgrade_group_objects_upgrade", upgrade_group_objects_upgrade);
     owner.opt_binds().add("destdir", destdir);
+    owner.opt_binds().add("package_store_dir", package_store_dir);
     owner.opt_binds().add("comment", comment);
     owner.opt_binds().add("ignorearch", ignorearch);
 #ifdef WITH_MODULEMD
@@ -430,6 +433,7 @@ ConfigMain::Impl::Impl(Config & owner) : owner(owner) {
     owner.opt_binds().add("retries", retries);
     owner.opt_binds().add("cachedir", cachedir);
     owner.opt_binds().add("fastestmirror", fastestmirror);
+    owner.opt_binds().add("mirror_health_max_age", mirror_health_max_age);
     owner.opt_binds().add("excludepkgs", excludepkgs);
     owner.opt_binds().add("excludeenvs", excludeenvs);
     owner.opt_binds().add("excludegroups", excludegroups);
@@ -1004,6 +1008,13 @@ const OptionPath & ConfigMain::get_destdir_option() const {
     return p_impl->destdir;
 }
 
+OptionPath & ConfigMain::get_package_store_dir_option() {
+    return p_impl->package_store_dir;
+}
+const OptionPath & ConfigMain::get_package_store_dir_option() const {
+    return p_impl->package_store_dir;
+}
+
 OptionString & ConfigMain::get_comment_option() {
     return p_impl->comment;
 }
@@ -1119,6 +1130,13 @@ const OptionBool & ConfigMain::get_fastestmirror_option() const {
     return p_impl->fastestmirror;
 }
 
+OptionSeconds & ConfigMain::get_mirror_health_max_age_option() {
+    return p_impl->mirror_health_max_age;
+}
+const OptionSeconds & ConfigMain::get_mirror_health_max_age_option() const {
+    return p_impl->mirror_health_max_age;
+}
+
 OptionStringAppendList & ConfigMain::get_excludeenvs_option() {
     return p_impl->excludeenvs;
 }
@@ -1520,6 +1538,7 @@ void ConfigMain::Impl::load_from_config(const ConfigMain::Impl & other) {
     load_option(history_list_view, other.history_list_view);
     load_option(upgrade_group_objects_upgrade, other.upgrade_group_objects_upgrade);
     load_option(destdir, other.destdir);
+    load_option(package_store_dir, other.package_store_dir);
     load_option(comment, other.comment);
     load_option(downloadonly, other.downloadonly);
     load_option(ignorearch, other.ignorearch);
@@ -1540,6 +1559,7 @@ void ConfigMain::Impl::load_from_config(const ConfigMain::Impl & other) {
     load_option(retries, other.retries);
     load_option(cachedir, other.cachedir);
     load_option(fastestmirror, other.fastestmirror);
+    load_option(mirror_health_max_age, other.mirror_health_max_age);
     load_option(excludeenvs, other.excludeenvs);
     load_option(excludegroups, other.excludegroups);
     load_option(excludepkgs, other.excludepkgs);
@@ -89,6 +89,8 @@ Vars::detect_releasevers(const BaseWeakPtr & base, const std::string & install_r
     std::unique_ptr<std::string> releasever_major;
     std::unique_ptr<std::string> releasever_minor;
 
+    base::Tracer::Scope trace(base->get_tracer(), "detect_releasevers");
+
     libdnf5::rpm::RpmLogGuard rpm_log_guard(base);
 
     auto ts = rpmtsCreate();
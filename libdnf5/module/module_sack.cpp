@@ -23,7 +23,9 @@
 #include "module/module_goal_private.hpp"
 #include "module/module_metadata.hpp"
 #include "module/module_sack_impl.hpp"
+#include "module/module_solve_cache.hpp"
 #include "solv/solv_map.hpp"
+#include "utils/checksum.hpp"
 
 #include "libdnf5/base/base.hpp"
 #include "libdnf5/base/base_weak.hpp"
@@ -48,14 +50,20 @@ extern "C" {
 #include "libdnf5/repo/repo_weak.hpp"
 #include "libdnf5/rpm/package_query.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
+#include <tuple>
 
 namespace libdnf5::module {
 
 
 static const std::string EMPTY_RESULT;
 
+// Bump when the content of the module solve cache or the way its key is computed changes
+static constexpr int SOLVE_CACHE_VERSION = 1;
+
 
 ModuleSack::ModuleSack(const BaseWeakPtr & base) : p_impl(new Impl(*this, base)) {}
 ModuleSack::~ModuleSack() {}
@@ -93,6 +101,8 @@ void ModuleSack::add(const std::string & file_content, const std::string & repo_
             M_("Failed to load module metadata for repository \"{}\": {}"), repo_id, std::string(e.what()));
     }
 
+    p_impl->metadata_checksums.push_back(repo_id + ":" + utils::get_sha256_hex(file_content));
+
     Repo * repo;
     auto repo_pair = p_impl->repositories.find(repo_id);
     if (repo_pair == p_impl->repositories.end()) {
@@ -273,14 +283,64 @@ void ModuleSack::Impl::module_filtering() {
 
     // Try to automatically detect platform id
     if (!platform_detected) {
-        auto platform_id = detect_platform_name_and_stream();
-        if (platform_id) {
-            ModuleItem::create_platform_solvable(module_sack->get_weak_ptr(), platform_id->first, platform_id->second);
+        auto detected_platform_id = detect_platform_name_and_stream();
+        if (detected_platform_id) {
+            ModuleItem::create_platform_solvable(
+                module_sack->get_weak_ptr(), detected_platform_id->first, detected_platform_id->second);
+            platform_id = detected_platform_id->first + ":" + detected_platform_id->second;
             platform_detected = true;
         }
     }
 
-    auto [include_NEVRAs, exclude_NEVRAs, names, src_names, reldep_name_list] = collect_data_for_modular_filtering();
+    // The result of the modular solver and the data collected from the active modules are cached.
+    // With unchanged inputs, the solving and the collecting are skipped. Only a result of the solver without
+    // explicitly requested modules is cached, an earlier result is not known. The cache is not used when
+    // the solver debug data are requested, they are written by the solver.
+    const bool use_solve_cache = !module_sack->active_modules_resolved && modules_to_enable.empty() &&
+                                 !base->get_config().get_debug_solver_option().get_value();
+    ModuleSolveCache solve_cache(base, base->get_config().get_cachedir_option().get_value());
+    std::string solve_cache_key;
+    std::optional<ModuleSolveCache::Data> cached;
+    if (use_solve_cache) {
+        solve_cache_key = get_solve_cache_key();
+        cached = solve_cache.load(solve_cache_key);
+    }
+    std::vector<std::string> include_NEVRAs;
+    std::vector<std::string> exclude_NEVRAs;
+    std::vector<std::string> names;
+    std::vector<std::string> src_names;
+    if (cached) {
+        restore_active_modules(cached->active_modules);
+        include_NEVRAs = std::move(cached->include_nevras);
+        exclude_NEVRAs = std::move(cached->exclude_nevras);
+        names = std::move(cached->names);
+        src_names = std::move(cached->src_names);
+    } else {
+        // A result of the solver with problems is not cached
+        bool cacheable = false;
+        if (!module_sack->active_modules_resolved) {
+            cacheable = module_sack->resolve_active_module_items().second == GoalProblem::NO_PROBLEM &&
+                        use_solve_cache;
+        }
+        std::tie(include_NEVRAs, exclude_NEVRAs, names, src_names, std::ignore) =
+            collect_data_for_modular_filtering();
+        if (cacheable) {
+            ModuleSolveCache::Data data{
+                .active_modules = {},
+                .include_nevras = include_NEVRAs,
+                .exclude_nevras = exclude_NEVRAs,
+                .names = names,
+                .src_names = src_names};
+            for (const auto & [id, module_item] : active_modules) {
+                data.active_modules.push_back(module_item->get_name_stream_staticcontext());
+            }
+            solve_cache.save(solve_cache_key, data);
+        }
+    }
+    libdnf5::rpm::ReldepList reldep_name_list(base);
+    for (const auto & name : names) {
+        reldep_name_list.add_reldep(name);
+    }
 
     // Packages from system, commandline, and hotfix repositories are not targets for modular filtering
     libdnf5::rpm::PackageQuery target_packages(base);
@@ -727,27 +787,78 @@ std::optional<std::pair<std::string, std::string>> ModuleSack::Impl::detect_plat
 }
 
 
-std::pair<base::SolverProblems, GoalProblem> ModuleSack::resolve_active_module_items() {
-    p_impl->considered_uptodate = false;
-    p_impl->excludes.reset(new libdnf5::solv::SolvMap(p_impl->pool->nsolvables));
-    p_impl->module_db->initialize();
+std::vector<ModuleItem *> ModuleSack::Impl::prepare_module_items_to_solve() {
+    considered_uptodate = false;
+    excludes.reset(new libdnf5::solv::SolvMap(pool->nsolvables));
+    module_db->initialize();
 
     ModuleStatus status;
     std::vector<ModuleItem *> module_items_to_solve;
     // Use only enabled or default modules for transaction
     for (const auto & module_item : get_modules()) {
         const auto & module_name = module_item->get_name();
-        status = p_impl->module_db->get_status(module_name);
+        status = module_db->get_status(module_name);
         if (status == ModuleStatus::DISABLED) {
-            p_impl->excludes->add(module_item->get_id().id);
+            excludes->add(module_item->get_id().id);
         } else if (
             status == ModuleStatus::ENABLED &&
-            p_impl->module_db->get_enabled_stream(module_name) == module_item->get_stream()) {
+            module_db->get_enabled_stream(module_name) == module_item->get_stream()) {
             module_items_to_solve.push_back(module_item.get());
-        } else if (status == ModuleStatus::AVAILABLE && get_default_stream(module_name) == module_item->get_stream()) {
+        } else if (
+            status == ModuleStatus::AVAILABLE &&
+            module_sack->get_default_stream(module_name) == module_item->get_stream()) {
             module_items_to_solve.push_back(module_item.get());
         }
     }
+    return module_items_to_solve;
+}
+
+
+void ModuleSack::Impl::restore_active_modules(const std::vector<std::string> & solvable_names) {
+    prepare_module_items_to_solve();
+
+    active_modules.clear();
+    const std::set<std::string> names(solvable_names.begin(), solvable_names.end());
+    for (const auto & module_item : modules) {
+        if (names.contains(module_item->get_name_stream_staticcontext())) {
+            active_modules[module_item->get_id().id] = module_item.get();
+        }
+    }
+    module_sack->active_modules_resolved = true;
+}
+
+
+std::string ModuleSack::Impl::get_solve_cache_key() {
+    module_db->initialize();
+
+    std::string key_data = fmt::format(
+        "version: {}\narch: {}\nplatform: {}\n",
+        SOLVE_CACHE_VERSION,
+        base->get_vars()->get_value("arch"),
+        platform_id);
+    // the order in which the repositories were loaded does not matter
+    auto sorted_metadata_checksums = metadata_checksums;
+    std::sort(sorted_metadata_checksums.begin(), sorted_metadata_checksums.end());
+    for (const auto & checksum : sorted_metadata_checksums) {
+        key_data += fmt::format("metadata: {}\n", checksum);
+    }
+    std::set<std::string> module_names;
+    for (const auto & module_item : get_modules()) {
+        module_names.insert(module_item->get_name());
+    }
+    for (const auto & module_name : module_names) {
+        key_data += fmt::format(
+            "module: {} {} {}\n",
+            module_name,
+            module_status_to_string(module_db->get_status(module_name)),
+            module_db->get_enabled_stream(module_name));
+    }
+    return utils::get_sha256_hex(key_data);
+}
+
+
+std::pair<base::SolverProblems, GoalProblem> ModuleSack::resolve_active_module_items() {
+    auto module_items_to_solve = p_impl->prepare_module_items_to_solve();
 
     auto problems = p_impl->module_solve(module_items_to_solve);
     active_modules_resolved = true;
@@ -101,6 +101,18 @@ public:
     void make_provides_ready();
     void recompute_considered_in_pool();
 
+    /// Reset the state of the active modules resolving: initialize the module DB, exclude the disabled modules and
+    /// return the enabled and default module items, which are the input of the modular solver.
+    std::vector<ModuleItem *> prepare_module_items_to_solve();
+
+    /// Use the given solvable names (name:stream:static_context) as the result of the modular solver instead
+    /// of running it. All module items with these names become active.
+    void restore_active_modules(const std::vector<std::string> & solvable_names);
+
+    /// @return Key of the module solve cache. It is a checksum of all inputs of the modular solver: the loaded
+    ///         module metadata, the module DB state, the platform and the architecture.
+    std::string get_solve_cache_key();
+
     // Requires resolved goal. Takes list_installs() from goal and adds all modules with the same SOLVABLE_NAME
     // (<name>:<stream>:<context>) into active_modules.
     void set_active_modules(ModuleGoalPrivate & goal);
@@ -177,6 +189,10 @@ private:
     bool provides_ready = false;
     bool considered_uptodate = false;
     bool platform_detected = false;
+    // "name:stream" of the detected platform, empty if no platform was detected
+    std::string platform_id;
+    // "repo_id:checksum" of every loaded modules metadata file in the order of loading
+    std::vector<std::string> metadata_checksums;
 
     std::map<std::string, std::string> module_defaults;
     std::unique_ptr<libdnf5::solv::SolvMap> excludes;
@@ -0,0 +1,100 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "module/module_solve_cache.hpp"
+
+#include "libdnf5/base/base.hpp"
+#include "libdnf5/utils/fs/file.hpp"
+#include "libdnf5/utils/locker.hpp"
+
+#include <toml.hpp>
+
+
+namespace libdnf5::module {
+
+namespace {
+
+constexpr const char * KEY_TOML_KEY = "key";
+constexpr const char * ACTIVE_MODULES_TOML_KEY = "active_modules";
+constexpr const char * INCLUDE_NEVRAS_TOML_KEY = "include_nevras";
+constexpr const char * EXCLUDE_NEVRAS_TOML_KEY = "exclude_nevras";
+constexpr const char * NAMES_TOML_KEY = "names";
+constexpr const char * SRC_NAMES_TOML_KEY = "src_names";
+
+}  // namespace
+
+
+ModuleSolveCache::ModuleSolveCache(const BaseWeakPtr & base, const std::string & parent_dir)
+    : base(base),
+      full_cache_path(std::filesystem::path(parent_dir) / CACHE_FILENAME) {}
+
+ModuleSolveCache::~ModuleSolveCache() = default;
+
+std::optional<ModuleSolveCache::Data> ModuleSolveCache::load(const std::string & key) const {
+    std::error_code ec;
+    if (!std::filesystem::exists(full_cache_path, ec)) {
+        return std::nullopt;
+    }
+
+    try {
+        const auto toml_data = toml::parse(full_cache_path);
+        if (toml::find_or(toml_data, KEY_TOML_KEY, std::string{}) != key) {
+            return std::nullopt;
+        }
+        Data data;
+        data.active_modules = toml::find_or(toml_data, ACTIVE_MODULES_TOML_KEY, std::vector<std::string>{});
+        data.include_nevras = toml::find_or(toml_data, INCLUDE_NEVRAS_TOML_KEY, std::vector<std::string>{});
+        data.exclude_nevras = toml::find_or(toml_data, EXCLUDE_NEVRAS_TOML_KEY, std::vector<std::string>{});
+        data.names = toml::find_or(toml_data, NAMES_TOML_KEY, std::vector<std::string>{});
+        data.src_names = toml::find_or(toml_data, SRC_NAMES_TOML_KEY, std::vector<std::string>{});
+        return data;
+    } catch (const std::exception & e) {
+        base->get_logger()->warning(
+            "Cannot load the module solve cache from \"{}\": {}", full_cache_path.string(), e.what());
+        return std::nullopt;
+    }
+}
+
+void ModuleSolveCache::save(const std::string & key, const Data & data) const {
+    auto temporary_path = full_cache_path.string() + ".temp";
+    try {
+        std::filesystem::create_directories(full_cache_path.parent_path());
+
+        // the temporary file is shared by all processes, the lock keeps them from writing it concurrently
+        utils::Locker locker(full_cache_path.string() + ".lock", true);
+        locker.lock(utils::LockAccess::WRITE, utils::LockBlocking::BLOCKING);
+
+        // write new contents to a temporary file and then move the new file atomically
+        utils::fs::File(temporary_path, "w")
+            .write(toml::format(toml::value(toml::table{
+                {KEY_TOML_KEY, key},
+                {ACTIVE_MODULES_TOML_KEY, data.active_modules},
+                {INCLUDE_NEVRAS_TOML_KEY, data.include_nevras},
+                {EXCLUDE_NEVRAS_TOML_KEY, data.exclude_nevras},
+                {NAMES_TOML_KEY, data.names},
+                {SRC_NAMES_TOML_KEY, data.src_names}})));
+        std::filesystem::rename(temporary_path, full_cache_path);
+    } catch (const std::exception & e) {
+        // the cache is only an optimization, the next run solves the modules again
+        base->get_logger()->warning(
+            "Cannot store the module solve cache to \"{}\": {}", full_cache_path.string(), e.what());
+    }
+}
+
+}  // namespace libdnf5::module
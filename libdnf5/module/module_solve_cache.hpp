@@ -0,0 +1,70 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef LIBDNF5_MODULE_MODULE_SOLVE_CACHE_HPP
+#define LIBDNF5_MODULE_MODULE_SOLVE_CACHE_HPP
+
+#include "libdnf5/base/base_weak.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+namespace libdnf5::module {
+
+/// Persistent cache of the result of the modular solver and of the data for the modular filtering.
+/// It holds a single entry identified by a key computed from all inputs of the solving, so an entry
+/// stored by a previous run is used only if nothing that could change the result has changed.
+class ModuleSolveCache {
+public:
+    /// Filename in which the cache is stored.
+    static constexpr const char * CACHE_FILENAME = "module_solve_cache.toml";
+
+    struct Data {
+        // Solvable names (name:stream:static_context) of the active module items
+        std::vector<std::string> active_modules;
+        // Data returned by `ModuleSack::Impl::collect_data_for_modular_filtering()`
+        std::vector<std::string> include_nevras;
+        std::vector<std::string> exclude_nevras;
+        std::vector<std::string> names;
+        std::vector<std::string> src_names;
+    };
+
+    /// @param base       A weak pointer to Base object.
+    /// @param parent_dir Path to a directory where the cache file is or will be stored.
+    ModuleSolveCache(const BaseWeakPtr & base, const std::string & parent_dir);
+    ~ModuleSolveCache();
+
+    /// @return The cached data if they were stored with the same `key`, `std::nullopt` otherwise.
+    ///         A missing or unparsable cache file is treated as a cache miss.
+    std::optional<Data> load(const std::string & key) const;
+
+    /// Replace the cache entry with `data` stored under the `key`.
+    void save(const std::string & key, const Data & data) const;
+
+private:
+    BaseWeakPtr base;
+    std::filesystem::path full_cache_path;
+};
+
+}  // namespace libdnf5::module
+
+#endif  // LIBDNF5_MODULE_MODULE_SOLVE_CACHE_HPP
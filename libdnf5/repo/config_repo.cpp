@@ -19,15 +19,13 @@
 
 #include "libdnf5/repo/config_repo.hpp"
 
+#include "utils/checksum.hpp"
 #include "utils/deprecate.hpp"
 
 #include "libdnf5/conf/config_parser.hpp"
 #include "libdnf5/conf/const.hpp"
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
 
-#include <solv/chksum.h>
-#include <solv/util.h>
-
 #include <filesystem>
 
 namespace libdnf5::repo {
@@ -583,20 +581,9 @@ std::string ConfigRepo::get_unique_id() const {
         }
     }
 
-    auto chksum_obj = solv_chksum_create(REPOKEY_TYPE_SHA256);
-    solv_chksum_add(chksum_obj, tmp.c_str(), static_cast<int>(tmp.length()));
-    int chksum_len;
-    auto chksum = solv_chksum_get(chksum_obj, &chksum_len);
-    static constexpr int USE_CHECKSUM_BYTES = 8;
-    if (chksum_len < USE_CHECKSUM_BYTES) {
-        solv_chksum_free(chksum_obj, nullptr);
-        throw RuntimeError(M_("get_unique_id(): Computation of SHA256 failed"));
-    }
-    char chksum_cstr[USE_CHECKSUM_BYTES * 2 + 1];
-    solv_bin2hex(chksum, USE_CHECKSUM_BYTES, chksum_cstr);
-    solv_chksum_free(chksum_obj, nullptr);
-
-    return p_impl->id + "-" + chksum_cstr;
+    // the first 8 bytes of the checksum are used
+    static constexpr std::size_t USE_CHECKSUM_HEX_CHARS = 16;
+    return p_impl->id + "-" + utils::get_sha256_hex(tmp).substr(0, USE_CHECKSUM_HEX_CHARS);
 }
 
 
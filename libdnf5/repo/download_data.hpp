@@ -87,6 +87,8 @@ private:
     std::map<std::string, std::string> metadata_paths;
 
     std::optional<LibrepoHandle> handle;
+    // the handle uses the resolved `mirrors` ordered by their health
+    bool handle_mirrors_sorted{false};
 };
 
 }  // namespace libdnf5::repo
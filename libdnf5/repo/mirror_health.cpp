@@ -0,0 +1,249 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "mirror_health.hpp"
+
+#include "libdnf5/base/base.hpp"
+#include "libdnf5/utils/fs/file.hpp"
+#include "libdnf5/utils/locker.hpp"
+
+#include <toml.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <tuple>
+
+
+namespace libdnf5::repo {
+
+namespace {
+
+// Weight of a new measurement in the moving averages of the latency and the throughput
+constexpr double MEASUREMENT_WEIGHT = 0.3;
+
+enum class Group { HEALTHY, UNKNOWN, FAILING };
+
+std::int64_t now() {
+    return static_cast<std::int64_t>(std::time(nullptr));
+}
+
+double decay(double value, std::int64_t from, std::int64_t to) {
+    if (to <= from) {
+        return value;
+    }
+    return value * std::exp2(-static_cast<double>(to - from) / MirrorHealth::HALF_LIFE);
+}
+
+void add_measurement(double & average, double value) {
+    average = average > 0 ? average + MEASUREMENT_WEIGHT * (value - average) : value;
+}
+
+void add_download(
+    MirrorHealth::Record & record, std::int64_t time, bool success, double rtt = -1, double throughput = 0) {
+    record.successes = decay(record.successes, record.updated, time) + (success ? 1 : 0);
+    record.failures = decay(record.failures, record.updated, time) + (success ? 0 : 1);
+    if (rtt >= 0) {
+        add_measurement(record.rtt, rtt);
+    }
+    if (throughput > 0) {
+        add_measurement(record.throughput, throughput);
+    }
+    record.updated = std::max(record.updated, time);
+}
+
+// Returns the group and the position within the group of each of the mirrors, sorted
+std::vector<std::tuple<Group, double, std::size_t>> get_sorted_keys(
+    const MirrorHealth & health, const std::vector<std::string> & mirrors) {
+    const auto current_time = now();
+    std::vector<std::tuple<Group, double, std::size_t>> keys;
+    keys.reserve(mirrors.size());
+    for (std::size_t idx = 0; idx < mirrors.size(); ++idx) {
+        const auto * record = health.get_record(mirrors[idx]);
+        if (!record) {
+            keys.emplace_back(Group::UNKNOWN, 0, idx);
+            continue;
+        }
+        const auto successes = decay(record->successes, record->updated, current_time);
+        const auto failures = decay(record->failures, record->updated, current_time);
+        if (failures >= 1 && failures >= successes) {
+            keys.emplace_back(Group::FAILING, failures / (successes + failures), idx);
+        } else if (record->throughput > 0) {
+            keys.emplace_back(Group::HEALTHY, -record->throughput, idx);
+        } else {
+            keys.emplace_back(Group::UNKNOWN, 0, idx);
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+}  // namespace
+
+
+MirrorHealth::MirrorHealth(const BaseWeakPtr & base, const std::string & parent_dir, std::int64_t max_age)
+    : base(base),
+      full_memory_path(std::filesystem::path(parent_dir) / MEMORY_FILENAME),
+      max_age(max_age),
+      records(load()) {}
+
+MirrorHealth::~MirrorHealth() = default;
+
+std::map<std::string, MirrorHealth::Record> MirrorHealth::load() {
+    std::map<std::string, Record> loaded_records;
+    std::error_code ec;
+    if (!std::filesystem::exists(full_memory_path, ec)) {
+        return loaded_records;
+    }
+
+    const auto current_time = now();
+    try {
+        const auto toml_data = toml::parse(full_memory_path);
+        const auto mirrors = toml::find_or(toml_data, MIRRORS_TOML_KEY, toml::table{});
+        for (const auto & [mirror, value] : mirrors) {
+            Record record;
+            record.rtt = toml::find_or(value, "rtt", 0.0);
+            record.throughput = toml::find_or(value, "throughput", 0.0);
+            record.successes = toml::find_or(value, "successes", 0.0);
+            record.failures = toml::find_or(value, "failures", 0.0);
+            record.updated = toml::find_or(value, "updated", std::int64_t{0});
+            if (max_age >= 0 && current_time - record.updated > max_age) {
+                changed = true;
+                continue;
+            }
+            loaded_records.emplace(mirror, record);
+        }
+    } catch (const std::exception & e) {
+        // the records are only a hint for ordering the mirrors, start over with an empty store
+        base->get_logger()->warning(
+            "Cannot load the mirror health records from \"{}\": {}", full_memory_path.string(), e.what());
+        loaded_records.clear();
+        changed = true;
+    }
+    return loaded_records;
+}
+
+void MirrorHealth::add_success(const std::string & mirror, double rtt, double throughput) {
+    if (mirror.empty()) {
+        return;
+    }
+    const auto current_time = now();
+    add_download(records[mirror], current_time, true, rtt, throughput);
+    unsaved_downloads.push_back({mirror, current_time, true, rtt, throughput});
+    changed = true;
+}
+
+void MirrorHealth::add_failure(const std::string & mirror) {
+    if (mirror.empty()) {
+        return;
+    }
+    const auto current_time = now();
+    add_download(records[mirror], current_time, false);
+    unsaved_downloads.push_back({mirror, current_time, false, -1, 0});
+    changed = true;
+}
+
+const MirrorHealth::Record * MirrorHealth::get_record(const std::string & mirror) const {
+    auto it = records.find(mirror);
+    return it == records.end() ? nullptr : &it->second;
+}
+
+std::vector<std::string> MirrorHealth::sort_mirrors(const std::vector<std::string> & mirrors) const {
+    std::vector<std::string> sorted;
+    sorted.reserve(mirrors.size());
+    for (const auto & key : get_sorted_keys(*this, mirrors)) {
+        sorted.push_back(mirrors[std::get<2>(key)]);
+    }
+    return sorted;
+}
+
+std::vector<std::string> MirrorHealth::get_healthy_mirrors(const std::vector<std::string> & mirrors) const {
+    std::vector<std::string> healthy;
+    for (const auto & key : get_sorted_keys(*this, mirrors)) {
+        if (std::get<0>(key) != Group::HEALTHY) {
+            break;
+        }
+        healthy.push_back(mirrors[std::get<2>(key)]);
+    }
+    return healthy;
+}
+
+void MirrorHealth::save() {
+    if (!changed) {
+        return;
+    }
+
+    auto temporary_path = full_memory_path.string() + ".temp";
+    try {
+        std::filesystem::create_directories(full_memory_path.parent_path());
+
+        // other processes may have saved their downloads since the records were loaded,
+        // load them again under the lock and add the downloads of this process
+        utils::Locker locker(full_memory_path.string() + ".lock", true);
+        locker.lock(utils::LockAccess::WRITE, utils::LockBlocking::BLOCKING);
+        auto merged_records = load();
+        for (const auto & download : unsaved_downloads) {
+            add_download(
+                merged_records[download.mirror], download.time, download.success, download.rtt, download.throughput);
+        }
+
+        toml::table mirrors;
+        for (const auto & [mirror, record] : merged_records) {
+            mirrors.emplace(
+                mirror,
+                toml::table{
+                    {"rtt", record.rtt},
+                    {"throughput", record.throughput},
+                    {"successes", record.successes},
+                    {"failures", record.failures},
+                    {"updated", record.updated}});
+        }
+
+        // write new contents to a temporary file and then move the new file atomically
+        utils::fs::File(temporary_path, "w")
+            .write(toml::format(toml::value(toml::table{{MIRRORS_TOML_KEY, std::move(mirrors)}})));
+        std::filesystem::rename(temporary_path, full_memory_path);
+
+        records = std::move(merged_records);
+        unsaved_downloads.clear();
+        changed = false;
+    } catch (const std::exception & e) {
+        base->get_logger()->warning(
+            "Cannot store the mirror health records to \"{}\": {}", full_memory_path.string(), e.what());
+    }
+}
+
+std::string MirrorHealth::find_mirror(const std::string & url, const std::vector<std::string> & mirrors) {
+    const std::string * found{nullptr};
+    for (const auto & mirror : mirrors) {
+        if (!mirror.empty() && url.starts_with(mirror) && (!found || mirror.size() > found->size())) {
+            found = &mirror;
+        }
+    }
+    if (found) {
+        return *found;
+    }
+    if (auto pos = url.find("/repodata/"); pos != std::string::npos) {
+        return url.substr(0, pos + 1);
+    }
+    return {};
+}
+
+}  // namespace libdnf5::repo
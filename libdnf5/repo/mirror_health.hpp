@@ -0,0 +1,120 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef LIBDNF5_REPO_MIRROR_HEALTH_HPP
+#define LIBDNF5_REPO_MIRROR_HEALTH_HPP
+
+#include "libdnf5/base/base_weak.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace libdnf5::repo {
+
+/// @brief Persistent per-mirror download statistics stored in a TOML file.
+/// The records are shared by all repositories, a mirror is identified by its base URL.
+/// The success and failure counters decay with a half-life of one day, records not updated
+/// for longer than the maximum age are dropped when the file is loaded.
+/// The file may be updated by several processes, `save()` merges the downloads recorded by this
+/// object into the records currently stored in the file.
+class MirrorHealth {
+public:
+    /// @brief Filename in which the records are stored.
+    static constexpr const char * MEMORY_FILENAME = "mirror_health.toml";
+
+    /// @brief TOML key used for the table of mirror records.
+    static constexpr const char * MIRRORS_TOML_KEY = "mirrors";
+
+    /// @brief Time in seconds after which the success and failure counters lose half of their weight.
+    static constexpr double HALF_LIFE = 60 * 60 * 24;
+
+    struct Record {
+        double rtt{0};         // seconds to the first byte, moving average
+        double throughput{0};  // bytes per second, moving average
+        double successes{0};   // decayed count of successful downloads at the `updated` time
+        double failures{0};    // decayed count of failed downloads at the `updated` time
+        std::int64_t updated{0};
+    };
+
+    /// @brief Load the records stored in `parent_dir`.
+    /// @param base       A weak pointer to Base object.
+    /// @param parent_dir Path to a directory where the memory file is or will be stored.
+    /// @param max_age    Records older than `max_age` seconds are dropped, -1 keeps them forever.
+    /// A missing or unparsable memory file is treated as empty.
+    MirrorHealth(const BaseWeakPtr & base, const std::string & parent_dir, std::int64_t max_age);
+    ~MirrorHealth();
+
+    /// @brief Record a successful download from the `mirror`.
+    /// @param rtt        Time to the first byte in seconds.
+    /// @param throughput Transfer rate in bytes per second, ignored if not positive.
+    void add_success(const std::string & mirror, double rtt, double throughput);
+
+    /// @brief Record a failed download from the `mirror`.
+    void add_failure(const std::string & mirror);
+
+    /// @return The record of the `mirror` or `nullptr` if there is none.
+    const Record * get_record(const std::string & mirror) const;
+
+    /// @brief Order the mirrors by their health.
+    /// Healthy mirrors with known throughput come first, the fastest one first, followed by
+    /// the mirrors without records. Mirrors whose recent downloads mostly failed come last.
+    /// Mirrors within each group without a distinguishing record keep their original order.
+    std::vector<std::string> sort_mirrors(const std::vector<std::string> & mirrors) const;
+
+    /// @return The healthy mirrors with known throughput from `mirrors`, the fastest one first.
+    std::vector<std::string> get_healthy_mirrors(const std::vector<std::string> & mirrors) const;
+
+    /// @brief Write the records into the memory file. Nothing is written if no record changed.
+    /// The file is locked, its current records are loaded again and the downloads recorded since
+    /// the last save are added to them before the file is replaced.
+    void save();
+
+    /// @return The mirror (base URL) from `mirrors` the `url` belongs to. If none matches, the part
+    ///         of the `url` in front of "/repodata/" is returned for metadata URLs, otherwise an empty string.
+    static std::string find_mirror(const std::string & url, const std::vector<std::string> & mirrors);
+
+private:
+    // A download recorded by add_success() or add_failure() that was not saved yet
+    struct Download {
+        std::string mirror;
+        std::int64_t time;
+        bool success;
+        double rtt;
+        double throughput;
+    };
+
+    std::map<std::string, Record> load();
+
+    BaseWeakPtr base;
+    std::filesystem::path full_memory_path;
+    std::int64_t max_age;
+    std::map<std::string, Record> records;
+    std::vector<Download> unsaved_downloads;
+    bool changed{false};
+};
+
+
+}  // namespace libdnf5::repo
+
+#endif  // LIBDNF5_REPO_MIRROR_HEALTH_HPP
@@ -19,6 +19,7 @@
 
 #include "libdnf5/repo/package_downloader.hpp"
 
+#include "mirror_health.hpp"
 #include "repo_downloader.hpp"
 #include "temp_files_memory.hpp"
 #include "utils/fs/utils.hpp"
@@ -36,6 +37,7 @@
 #include <librepo/librepo.h>
 
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
 
 
@@ -72,12 +74,21 @@ public:
     void * user_cb_data{nullptr};
     bool need_call_end_callback{false};
     bool transfer_failed{false};
+
+    // Timing of the last transfer attempt and the URLs of the failed attempts for the mirror health records.
+    // The attempt starts with the request, not with the first progress report.
+    std::chrono::steady_clock::time_point transfer_start;
+    std::chrono::steady_clock::time_point first_byte;
+    std::chrono::steady_clock::time_point transfer_end;
+    bool transfer_running{false};
+    std::vector<std::string> failed_urls;
 };
 
 static int end_callback(void * data, LrTransferStatus status, const char * msg) {
     libdnf_assert(data != nullptr, "data in callback must be set");
 
     auto * package_target = static_cast<PackageTarget *>(data);
+    package_target->transfer_end = std::chrono::steady_clock::now();
     auto cb_status = static_cast<DownloadCallbacks::TransferStatus>(status);
     if (cb_status == DownloadCallbacks::TransferStatus::ERROR) {
         package_target->transfer_failed = true;
@@ -94,22 +105,149 @@ static int progress_callback(void * data, double total_to_download, double downl
     libdnf_assert(data != nullptr, "data in callback must be set");
 
     auto * package_target = static_cast<PackageTarget *>(data);
+    const auto now = std::chrono::steady_clock::now();
+    if (!package_target->transfer_running) {
+        // librepo reports the progress of the request as soon as it is started, before the connection
+        // is established. A request waiting for a free connection was not started yet.
+        if (downloaded == 0) {
+            package_target->transfer_start = now;
+        }
+        package_target->transfer_running = true;
+    }
+    if (downloaded > 0 && package_target->first_byte == std::chrono::steady_clock::time_point{}) {
+        package_target->first_byte = now;
+    }
     if (auto * download_callbacks = package_target->package.get_base()->get_download_callbacks()) {
         return download_callbacks->progress(package_target->user_cb_data, total_to_download, downloaded);
     }
     return 0;
 }
 
+// Returns the path of the package object in the content-addressed package store.
+// The path is empty if the package checksum cannot be used as the object key.
+static std::filesystem::path get_store_object_path(
+    const std::filesystem::path & store_dir, const libdnf5::rpm::Package & package) {
+    const auto checksum = package.get_checksum();
+    const auto & hex = checksum.get_checksum();
+    if (checksum.get_type() == libdnf5::rpm::Checksum::Type::UNKNOWN || hex.size() <= 2) {
+        return {};
+    }
+    return store_dir / checksum.get_type_str() / hex.substr(0, 2) / hex.substr(2);
+}
+
+// Returns the path where the package of the `target` is downloaded.
+static std::filesystem::path get_destination_path(const PackageTarget & target) {
+    return std::filesystem::path(target.destination) / std::filesystem::path(target.package.get_location()).filename();
+}
+
+// Places the package from the store at its destination. Returns false if the store does not contain it.
+// The object name is the checksum verified when the download was added to the store and objects are never
+// modified in place, so the content is not hashed again. An object of a wrong size is removed so that the next
+// download replaces it.
+static bool place_from_store(const std::filesystem::path & object, const PackageTarget & target, Logger & logger) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(object, ec);
+    if (ec) {
+        return false;
+    }
+    if (size != target.package.get_download_size()) {
+        logger.warning("Removing package \"{}\" with a wrong size from the package store", object.string());
+        std::filesystem::remove(object, ec);
+        return false;
+    }
+    const auto destination = get_destination_path(target);
+    if (std::filesystem::equivalent(object, destination, ec)) {
+        return true;
+    }
+    // the destination may contain a partially downloaded or a different file
+    std::filesystem::remove(destination, ec);
+    std::filesystem::create_hard_link(object, destination, ec);
+    if (ec) {
+        // the destination is on another filesystem than the store, a local copy is still cheaper than a transfer
+        utils::fs::reflink_or_copy(object, destination, ec);
+    }
+    return !ec;
+}
+
+// Adds the downloaded package to the store. The object is a hard link to the download, so both share the same
+// data and the store takes no additional space. The file is made read-only, the store and the destinations
+// never modify it in place. Concurrent writers are safe, linking to an existing object fails and keeps it.
+static void add_to_store(const std::filesystem::path & object, const PackageTarget & target, Logger & logger) {
+    std::error_code ec;
+    if (std::filesystem::exists(object, ec)) {
+        return;
+    }
+    const auto source = get_destination_path(target);
+    std::filesystem::create_directories(object.parent_path(), ec);
+    std::filesystem::permissions(
+        source,
+        std::filesystem::perms::owner_read | std::filesystem::perms::group_read | std::filesystem::perms::others_read,
+        std::filesystem::perm_options::replace,
+        ec);
+    if (!ec) {
+        std::filesystem::create_hard_link(source, object, ec);
+    }
+    if (ec && ec != std::errc::file_exists) {
+        logger.warning(
+            "Cannot add package \"{}\" to the package store \"{}\": {}",
+            source.string(),
+            object.string(),
+            ec.message());
+    }
+}
+
 static int mirror_failure_callback(void * data, const char * msg, const char * url) {
     libdnf_assert(data != nullptr, "data in callback must be set");
 
     auto * package_target = static_cast<PackageTarget *>(data);
+    if (url) {
+        package_target->failed_urls.emplace_back(url);
+    }
+    // the request to the next mirror is sent right away, measure it from now
+    package_target->transfer_start = std::chrono::steady_clock::now();
+    package_target->first_byte = {};
+    package_target->transfer_running = false;
     if (auto * download_callbacks = package_target->package.get_base()->get_download_callbacks()) {
         return download_callbacks->mirror_failure(package_target->user_cb_data, msg, url, nullptr);
     }
     return 0;
 }
 
+// Records the outcome of the package transfers in the mirror health store.
+static void save_mirror_health(
+    const BaseWeakPtr & base,
+    const std::vector<PackageTarget *> & remote_targets,
+    const std::vector<std::unique_ptr<LrPackageTarget>> & lr_targets) {
+    std::optional<MirrorHealth> mirror_health;
+    for (std::size_t idx = 0; idx < remote_targets.size(); ++idx) {
+        auto & target = *remote_targets[idx];
+        auto repo = target.package.get_repo();
+        auto max_age = RepoDownloader::get_mirror_health_max_age(repo->get_config());
+        if (max_age == 0) {
+            continue;
+        }
+        if (!mirror_health) {
+            mirror_health.emplace(base, base->get_config().get_cachedir_option().get_value(), max_age);
+        }
+
+        const auto mirrors = RepoDownloader::get_mirror_urls(*repo);
+        for (const auto & url : target.failed_urls) {
+            mirror_health->add_failure(MirrorHealth::find_mirror(url, mirrors));
+        }
+        const auto * used_mirror = lr_targets[idx]->usedmirror;
+        if (!target.transfer_failed && used_mirror && target.first_byte != std::chrono::steady_clock::time_point{}) {
+            const std::chrono::duration<double> rtt = target.first_byte - target.transfer_start;
+            const std::chrono::duration<double> transfer_time = target.transfer_end - target.first_byte;
+            const auto size = static_cast<double>(target.package.get_download_size());
+            mirror_health->add_success(
+                used_mirror, rtt.count(), transfer_time.count() > 0 ? size / transfer_time.count() : 0);
+        }
+    }
+    if (mirror_health) {
+        mirror_health->save();
+    }
+}
+
 
 class PackageDownloader::Impl {
 public:
@@ -124,6 +262,10 @@ private:
     std::optional<bool> keep_packages;
     bool fail_fast;
     bool resume;
+
+    // packages placed from the package store in the last download() call
+    std::size_t store_reused_count{0};
+    unsigned long long store_reused_bytes{0};
 };
 
 
@@ -148,6 +290,8 @@ void PackageDownloader::download() try {
     for (auto & target : p_impl->targets) {
         target.transfer_failed = false;
     }
+    p_impl->store_reused_count = 0;
+    p_impl->store_reused_bytes = 0;
     if (p_impl->targets.empty()) {
         return;
     }
@@ -156,9 +300,16 @@ void PackageDownloader::download() try {
     auto use_cache_only = config.get_cacheonly_option().get_value() == "all";
     GError * err{nullptr};
 
+    std::filesystem::path store_dir;
+    if (!config.get_package_store_dir_option().empty()) {
+        store_dir = config.get_package_store_dir_option().get_value();
+    }
+
     std::vector<std::unique_ptr<LrPackageTarget>> lr_targets;
     lr_targets.reserve(p_impl->targets.size());
     std::vector<PackageTarget *> local_targets;
+    std::vector<PackageTarget *> store_targets;
+    std::vector<PackageTarget *> remote_targets;
     for (auto & pkg_target : p_impl->targets) {
         if (use_cache_only && !pkg_target.package.is_available_locally()) {
             throw RepoCacheonlyError(
@@ -185,6 +336,21 @@ void PackageDownloader::download() try {
             continue;
         }
 
+        if (!store_dir.empty()) {
+            const auto object = get_store_object_path(store_dir, pkg_target.package);
+            if (!object.empty() && place_from_store(object, pkg_target, *p_impl->base->get_logger())) {
+                // The `end` callback is called later for the same reason as for the local package targets.
+                store_targets.push_back(&pkg_target);
+                continue;
+            }
+            // A destination with more links may be another store object, librepo must not overwrite it in place
+            const auto destination = get_destination_path(pkg_target);
+            std::error_code ec;
+            if (std::filesystem::hard_link_count(destination, ec) > 1 && !ec) {
+                std::filesystem::remove(destination, ec);
+            }
+        }
+
         // Disable fastest_mirror callbacks for package downloading for now
         // TODO(amatej): There is a problem in the API, libdnf5::repo::DownloadCallbacks::fastest_mirror interface
         //               expects user_cb_data created by libdnf5::repo::DownloadCallbacks::add_new_download, these
@@ -228,6 +394,7 @@ void PackageDownloader::download() try {
         }
 
         lr_targets.emplace_back(lr_target);
+        remote_targets.push_back(&pkg_target);
     }
 
     for (auto * local_pkg_target : local_targets) {
@@ -262,6 +429,18 @@ void PackageDownloader::download() try {
         }
     }
 
+    for (auto * store_pkg_target : store_targets) {
+        ++p_impl->store_reused_count;
+        p_impl->store_reused_bytes += store_pkg_target->package.get_download_size();
+        if (auto * download_callbacks = store_pkg_target->package.get_base()->get_download_callbacks()) {
+            store_pkg_target->need_call_end_callback = false;
+            download_callbacks->end(
+                store_pkg_target->user_cb_data,
+                DownloadCallbacks::TransferStatus::ALREADYEXISTS,
+                _("Linked from the package store"));
+        }
+    }
+
     // Adding items to the end of GSList is slow. We go from the back and add items to the beginning.
     GSList * list{nullptr};
     for (auto it = lr_targets.rbegin(); it != lr_targets.rend(); ++it) {
@@ -294,9 +473,30 @@ void PackageDownloader::download() try {
         temp_files_memory.add_files(package_paths);
     }
 
-    if (!lr_download_packages(list, flags, &err)) {
+    const auto download_start = std::chrono::steady_clock::now();
+    for (auto * remote_pkg_target : remote_targets) {
+        remote_pkg_target->transfer_start = download_start;
+        remote_pkg_target->first_byte = {};
+        remote_pkg_target->transfer_running = false;
+        remote_pkg_target->failed_urls.clear();
+    }
+    auto download_ok = lr_download_packages(list, flags, &err);
+    save_mirror_health(p_impl->base, remote_targets, lr_targets);
+    if (!download_ok) {
         throw LibrepoError(std::unique_ptr<GError>(err));
     }
+
+    if (!store_dir.empty()) {
+        auto & logger = *p_impl->base->get_logger();
+        for (const auto * remote_pkg_target : remote_targets) {
+            if (remote_pkg_target->transfer_failed) {
+                continue;
+            }
+            if (const auto object = get_store_object_path(store_dir, remote_pkg_target->package); !object.empty()) {
+                add_to_store(object, *remote_pkg_target, logger);
+            }
+        }
+    }
 } catch (const RepoCacheonlyError & e) {
     throw;
 } catch (const std::runtime_error & e) {
@@ -313,6 +513,14 @@ std::vector<libdnf5::rpm::Package> PackageDownloader::get_failed_packages() cons
     return failed;
 }
 
+std::size_t PackageDownloader::get_store_reused_count() const noexcept {
+    return p_impl->store_reused_count;
+}
+
+unsigned long long PackageDownloader::get_store_reused_bytes() const noexcept {
+    return p_impl->store_reused_bytes;
+}
+
 void PackageDownloader::set_fail_fast(bool value) {
     p_impl->fail_fast = value;
 }
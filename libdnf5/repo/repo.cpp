@@ -52,6 +52,7 @@ extern "C" {
 #include <cerrno>
 #include <cstring>
 #include <ctime>
+#include <exception>
 #include <filesystem>
 #include <set>
 
@@ -263,7 +264,7 @@ void Repo::load() {
     }
 
     p_impl->solv_repo->set_needs_internalizing();
-    p_impl->base->get_rpm_package_sack()->p_impl->invalidate_provides();
+    p_impl->base->get_rpm_package_sack()->p_impl->invalidate_provides_appended();
 }
 
 void Repo::add_libsolv_testcase(const std::string & path) {
@@ -273,7 +274,7 @@ void Repo::add_libsolv_testcase(const std::string & path) {
     testcase_add_testtags(p_impl->solv_repo->repo, testcase_file.get(), 0);
 
     p_impl->solv_repo->set_needs_internalizing();
-    p_impl->base->get_rpm_package_sack()->p_impl->invalidate_provides();
+    p_impl->base->get_rpm_package_sack()->p_impl->invalidate_provides_appended();
 }
 
 bool Repo::get_use_includes() const {
@@ -512,7 +513,7 @@ void Repo::add_xml_comps(const std::string & path) {
         throw RepoCompsError(
             M_("Failed to load xml Comps \"{}\": {}"), path, std::string(pool_errstr(p_impl->solv_repo->repo->pool)));
     }
-    p_impl->base->get_rpm_package_sack()->p_impl->invalidate_provides();
+    p_impl->base->get_rpm_package_sack()->p_impl->invalidate_provides_appended();
 }
 
 rpm::Package Repo::add_rpm_package(const std::string & path, bool with_hdrid) {
@@ -532,12 +533,48 @@ rpm::Package Repo::add_rpm_package(const std::string & path, bool with_hdrid) {
     }
 
     p_impl->solv_repo->set_needs_internalizing();
-    p_impl->base->get_rpm_package_sack()->p_impl->invalidate_provides();
+    p_impl->base->get_rpm_package_sack()->p_impl->invalidate_provides_appended();
 
     return rpm::Package(p_impl->base, rpm::PackageId(new_id));
 }
 
 
+std::vector<rpm::Package> Repo::add_rpm_packages(const std::vector<std::string> & paths, bool with_hdrid) {
+    if (paths.size() == 1) {
+        return {add_rpm_package(paths.front(), with_hdrid)};
+    }
+
+    // The packages preceding the first unreadable file are added before throwing the error,
+    // the same way as when the packages are added one by one.
+    std::vector<std::string> readable_paths;
+    std::exception_ptr unreadable_error;
+    for (const auto & path : paths) {
+        try {
+            is_readable_rpm(path);
+        } catch (const RepoRpmError &) {
+            unreadable_error = std::current_exception();
+            break;
+        }
+        readable_paths.push_back(path);
+    }
+
+    std::vector<rpm::Package> packages;
+    if (!readable_paths.empty()) {
+        make_solv_repo();
+        p_impl->base->get_rpm_package_sack()->p_impl->invalidate_provides_appended();
+        for (const auto id : p_impl->solv_repo->add_rpm_packages(readable_paths, with_hdrid)) {
+            packages.emplace_back(p_impl->base, rpm::PackageId(id));
+        }
+    }
+
+    if (unreadable_error) {
+        std::rethrow_exception(unreadable_error);
+    }
+
+    return packages;
+}
+
+
 void Repo::internalize() {
     if (p_impl->solv_repo) {
         p_impl->solv_repo->internalize();
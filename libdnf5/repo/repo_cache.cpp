@@ -199,6 +199,65 @@ RepoCache::RemoveStatistics RepoCache::remove_solv_files() {
 }
 
 
+RepoCache::RemoveStatistics RepoCache::remove_rpm_headers() {
+    auto & log = *p_impl->base->get_logger();
+    auto status = p_impl->remove_recursive(p_impl->cache_dir / CACHE_SOLV_FILES_DIR / CACHE_RPM_HEADERS_DIR, log);
+    log.debug(
+        "RPM headers removal from repository cache in path \"{}\" complete. "
+        "Removed {} files, {} directories (total of {} bytes). {} errors",
+        p_impl->cache_dir.native(),
+        status.get_files_removed(),
+        status.get_dirs_removed(),
+        status.get_bytes_removed(),
+        status.get_errors());
+    return status;
+}
+
+
+RepoCache::RemoveStatistics RepoCache::remove_unused_store_packages(const libdnf5::BaseWeakPtr & base) {
+    RemoveStatistics status{};
+    const auto & store_dir_option = base->get_config().get_package_store_dir_option();
+    if (store_dir_option.empty()) {
+        return status;
+    }
+    const std::filesystem::path store_dir{store_dir_option.get_value()};
+    auto & log = *base->get_logger();
+
+    // Objects are stored as <store_dir>/<checksum type>/<first two digits>/<remaining digits>. Every destination
+    // of a package is a hard link to the object, an object with a single link is not used by any of them.
+    std::error_code ec;
+    for (const auto & type_dir : std::filesystem::directory_iterator(store_dir, ec)) {
+        if (!type_dir.is_directory(ec) || type_dir.is_symlink(ec)) {
+            continue;
+        }
+        for (const auto & prefix_dir : std::filesystem::directory_iterator(type_dir.path(), ec)) {
+            if (!prefix_dir.is_directory(ec) || prefix_dir.is_symlink(ec)) {
+                continue;
+            }
+            for (const auto & object : std::filesystem::directory_iterator(prefix_dir.path(), ec)) {
+                if (object.is_regular_file(ec) && object.hard_link_count(ec) == 1 && !ec) {
+                    status.p_impl->files_removed +=
+                        remove(object.path(), status.p_impl->errors, status.p_impl->bytes_removed, log);
+                }
+            }
+            if (std::filesystem::is_empty(prefix_dir.path(), ec) && !ec) {
+                status.p_impl->dirs_removed +=
+                    remove(prefix_dir.path(), status.p_impl->errors, status.p_impl->bytes_removed, log);
+            }
+        }
+    }
+    log.debug(
+        "Unused packages removal from package store in path \"{}\" complete. "
+        "Removed {} files, {} directories (total of {} bytes). {} errors",
+        store_dir.native(),
+        status.get_files_removed(),
+        status.get_dirs_removed(),
+        status.get_bytes_removed(),
+        status.get_errors());
+    return status;
+}
+
+
 RepoCache::RemoveStatistics RepoCache::remove_all() {
     auto & log = *p_impl->base->get_logger();
     auto status = remove_metadata();
@@ -24,6 +24,9 @@
 #include "libdnf5/repo/repo_cache.hpp"
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
 
+#include <chrono>
+#include <cstdint>
+
 
 namespace libdnf5::repo {
 
@@ -33,6 +36,11 @@ namespace {
 constexpr const char * CACHE_METADATA_DIR = "repodata";
 constexpr const char * CACHE_PACKAGES_DIR = "packages";
 constexpr const char * CACHE_SOLV_FILES_DIR = "solv";
+constexpr const char * CACHE_RPM_HEADERS_DIR = "rpm-headers";  // inside CACHE_SOLV_FILES_DIR
+// Limits of the RPM headers cache. Headers not used for longer than the maximum age are removed,
+// then the least recently used ones until the cache fits the maximum size.
+constexpr std::uintmax_t CACHE_RPM_HEADERS_MAX_SIZE = 64 * 1024 * 1024;
+constexpr std::chrono::hours CACHE_RPM_HEADERS_MAX_AGE{30 * 24};
 constexpr const char * CACHE_METALINK_FILE = "metalink.xml";
 constexpr const char * CACHE_MIRRORLIST_FILE = "mirrorlist";
 
@@ -19,6 +19,7 @@
 
 #include "repo_downloader.hpp"
 
+#include "mirror_health.hpp"
 #include "repo_pgp.hpp"
 #include "utils/fs/utils.hpp"
 #include "utils/string.hpp"
@@ -199,6 +200,9 @@ int RepoDownloader::mirror_failure_cb(void * data, const char * msg, const char
         return 0;
     }
     auto download_callback_data = static_cast<CallbackData *>(data);
+    if (url) {
+        download_callback_data->failed_urls.emplace_back(url);
+    }
     if (auto * download_callbacks = download_callback_data->repo->get_base()->get_download_callbacks()) {
         // In this callback type we don't have the `metadata` type, pass NULL instead. The dnf5 callback accounts for this.
         return download_callbacks->mirror_failure(download_callback_data->user_cb_data, msg, url, NULL);
@@ -213,6 +217,9 @@ int RepoDownloader::mirror_failure_cb(
     }
 
     auto download_callback_data = static_cast<CallbackData *>(data);
+    if (url) {
+        download_callback_data->failed_urls.emplace_back(url);
+    }
     if (auto * download_callbacks = download_callback_data->repo->get_base()->get_download_callbacks()) {
         return download_callbacks->mirror_failure(download_callback_data->user_cb_data, msg, url, metadata);
     }
@@ -251,6 +258,7 @@ void RepoDownloader::add(
     }
 
     download_data.handle = init_remote_handle(*cbd.repo, cbd.temp_download_target->get_path().c_str(), true);
+    download_data.handle_mirrors_sorted = false;
     download_data.handle->set_opt(LRO_FASTESTMIRRORCB, static_cast<LrFastestMirrorCb>(fastest_mirror_cb));
     add_countme_flag(download_data, *download_data.handle);
 
@@ -269,8 +277,19 @@ void RepoDownloader::add(
     libdnf5::throw_with_nested(RepoDownloadError(M_("Failed to set up metadata download")));
 }
 
+void RepoDownloader::setup_full_download(CallbackData & cbd) {
+    auto & download_data = cbd.repo->get_download_data();
+    // Configure handle to download all the needed metadata
+    download_data.handle->set_opt(LRO_FETCHMIRRORS, 0L);
+    configure_handle_dlist(*download_data.handle, download_data.get_optional_metadata());
+
+    cbd.lr_target->endcb = end_cb_full_download;
+    cbd.lr_target->cbdata = &cbd;
+    download_data.handle->set_opt(LRO_FASTESTMIRRORDATA, &cbd);
+}
+
 std::tuple<std::unordered_map<Repo *, std::vector<std::string>>, bool>
-RepoDownloader::download_repos_descriptions() try {
+RepoDownloader::download_repos_descriptions(bool download_missing) try {
     if (callback_data.empty()) {
         return {};
     }
@@ -279,6 +298,11 @@ RepoDownloader::download_repos_descriptions() try {
     for (auto & cbd : callback_data) {
         // If there is currently no metadata it cannot be up to date
         if (cbd.repo->get_download_data().get_metadata_path(RepoDownloader::MD_FILENAME_PRIMARY).empty()) {
+            if (download_missing) {
+                setup_full_download(cbd);
+                cbd.is_downloaded = true;
+                list = g_slist_prepend(list, cbd.lr_target.get());
+            }
             continue;
         }
 
@@ -301,7 +325,9 @@ RepoDownloader::download_repos_descriptions() try {
     std::unique_ptr<GSList, decltype(&g_slist_free)> list_holder(list, &g_slist_free);
 
     GError * err{nullptr};
-    if (!lr_download_metadata(list, &err)) {
+    auto download_ok = lr_download_metadata(list, &err);
+    save_mirror_failures();
+    if (!download_ok) {
         throw LibrepoError(std::unique_ptr<GError>(err));
     }
 
@@ -335,30 +361,31 @@ std::unordered_map<Repo *, std::vector<std::string>> RepoDownloader::download()
 
     GSList * list{nullptr};
     for (auto & cbd : callback_data) {
-        // Don't download repositories that are already in sync
-        if (cbd.is_in_sync) {
+        // Don't download repositories that are already in sync or downloaded with the repos descriptions
+        if (cbd.is_in_sync || cbd.is_downloaded) {
             continue;
         }
-        auto & download_data = cbd.repo->get_download_data();
-        // Configure handle to download all the needed metadata
-        download_data.handle->set_opt(LRO_FETCHMIRRORS, 0L);
-        configure_handle_dlist(*download_data.handle, download_data.get_optional_metadata());
-
-        cbd.lr_target->endcb = end_cb_full_download;
-        cbd.lr_target->cbdata = &cbd;
-        download_data.handle->set_opt(LRO_FASTESTMIRRORDATA, &cbd);
-
+        setup_full_download(cbd);
         list = g_slist_prepend(list, cbd.lr_target.get());
     }
+    if (!list) {
+        return {};
+    }
     std::unique_ptr<GSList, decltype(&g_slist_free)> list_holder(list, &g_slist_free);
 
     GError * err{nullptr};
-    if (!lr_download_metadata(list, &err)) {
+    auto download_ok = lr_download_metadata(list, &err);
+    save_mirror_failures();
+    if (!download_ok) {
         throw LibrepoError(std::unique_ptr<GError>(err));
     }
 
     std::unordered_map<Repo *, std::vector<std::string>> per_repo_errors;
     for (auto & cbd : callback_data) {
+        // The errors of these were already returned by download_repos_descriptions()
+        if (cbd.is_in_sync || cbd.is_downloaded) {
+            continue;
+        }
         std::vector<std::string> errors;
         for (GList * err = cbd.lr_target->err; err; err = g_list_next(err)) {
             gchar * err_msg = (gchar *)err->data;
@@ -373,6 +400,30 @@ std::unordered_map<Repo *, std::vector<std::string>> RepoDownloader::download()
     libdnf5::throw_with_nested(RepoDownloadError(M_("Failed to download metadata")));
 }
 
+void RepoDownloader::save_mirror_failures() {
+    std::optional<MirrorHealth> mirror_health;
+    for (auto & cbd : callback_data) {
+        if (cbd.failed_urls.empty()) {
+            continue;
+        }
+        auto & config = cbd.repo->get_config();
+        if (auto max_age = get_mirror_health_max_age(config); max_age != 0) {
+            if (!mirror_health) {
+                mirror_health.emplace(
+                    cbd.repo->get_base(), config.get_main_config().get_cachedir_option().get_value(), max_age);
+            }
+            const auto mirrors = get_mirror_urls(*cbd.repo);
+            for (const auto & url : cbd.failed_urls) {
+                mirror_health->add_failure(MirrorHealth::find_mirror(url, mirrors));
+            }
+        }
+        cbd.failed_urls.clear();
+    }
+    if (mirror_health) {
+        mirror_health->save();
+    }
+}
+
 // Use metalink to check whether our metadata are still current.
 bool RepoDownloader::is_metalink_in_sync(Repo & repo, LrMetalink * metalink) try {
     auto & download_data = repo.get_download_data();
@@ -532,13 +583,31 @@ void RepoDownloader::load_local(DownloadData & download_data) try {
 //              (eg metalink) we won't know about it.
 LibrepoHandle & RepoDownloader::get_cached_handle(Repo & repo) {
     auto & donwload_data = repo.get_download_data();
-    if (!donwload_data.handle) {
-        donwload_data.handle = RepoDownloader::init_remote_handle(repo, nullptr, true);
+    // With known mirrors, use them ordered by their health instead of resolving the mirrorlist again
+    const bool sort_mirrors =
+        !donwload_data.mirrors.empty() && get_mirror_health_max_age(donwload_data.config) != 0;
+    if (!donwload_data.handle || (sort_mirrors && !donwload_data.handle_mirrors_sorted)) {
+        donwload_data.handle = RepoDownloader::init_remote_handle(repo, nullptr, !sort_mirrors);
+        donwload_data.handle_mirrors_sorted = sort_mirrors;
     }
     apply_http_headers(donwload_data, *donwload_data.handle);
     return *donwload_data.handle;
 }
 
+std::int64_t RepoDownloader::get_mirror_health_max_age(const ConfigRepo & config) {
+    if (config.get_fastestmirror_option().get_value()) {
+        return 0;
+    }
+    return config.get_main_config().get_mirror_health_max_age_option().get_value();
+}
+
+std::vector<std::string> RepoDownloader::get_mirror_urls(const Repo & repo) {
+    auto mirror_urls = repo.get_mirrors();
+    const auto & baseurls = repo.get_config().get_baseurl_option().get_value();
+    mirror_urls.insert(mirror_urls.end(), baseurls.begin(), baseurls.end());
+    return mirror_urls;
+}
+
 LibrepoHandle RepoDownloader::init_local_handle(const DownloadData & download_data) {
     LibrepoHandle h;
 
@@ -593,10 +662,31 @@ LibrepoHandle RepoDownloader::init_remote_handle(Repo & repo, const char * destd
             }
             fastest_mirror_cache_dir += "fastestmirror.cache";
             h.set_opt(LRO_FASTESTMIRRORCACHE, fastest_mirror_cache_dir.c_str());
+
+            // librepo fetches the metalink or mirrorlist itself (the metalink carries the repomd checksums)
+            // and tries the LRO_URLS before the fetched mirrors. Put the healthy mirrors known from
+            // the last resolved list there, so they are tried first in the health order.
+            if (auto max_age = get_mirror_health_max_age(config); max_age != 0 && !download_data.mirrors.empty()) {
+                const auto & cachedir = config.get_main_config().get_cachedir_option().get_value();
+                auto healthy_mirrors =
+                    MirrorHealth(download_data.base, cachedir, max_age).get_healthy_mirrors(download_data.mirrors);
+                if (!healthy_mirrors.empty()) {
+                    std::vector<const char *> c_mirrors(healthy_mirrors.size() + 1, nullptr);
+                    str_vector_to_char_array(healthy_mirrors, c_mirrors.data());
+                    h.set_opt(LRO_URLS, c_mirrors.data());
+                }
+            }
         } else {
             // use already resolved mirror list
-            std::vector<const char *> c_mirrors(download_data.mirrors.size() + 1, nullptr);
-            str_vector_to_char_array(download_data.mirrors, c_mirrors.data());
+            std::vector<std::string> mirrors;
+            if (auto max_age = get_mirror_health_max_age(config); max_age != 0) {
+                const auto & cachedir = config.get_main_config().get_cachedir_option().get_value();
+                mirrors = MirrorHealth(download_data.base, cachedir, max_age).sort_mirrors(download_data.mirrors);
+            } else {
+                mirrors = download_data.mirrors;
+            }
+            std::vector<const char *> c_mirrors(mirrors.size() + 1, nullptr);
+            str_vector_to_char_array(mirrors, c_mirrors.data());
             h.set_opt(LRO_URLS, c_mirrors.data());
         }
     } else if (!config.get_baseurl_option().get_value().empty()) {
@@ -63,6 +63,13 @@ public:
     static void load_local(DownloadData & download_data);
     static LibrepoHandle & get_cached_handle(Repo & repo);
 
+    /// Returns the maximum age of the mirror health records or 0 if ordering of the mirrors
+    /// of the repo by their health is disabled (also the case when librepo picks the fastest mirror).
+    static std::int64_t get_mirror_health_max_age(const ConfigRepo & config);
+
+    /// Returns the known mirrors of the repo followed by its baseurls.
+    static std::vector<std::string> get_mirror_urls(const Repo & repo);
+
     /// Adds repos for which metadata will be downloaded in parallel
     void add(libdnf5::repo::Repo & repo, const std::string & destdir, std::function<repo_loading_func> load_repo);
 
@@ -70,14 +77,19 @@ public:
     // checks with local files if the repo needs to be downloaded.
     // If the repo is determined to be in sync it won't be downloaded
     // during the download() call.
+    // Repos without any local metadata cannot be in sync. With `download_missing`
+    // they are fully downloaded (and handed to their loading function) in the same
+    // batch, so their download and loading overlap with the checks of the others.
     // It returns a map with errors and a single bool signifying if
     // all the added repos are in sync or not.
     // NOTE(amatej): If the API should become public we might
     // want to change it so that its possible to tell which
     // repos will be downloaded in the following download() call.
-    std::tuple<std::unordered_map<Repo *, std::vector<std::string>>, bool> download_repos_descriptions();
+    std::tuple<std::unordered_map<Repo *, std::vector<std::string>>, bool> download_repos_descriptions(
+        bool download_missing = false);
 
-    // Download the previously added repos.
+    // Download the previously added repos that are neither in sync nor already
+    // downloaded by download_repos_descriptions().
     std::unordered_map<Repo *, std::vector<std::string>> download();
 
     void set_suppress_keyring_errors(bool suppress) { suppress_keyring_errors = suppress; }
@@ -94,7 +106,9 @@ private:
         RepoWeakPtr repo;
         std::unique_ptr<LrMetadataTarget> lr_target;
         bool is_in_sync;
+        bool is_downloaded{false};
         bool suppress_keyring_errors{false};
+        std::vector<std::string> failed_urls;
     };
 
     static LibrepoHandle init_local_handle(const DownloadData & download_data);
@@ -104,6 +118,8 @@ private:
     static void add_countme_flag(DownloadData & download_data, LibrepoHandle & handle);
     static time_t get_system_epoch();
     static void configure_handle_dlist(LibrepoHandle & handle, std::set<std::string> && optional_metadata);
+    static void setup_full_download(CallbackData & cbd);
+    void save_mirror_failures();
 
     static int end_cb_full_download(void * data, LrTransferStatus status, const char * msg);
     static int end_cb_sync_check(void * data, LrTransferStatus status, const char * msg);
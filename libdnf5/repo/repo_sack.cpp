@@ -61,7 +61,9 @@ extern "C" {
 #include <filesystem>
 #include <mutex>
 #include <sstream>
+#include <string_view>
 #include <thread>
+#include <unordered_set>
 
 
 using LibsolvRepo = ::Repo;
@@ -282,6 +284,11 @@ std::map<std::string, libdnf5::rpm::Package> RepoSack::add_cmdline_packages(
     // map a path from the input paths to a Package object created in the cmdline repo
     std::map<std::string, libdnf5::rpm::Package> path_to_package;
 
+    // input paths and the files to fill the command line repo with, in the same order
+    std::vector<std::string> input_paths;
+    std::vector<std::string> files;
+    std::unordered_set<std::string_view> seen_input_paths;
+
     if (!url_to_path.empty()) {
         auto & logger = *p_impl->base->get_logger();
         // download remote URLs
@@ -295,17 +302,25 @@ std::map<std::string, libdnf5::rpm::Package> RepoSack::add_cmdline_packages(
 
         // fill the command line repo with downloaded URLs
         for (const auto & [url, path] : url_to_path) {
-            path_to_package.emplace(url, cmdline_repo->add_rpm_package(path.string(), calculate_checksum));
+            seen_input_paths.insert(url);
+            input_paths.emplace_back(url);
+            files.emplace_back(path.string());
         }
     }
 
     // fill the command line repo with local files
     for (const auto & path : rpm_filepaths) {
-        if (!path_to_package.contains(path)) {
-            path_to_package.emplace(path, cmdline_repo->add_rpm_package(path, calculate_checksum));
+        if (seen_input_paths.insert(path).second) {
+            input_paths.emplace_back(path);
+            files.emplace_back(path);
         }
     }
 
+    auto packages = cmdline_repo->add_rpm_packages(files, calculate_checksum);
+    for (std::size_t idx = 0; idx < packages.size(); ++idx) {
+        path_to_package.emplace(std::move(input_paths[idx]), std::move(packages[idx]));
+    }
+
     if (!path_to_package.empty()) {
         p_impl->base->get_rpm_package_sack()->load_config_excludes_includes();
     }
@@ -391,6 +406,8 @@ void RepoSack::Impl::report_parallel_download_errors(
 void RepoSack::Impl::update_and_load_repos(libdnf5::repo::RepoQuery & repos, bool import_keys) {
     libdnf_user_assert(!repos_updated_and_loaded, "RepoSack::updated_and_load_repos has already been called.");
 
+    base::Tracer::Scope trace(base->get_tracer(), "load_repos");
+
     auto logger = base->get_logger();
 
     std::atomic<bool> except_in_main_thread{false};  // set to true if an exception occurred in the main thread
@@ -419,7 +436,10 @@ void RepoSack::Impl::update_and_load_repos(libdnf5::repo::RepoQuery & repos, boo
                     break;  // nullptr mark - work is done, or exception in main thread
                 }
 
-                repo->load();
+                {
+                    base::Tracer::Scope trace_repo(base->get_tracer(), "load_repo", repo->get_id());
+                    repo->load();
+                }
                 ++num_repos_loaded;
             }
         } catch (std::runtime_error & ex) {
@@ -654,8 +674,10 @@ void RepoSack::Impl::update_and_load_repos(libdnf5::repo::RepoQuery & repos, boo
 
         // Prepares repositories that are expired but match the original.
         // Downloads only metalink/repomd and checks if given repo is still in sync.
+        // Repositories without metadata are downloaded in the same batch, each one is passed
+        // to thread_sack_loader from the end callback of its own download.
         report_parallel_download_errors(
-            std::get<0>(repo_downloader.download_repos_descriptions()), import_keys, repo_signature_errors);
+            std::get<0>(repo_downloader.download_repos_descriptions(true)), import_keys, repo_signature_errors);
 
         catch_thread_sack_loader_exceptions();
 
@@ -25,6 +25,8 @@
 #include "solv/pool.hpp"
 
 #include "libdnf5/base/base.hpp"
+#include "libdnf5/comps/comps_sack.hpp"
+#include "libdnf5/repo/repo_errors.hpp"
 #include "libdnf5/utils/bgettext/bgettext-mark-domain.h"
 #include "libdnf5/utils/fs/temp.hpp"
 #include "libdnf5/utils/to_underlying.hpp"
@@ -41,6 +43,14 @@ extern "C" {
 #include <solv/repo_write.h>
 }
 
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <future>
+#include <optional>
+#include <span>
+#include <thread>
+
 
 namespace libdnf5::repo {
 
@@ -50,6 +60,13 @@ namespace fs = libdnf5::utils::fs;
 constexpr auto CHKSUM_TYPE = REPOKEY_TYPE_SHA256;
 constexpr const char * CHKSUM_IDENT = "H000";
 
+// Name of the .solvx extension with the file provides added to the solvables of the main cache
+constexpr const char * FILEPROVIDES_TYPE_NAME = "fileprovides";
+// Repodata key with the file provides of a solvable in the file provides extension
+constexpr const char * FILEPROVIDES_KEY_NAME = "dnf:fileprovides";
+// Repodata meta key with the set of files the file provides extension was computed for
+constexpr const char * ADDEDFILEPROVIDES_KEY_NAME = "dnf:addedfileprovides";
+
 
 static std::array<char, SOLV_USERDATA_SOLV_TOOLVERSION_SIZE> get_padded_solv_toolversion() {
     std::array<char, SOLV_USERDATA_SOLV_TOOLVERSION_SIZE> padded_solv_toolversion{};
@@ -59,7 +76,7 @@ static std::array<char, SOLV_USERDATA_SOLV_TOOLVERSION_SIZE> get_padded_solv_too
     return padded_solv_toolversion;
 }
 
-void SolvRepo::userdata_fill(SolvUserdata * userdata) {
+static void fill_userdata(SolvUserdata * userdata, const unsigned char * checksum) {
     if (strlen(solv_toolversion) > SOLV_USERDATA_SOLV_TOOLVERSION_SIZE) {
         libdnf_throw_assertion(
             "Libsolv's solv_toolvesion is: {} long but we expect max of: {}",
@@ -73,6 +90,285 @@ void SolvRepo::userdata_fill(SolvUserdata * userdata) {
     memcpy(userdata->checksum, checksum, CHKSUM_BYTES);
 }
 
+void SolvRepo::userdata_fill(SolvUserdata * userdata) {
+    fill_userdata(userdata, checksum);
+}
+
+
+namespace {
+
+// Minimum number of RPM files read by one worker of SolvRepo::add_rpm_packages().
+constexpr std::size_t RPM_FILES_PER_WORKER = 16;
+
+// Packages read by one worker of SolvRepo::add_rpm_packages() from a contiguous range of paths.
+struct StagedRpmPackages {
+    std::optional<fs::TempFile> solv_file;  // staging repository written as a solv file, unset if empty
+    std::size_t count{0};                   // number of packages read from the beginning of the range
+    std::string error;                      // error reading the file following the read ones, empty on success
+};
+
+// Fills the userdata identifying the cached header of the RPM file. Returns false if the file cannot be stat()ed.
+// The ctime is part of the key because the mtime can be preserved or set back when a file is rewritten in place
+// (cp -p, touch -r, rsync -t), while every change of the content or the mtime sets the ctime to the current time.
+bool rpm_header_cache_userdata(const std::string & path, bool with_hdrid, SolvUserdata & userdata) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return false;
+    }
+    const auto stamp = fmt::format(
+        "{}\n{}:{}:{}.{:09}:{}.{:09}:{}:{}",
+        path,
+        st.st_dev,
+        st.st_ino,
+        st.st_mtim.tv_sec,
+        st.st_mtim.tv_nsec,
+        st.st_ctim.tv_sec,
+        st.st_ctim.tv_nsec,
+        st.st_size,
+        with_hdrid);
+    unsigned char stamp_checksum[CHKSUM_BYTES];
+    auto * chksum = solv_chksum_create(CHKSUM_TYPE);
+    solv_chksum_add(chksum, stamp.data(), static_cast<int>(stamp.size()));
+    solv_chksum_free(chksum, stamp_checksum);
+    fill_userdata(&userdata, stamp_checksum);
+    return true;
+}
+
+std::filesystem::path rpm_header_cache_path(
+    const std::filesystem::path & cache_dir, const std::string & path, bool with_hdrid) {
+    return cache_dir / fmt::format("{:016x}{}.solv", std::hash<std::string>{}(path), with_hdrid ? "-hdrid" : "");
+}
+
+// Adds the package from the cached header into `repo`. Returns false if the cache does not match `userdata`.
+bool load_cached_rpm_header(::Repo * repo, const std::filesystem::path & cache_path, const SolvUserdata & userdata) {
+    fs::File cache_file;
+    try {
+        cache_file.open(cache_path, "r");
+    } catch (const FileSystemError &) {
+        return false;
+    }
+
+    unsigned char * userdata_read;
+    int userdata_len_read;
+    if (solv_read_userdata(cache_file.get(), &userdata_read, &userdata_len_read) != 0) {
+        return false;
+    }
+    const bool match = static_cast<std::size_t>(userdata_len_read) == SOLV_USERDATA_SIZE &&
+                       memcmp(userdata_read, &userdata, SOLV_USERDATA_SIZE) == 0;
+    solv_free(userdata_read);
+    if (!match) {
+        return false;
+    }
+
+    cache_file.rewind();
+    const auto nsolvables = repo->nsolvables;
+    if (repo_add_solv(repo, cache_file.get(), 0) != 0 || repo->nsolvables != nsolvables + 1) {
+        return false;
+    }
+    // the modification time marks the last use of the cached header for prune_rpm_header_cache()
+    std::error_code ec;
+    std::filesystem::last_write_time(cache_path, std::filesystem::file_time_type::clock::now(), ec);
+    return true;
+}
+
+// Removes cached headers not used for longer than CACHE_RPM_HEADERS_MAX_AGE, then the least recently
+// used ones until the cache fits into CACHE_RPM_HEADERS_MAX_SIZE.
+void prune_rpm_header_cache(const std::filesystem::path & cache_dir, Logger & logger) {
+    struct CachedHeader {
+        std::filesystem::path path;
+        std::filesystem::file_time_type last_use;
+        std::uintmax_t size;
+    };
+    std::vector<CachedHeader> cached_headers;
+    std::uintmax_t total_size{0};
+    std::size_t removed{0};
+    const auto oldest_kept = std::filesystem::file_time_type::clock::now() - CACHE_RPM_HEADERS_MAX_AGE;
+
+    std::error_code ec;
+    for (const auto & entry : std::filesystem::directory_iterator(cache_dir, ec)) {
+        // skip temporary files of writers
+        if (entry.path().extension() != ".solv") {
+            continue;
+        }
+        std::error_code entry_ec;
+        const auto last_use = entry.last_write_time(entry_ec);
+        const auto size = entry.file_size(entry_ec);
+        if (entry_ec) {
+            continue;
+        }
+        if (last_use < oldest_kept) {
+            if (std::filesystem::remove(entry.path(), entry_ec)) {
+                ++removed;
+            }
+            continue;
+        }
+        cached_headers.push_back({entry.path(), last_use, size});
+        total_size += size;
+    }
+
+    if (total_size > CACHE_RPM_HEADERS_MAX_SIZE) {
+        std::sort(cached_headers.begin(), cached_headers.end(), [](const auto & lhs, const auto & rhs) {
+            return lhs.last_use < rhs.last_use;
+        });
+        for (const auto & header : cached_headers) {
+            if (total_size <= CACHE_RPM_HEADERS_MAX_SIZE) {
+                break;
+            }
+            std::error_code remove_ec;
+            if (std::filesystem::remove(header.path, remove_ec)) {
+                ++removed;
+            }
+            total_size -= header.size;
+        }
+    }
+
+    if (removed > 0) {
+        logger.debug("Pruned {} entries from RPM headers cache \"{}\"", removed, cache_dir.native());
+    }
+}
+
+// Writes the header of the package `id` to the cache. Failures are ignored, the cache is an optimization only.
+void write_cached_rpm_header(
+    ::Repo * repo, Id id, const std::filesystem::path & cache_path, const SolvUserdata & userdata) {
+    try {
+        auto cache_tmp_file = fs::TempFile(cache_path.parent_path(), cache_path.filename());
+        auto & cache_file = cache_tmp_file.open_as_file("w+");
+        Repowriter * writer = repowriter_create(repo);
+        repowriter_set_userdata(writer, &userdata, SOLV_USERDATA_SIZE);
+        repowriter_set_solvablerange(writer, id, id + 1);
+        const int res = repowriter_write(writer, cache_file.get());
+        repowriter_free(writer);
+        if (res == 0) {
+            cache_tmp_file.close();
+            std::filesystem::rename(cache_tmp_file.get_path(), cache_path);
+            cache_tmp_file.release();
+        }
+    } catch (const std::exception &) {
+    }
+}
+
+// Reads the RPM files into a staging repository in a private pool and writes it to a temporary solv file.
+// It does not touch the main pool, so it can be run by several threads at once.
+StagedRpmPackages stage_rpm_packages(
+    std::span<const std::string> paths, bool with_hdrid, const std::filesystem::path & cache_dir) {
+    StagedRpmPackages staged;
+
+    solv::Pool pool;
+    auto * repo = repo_create(*pool, "staging");
+
+    int flags = 0;
+    if (with_hdrid) {
+        flags |= RPM_ADD_WITH_HDRID | RPM_ADD_WITH_SHA256SUM;
+    }
+
+    for (const auto & path : paths) {
+        SolvUserdata userdata{};
+        const bool cacheable = !cache_dir.empty() && rpm_header_cache_userdata(path, with_hdrid, userdata);
+        const auto cache_path =
+            cacheable ? rpm_header_cache_path(cache_dir, path, with_hdrid) : std::filesystem::path{};
+
+        if (cacheable && load_cached_rpm_header(repo, cache_path, userdata)) {
+            ++staged.count;
+            continue;
+        }
+
+        const Id new_id = repo_add_rpm(repo, path.c_str(), flags);
+        if (new_id == 0) {
+            staged.error = pool_errstr(*pool);
+            break;
+        }
+        ++staged.count;
+
+        if (cacheable) {
+            write_cached_rpm_header(repo, new_id, cache_path, userdata);
+        }
+    }
+
+    if (staged.count > 0) {
+        auto & solv_file = staged.solv_file.emplace("libdnf5-rpm-packages");
+        auto & file = solv_file.open_as_file("w+");
+        Repowriter * writer = repowriter_create(repo);
+        const int res = repowriter_write(writer, file.get());
+        repowriter_free(writer);
+        if (res != 0) {
+            throw SolvError(
+                M_("Failed to write staged RPM packages to \"{}\": {}"),
+                solv_file.get_path().native(),
+                std::string(pool_errstr(*pool)));
+        }
+        solv_file.close();
+    }
+
+    return staged;
+}
+
+}  // namespace
+
+
+std::vector<Id> SolvRepo::add_rpm_packages(const std::vector<std::string> & paths, bool with_hdrid) {
+    auto & pool = get_rpm_pool(base);
+
+    std::filesystem::path cache_dir =
+        std::filesystem::path(config.get_cachedir()) / CACHE_SOLV_FILES_DIR / CACHE_RPM_HEADERS_DIR;
+    std::error_code ec;
+    std::filesystem::create_directories(cache_dir, ec);
+    if (ec) {
+        base->get_logger()->debug("Cannot create RPM headers cache \"{}\": {}", cache_dir.native(), ec.message());
+        cache_dir.clear();
+    }
+
+    // Contiguous ranges of paths are read by workers, the first range is read by the calling thread.
+    const auto max_workers = std::max(1u, std::thread::hardware_concurrency());
+    const auto num_workers =
+        std::clamp<std::size_t>((paths.size() + RPM_FILES_PER_WORKER - 1) / RPM_FILES_PER_WORKER, 1, max_workers);
+    const auto range_size = (paths.size() + num_workers - 1) / num_workers;
+
+    const std::span<const std::string> all_paths(paths);
+    std::vector<std::future<StagedRpmPackages>> workers;
+    for (std::size_t start = range_size; start < paths.size(); start += range_size) {
+        workers.emplace_back(std::async(
+            std::launch::async,
+            stage_rpm_packages,
+            all_paths.subspan(start, std::min(range_size, paths.size() - start)),
+            with_hdrid,
+            cache_dir));
+    }
+    auto first_staged = stage_rpm_packages(all_paths.first(std::min(range_size, paths.size())), with_hdrid, cache_dir);
+
+    // Merge the staging repositories in the input order.
+    internalize();
+    std::vector<Id> ids;
+    ids.reserve(paths.size());
+    for (std::size_t idx = 0, start = 0; start < paths.size(); ++idx, start += range_size) {
+        auto staged = idx == 0 ? std::move(first_staged) : workers[idx - 1].get();
+        if (staged.solv_file) {
+            fs::File file(staged.solv_file->get_path(), "r");
+            const Id first_id = pool->nsolvables;
+            if (repo_add_solv(repo, file.get(), 0) != 0) {
+                throw SolvError(
+                    M_("Failed to load staged RPM packages from \"{}\": {}"),
+                    staged.solv_file->get_path().native(),
+                    std::string(pool_errstr(*pool)));
+            }
+            libdnf_assert(
+                static_cast<std::size_t>(pool->nsolvables - first_id) == staged.count,
+                "Unexpected number of staged RPM packages");
+            for (Id id = first_id; id < pool->nsolvables; ++id) {
+                ids.push_back(id);
+            }
+        }
+        if (!staged.error.empty()) {
+            throw RepoRpmError(M_("Failed to load RPM \"{}\": {}"), paths[start + staged.count], staged.error);
+        }
+    }
+
+    if (!cache_dir.empty()) {
+        prune_rpm_header_cache(cache_dir, *base->get_logger());
+    }
+
+    return ids;
+}
+
 bool SolvRepo::can_use_solvfile_cache(solv::Pool & pool, fs::File & solvfile_cache) {
     auto & logger = *base->get_logger();
 
@@ -183,6 +479,8 @@ static const char * repodata_type_to_name(RepodataType type) {
         case RepodataType::APPSTREAM:
             libdnf_throw_assertion("No static filename for RepodataType::APPSTREAM");
             break;
+        case RepodataType::FILEPROVIDES:
+            return FILEPROVIDES_TYPE_NAME;
     }
 
     libdnf_throw_assertion("Unknown RepodataType: {}", utils::to_underlying(type));
@@ -203,6 +501,8 @@ static int repodata_type_to_flags(RepodataType type) {
             return REPO_EXTEND_SOLVABLES | REPO_LOCALPOOL;
         case RepodataType::APPSTREAM:
             return 0;
+        case RepodataType::FILEPROVIDES:
+            return REPO_EXTEND_SOLVABLES;
     }
 
     libdnf_throw_assertion("Unknown RepodataType: {}", utils::to_underlying(type));
@@ -256,6 +556,8 @@ void SolvRepo::load_repo_main(const std::string & repomd_fn, const std::string &
         main_repodata_start = repodata_start;
         main_repodata_end = repo->nrepodata;
 
+        load_fileprovides_cache(pool);
+
         return;
     }
 
@@ -320,6 +622,7 @@ void SolvRepo::load_system_repo_ext(RepodataType type) {
         case RepodataType::PRESTO:
         case RepodataType::UPDATEINFO:
         case RepodataType::APPSTREAM:
+        case RepodataType::FILEPROVIDES:
             throw SolvError(M_("Unsupported extended repodata type for the system repo: \"{}\"."), type_name);
     }
 }
@@ -352,6 +655,10 @@ void SolvRepo::load_repo_ext(RepodataType type, const std::string & in_type_name
         return;
     }
 
+    if (type == RepodataType::COMPS) {
+        invalidate_comps_index();
+    }
+
     int solvables_start = pool->nsolvables;
 
     if (load_solv_cache(pool, type_name.c_str(), repodata_type_to_flags(type))) {
@@ -388,6 +695,8 @@ void SolvRepo::load_repo_ext(RepodataType type, const std::string & in_type_name
             break;
         case RepodataType::APPSTREAM:
             break;
+        case RepodataType::FILEPROVIDES:
+            libdnf_throw_assertion("RepodataType::FILEPROVIDES is not loaded from repository metadata");
     }
 
     if (res != 0) {
@@ -473,25 +782,89 @@ void SolvRepo::rewrite_repo(libdnf5::solv::IdQueue & fileprovides) {
     auto & logger = *base->get_logger();
     auto & pool = get_rpm_pool(base);
 
-    logger.debug("Rewriting repo \"{}\" with added file provides", config.get_id());
-
     if (!config.get_build_cache_option().get_value() || main_solvables_start == 0 || fileprovides.size() == 0) {
         return;
     }
 
+    // REPOSITORY_ADDEDFILEPROVIDES is in the main repodata, either stored in the main cache (written by
+    // older versions) or set in memory after the file provides extension was written or loaded.
     libdnf5::solv::IdQueue fileprovidesq;
     libdnf5::solv::SolvMap providedids(pool->ss.nstrings);
-    Repodata * data = repo_id2repodata(repo, 1);
-    if (repodata_lookup_idarray(data, SOLVID_META, REPOSITORY_ADDEDFILEPROVIDES, &fileprovidesq.get_queue())) {
+    Repodata * main_data = repo_id2repodata(repo, 1);
+    if (repodata_lookup_idarray(main_data, SOLVID_META, REPOSITORY_ADDEDFILEPROVIDES, &fileprovidesq.get_queue())) {
         if (is_superset(fileprovidesq, fileprovides, providedids)) {
             return;
         }
     }
 
-    repodata_set_idarray(data, SOLVID_META, REPOSITORY_ADDEDFILEPROVIDES, &fileprovides.get_queue());
+    logger.debug("Writing file provides extension for repo \"{}\"", config.get_id());
+
+    // The added file provides follow the SOLVABLE_FILEMARKER in the provides of the solvables
+    Repodata * data = repo_add_repodata(repo, 0);
+    repodata_extend_block(data, main_solvables_start, main_solvables_end - main_solvables_start);
+    Id fileprovides_key = pool.str2id(FILEPROVIDES_KEY_NAME, true);
+    libdnf5::solv::IdQueue solvable_fileprovides;
+    for (Id id = main_solvables_start; id < main_solvables_end; ++id) {
+        Solvable * solvable = pool.id2solvable(id);
+        if (solvable->repo != repo || solvable->dep_provides == 0) {
+            continue;
+        }
+        solvable_fileprovides.clear();
+        bool after_marker = false;
+        for (Id * provide = repo->idarraydata + solvable->dep_provides; *provide != 0; ++provide) {
+            if (after_marker) {
+                solvable_fileprovides.push_back(*provide);
+            } else if (*provide == SOLVABLE_FILEMARKER) {
+                after_marker = true;
+            }
+        }
+        if (!solvable_fileprovides.empty()) {
+            repodata_set_idarray(data, id, fileprovides_key, &solvable_fileprovides.get_queue());
+        }
+    }
+    // REPOSITORY_ADDEDFILEPROVIDES itself cannot be stored in the extension, libsolv only takes it into
+    // account in the repodata that contains the file lists. A custom key is used instead.
+    repodata_set_idarray(
+        data, SOLVID_META, pool.str2id(ADDEDFILEPROVIDES_KEY_NAME, true), &fileprovides.get_queue());
     repodata_internalize(data);
 
-    write_main(false);
+    write_ext(data->repodataid, RepodataType::FILEPROVIDES, FILEPROVIDES_TYPE_NAME);
+
+    repodata_set_idarray(main_data, SOLVID_META, REPOSITORY_ADDEDFILEPROVIDES, &fileprovides.get_queue());
+    repodata_internalize(main_data);
+}
+
+
+void SolvRepo::load_fileprovides_cache(solv::Pool & pool) {
+    Id repodata_id = repo->nrepodata;
+    if (!load_solv_cache(pool, FILEPROVIDES_TYPE_NAME, repodata_type_to_flags(RepodataType::FILEPROVIDES))) {
+        return;
+    }
+
+    Repodata * data = repo_id2repodata(repo, repodata_id);
+    libdnf5::solv::IdQueue fileprovides;
+    if (!repodata_lookup_idarray(
+            data, SOLVID_META, pool.str2id(ADDEDFILEPROVIDES_KEY_NAME, true), &fileprovides.get_queue())) {
+        return;
+    }
+
+    Id fileprovides_key = pool.str2id(FILEPROVIDES_KEY_NAME, true);
+    libdnf5::solv::IdQueue solvable_fileprovides;
+    for (Id id = main_solvables_start; id < main_solvables_end; ++id) {
+        if (!repodata_lookup_idarray(data, id, fileprovides_key, &solvable_fileprovides.get_queue())) {
+            continue;
+        }
+        Solvable * solvable = pool.id2solvable(id);
+        for (Id file_id : solvable_fileprovides) {
+            solvable->dep_provides = repo_addid_dep(repo, solvable->dep_provides, file_id, SOLVABLE_FILEMARKER);
+        }
+    }
+
+    // With REPOSITORY_ADDEDFILEPROVIDES in the main repodata, pool_addfileprovides_queue() does not search
+    // the file lists of this repo for the files again.
+    Repodata * main_data = repo_id2repodata(repo, 1);
+    repodata_set_idarray(main_data, SOLVID_META, REPOSITORY_ADDEDFILEPROVIDES, &fileprovides.get_queue());
+    repodata_internalize(main_data);
 }
 
 
@@ -659,6 +1032,8 @@ void SolvRepo::write_ext(Id repodata_id, RepodataType type, const std::string &
 
     if (type == RepodataType::UPDATEINFO) {
         repowriter_set_solvablerange(writer, updateinfo_solvables_start, updateinfo_solvables_end);
+    } else if (type == RepodataType::FILEPROVIDES) {
+        repowriter_set_solvablerange(writer, main_solvables_start, main_solvables_end);
     }
 
     if (type != RepodataType::COMPS && type != RepodataType::UPDATEINFO) {
@@ -679,7 +1054,8 @@ void SolvRepo::write_ext(Id repodata_id, RepodataType type, const std::string &
 
     cache_tmp_file.close();
 
-    if (is_one_piece(repo) && type != RepodataType::UPDATEINFO && type != RepodataType::COMPS) {
+    if (is_one_piece(repo) && type != RepodataType::UPDATEINFO && type != RepodataType::COMPS &&
+        type != RepodataType::FILEPROVIDES) {
         // this saves memory, libsolv doesn't load all the data from a solv file, it dup()s the fd,
         // keeps the file open and lazily loads some data on-demand.
         fs::File file(cache_tmp_file.get_path(), "r");
@@ -722,6 +1098,11 @@ std::filesystem::path SolvRepo::solv_file_path(const char * type) {
     return std::filesystem::path(config.get_cachedir()) / CACHE_SOLV_FILES_DIR / solv_file_name(type);
 }
 
+
+void SolvRepo::invalidate_comps_index() {
+    InternalBaseUser::invalidate_comps_index(base);
+}
+
 bool SolvRepo::read_group_solvable_from_xml(const std::string & path) {
     auto & logger = *base->get_logger();
     bool read_success = true;
@@ -736,6 +1117,7 @@ bool SolvRepo::read_group_solvable_from_xml(const std::string & path) {
 
     if (read_success) {
         logger.debug("Loading group extension for {} repo from \"{}\"", config.get_id(), path);
+        invalidate_comps_index();
         read_success = repo_add_comps(comps_repo, ext_file.get(), 0) == 0;
         if (!read_success) {
             logger.debug("Loading group extension for {} repo from \"{}\" failed.", config.get_id(), path);
@@ -751,6 +1133,7 @@ void SolvRepo::create_group_solvable(const std::string & groupid, const libdnf5:
         comps_repo == (*pool)->installed, "SolvRepo::create_group_solvable() call enabled only for @System repo.");
 
     // create a new solvable for the group
+    invalidate_comps_index();
     auto group_solvable_id = repo_add_solvable(comps_repo);
     Solvable * group_solvable = pool.id2solvable(group_solvable_id);
 
@@ -789,6 +1172,7 @@ void SolvRepo::create_environment_solvable(
         "SolvRepo::create_environment_solvable() call enabled only for @System repo.");
 
     // create a new solvable for the environment
+    invalidate_comps_index();
     auto environment_solvable_id = repo_add_solvable(comps_repo);
     Solvable * environment_solvable = pool.id2solvable(environment_solvable_id);
 
@@ -32,6 +32,8 @@
 #include <solv/repo.h>
 
 #include <filesystem>
+#include <string>
+#include <vector>
 
 
 static const constexpr size_t CHKSUM_BYTES = 32;
@@ -52,7 +54,7 @@ struct SolvUserdata {
 namespace libdnf5::repo {
 
 using LibsolvRepo = ::Repo;
-enum class RepodataType { FILELISTS, PRESTO, UPDATEINFO, COMPS, OTHER, APPSTREAM };
+enum class RepodataType { FILELISTS, PRESTO, UPDATEINFO, COMPS, OTHER, APPSTREAM, FILEPROVIDES };
 
 
 class SolvError : public Error {
@@ -84,8 +86,19 @@ public:
     /// Loads additional system repo metadata (comps, modules)
     void load_system_repo_ext(RepodataType type);
 
+    /// Stores the file provides added to the solvables by `pool_addfileprovides_queue()` to the repo cache.
+    /// They are written to a separate .solvx extension, so the main .solv cache is never rewritten.
+    /// Nothing is written if the cache already contains a superset of `fileprovides`.
     void rewrite_repo(libdnf5::solv::IdQueue & fileprovides);
 
+    /// Adds packages from local RPM files. The headers are read (and checksummed) by a pool of workers,
+    /// each into a staging repository in its own libsolv pool. The staging repositories are merged into
+    /// this repository in the order of `paths`. The headers read are cached in the repository cachedir
+    /// keyed by the file path, device, inode, mtime and size, so unchanged files are not parsed again.
+    /// @return Ids of the added solvables in the order of `paths`.
+    /// @throws RepoRpmError for the first file that cannot be loaded. The packages preceding it are added.
+    std::vector<Id> add_rpm_packages(const std::vector<std::string> & paths, bool with_hdrid);
+
     // Internalize repository if needed.
     void internalize();
 
@@ -131,9 +144,15 @@ private:
     /// Writes libsolv's .solvx cache file with extended libsolv repodata.
     void write_ext(Id repodata_id, RepodataType type, const std::string & type_name);
 
+    /// Loads the file provides extension of the main cache and adds the file provides to the solvables.
+    void load_fileprovides_cache(solv::Pool & pool);
+
     std::string solv_file_name(const char * type = nullptr);
     std::filesystem::path solv_file_path(const char * type = nullptr);
 
+    /// Invalidates the index of groups and environments kept by CompsSack, called when `comps_repo` changes.
+    void invalidate_comps_index();
+
     libdnf5::BaseWeakPtr base;
     const ConfigRepo & config;
 
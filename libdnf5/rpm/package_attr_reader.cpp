@@ -0,0 +1,225 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "libdnf5/rpm/package_attr_reader.hpp"
+
+#include "base/base_impl.hpp"
+#include "solv/pool.hpp"
+
+#include "libdnf5/common/exception.hpp"
+
+#include <fmt/format.h>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace libdnf5::rpm {
+
+namespace {
+
+enum class AttrSource {
+    NAME,
+    EPOCH,
+    VERSION,
+    RELEASE,
+    ARCH,
+    EVR,
+    FULL_NEVRA,
+    SOURCE_NAME,
+    SOURCERPM,
+    STR_KEY,
+    NUM_KEY,
+    DEPS,
+};
+
+struct AttrSpec {
+    AttrSource source;
+    // metadata key of STR_KEY and NUM_KEY attributes
+    Id keyname{0};
+    // (keyname, marker) pairs of DEPS attributes, see solvable_lookup_deparray()
+    std::vector<std::pair<Id, Id>> dep_keys{};
+};
+
+// The dependency lists are the same as returned by the corresponding Package getters
+const std::unordered_map<std::string, AttrSpec> NAME_TO_ATTR_SPEC = {
+    {"name", {AttrSource::NAME}},
+    {"epoch", {AttrSource::EPOCH}},
+    {"version", {AttrSource::VERSION}},
+    {"release", {AttrSource::RELEASE}},
+    {"arch", {AttrSource::ARCH}},
+    {"evr", {AttrSource::EVR}},
+    {"full_nevra", {AttrSource::FULL_NEVRA}},
+    {"source_name", {AttrSource::SOURCE_NAME}},
+    {"sourcerpm", {AttrSource::SOURCERPM}},
+    {"group", {AttrSource::STR_KEY, SOLVABLE_GROUP}},
+    {"license", {AttrSource::STR_KEY, SOLVABLE_LICENSE}},
+    {"packager", {AttrSource::STR_KEY, SOLVABLE_PACKAGER}},
+    {"vendor", {AttrSource::STR_KEY, SOLVABLE_VENDOR}},
+    {"url", {AttrSource::STR_KEY, SOLVABLE_URL}},
+    {"summary", {AttrSource::STR_KEY, SOLVABLE_SUMMARY}},
+    {"description", {AttrSource::STR_KEY, SOLVABLE_DESCRIPTION}},
+    {"downloadsize", {AttrSource::NUM_KEY, SOLVABLE_DOWNLOADSIZE}},
+    {"installsize", {AttrSource::NUM_KEY, SOLVABLE_INSTALLSIZE}},
+    {"buildtime", {AttrSource::NUM_KEY, SOLVABLE_BUILDTIME}},
+    {"installtime", {AttrSource::NUM_KEY, SOLVABLE_INSTALLTIME}},
+    {"provides", {AttrSource::DEPS, 0, {{SOLVABLE_PROVIDES, -1}}}},
+    {"requires", {AttrSource::DEPS, 0, {{SOLVABLE_REQUIRES, -1}, {SOLVABLE_REQUIRES, 1}}}},
+    {"requires_pre", {AttrSource::DEPS, 0, {{SOLVABLE_REQUIRES, 1}}}},
+    {"regular_requires", {AttrSource::DEPS, 0, {{SOLVABLE_REQUIRES, -1}}}},
+    {"prereq_ignoreinst", {AttrSource::DEPS, 0, {{SOLVABLE_PREREQ_IGNOREINST, -1}}}},
+    {"conflicts", {AttrSource::DEPS, 0, {{SOLVABLE_CONFLICTS, -1}}}},
+    {"obsoletes", {AttrSource::DEPS, 0, {{SOLVABLE_OBSOLETES, -1}}}},
+    {"recommends", {AttrSource::DEPS, 0, {{SOLVABLE_RECOMMENDS, -1}}}},
+    {"suggests", {AttrSource::DEPS, 0, {{SOLVABLE_SUGGESTS, -1}}}},
+    {"enhances", {AttrSource::DEPS, 0, {{SOLVABLE_ENHANCES, -1}}}},
+    {"supplements", {AttrSource::DEPS, 0, {{SOLVABLE_SUPPLEMENTS, -1}}}},
+    {"depends",
+     {AttrSource::DEPS,
+      0,
+      {{SOLVABLE_REQUIRES, -1},
+       {SOLVABLE_ENHANCES, -1},
+       {SOLVABLE_SUGGESTS, -1},
+       {SOLVABLE_SUPPLEMENTS, -1},
+       {SOLVABLE_RECOMMENDS, -1}}}},
+};
+
+
+void append_cstring(std::string & out, const char * value) {
+    if (value) {
+        out.append(value);
+    }
+}
+
+}  // namespace
+
+
+class PackageAttrReader::Impl {
+public:
+    Impl(const BaseWeakPtr & base, const AttrSpec & spec) : base(base), spec(spec) {}
+
+private:
+    friend PackageAttrReader;
+
+    BaseWeakPtr base;
+    AttrSpec spec;
+    // reused buffer for dependency ids
+    mutable libdnf5::solv::IdQueue deps;
+};
+
+
+bool PackageAttrReader::is_supported(const std::string & attr_name) {
+    return NAME_TO_ATTR_SPEC.contains(attr_name);
+}
+
+
+PackageAttrReader::PackageAttrReader(const libdnf5::BaseWeakPtr & base, const std::string & attr_name) {
+    auto spec = NAME_TO_ATTR_SPEC.find(attr_name);
+    libdnf_user_assert(
+        spec != NAME_TO_ATTR_SPEC.end(), "Package attribute \"{}\" cannot be read by PackageAttrReader", attr_name);
+    p_impl = ImplPtr<Impl>(new Impl(base, spec->second));
+}
+
+PackageAttrReader::~PackageAttrReader() = default;
+
+PackageAttrReader::PackageAttrReader(const PackageAttrReader & src) = default;
+PackageAttrReader & PackageAttrReader::operator=(const PackageAttrReader & src) = default;
+PackageAttrReader::PackageAttrReader(PackageAttrReader && src) noexcept = default;
+PackageAttrReader & PackageAttrReader::operator=(PackageAttrReader && src) noexcept = default;
+
+
+void PackageAttrReader::append(const Package & package, std::string & out) const {
+    auto & pool = get_rpm_pool(p_impl->base);
+    const Id id = package.get_id().id;
+    Solvable * solvable = pool.id2solvable(id);
+
+    switch (p_impl->spec.source) {
+        case AttrSource::NAME:
+            out.append(pool.id2str(solvable->name));
+            break;
+        case AttrSource::EPOCH:
+            out.append(pool.split_evr(pool.id2str(solvable->evr)).e_def());
+            break;
+        case AttrSource::VERSION:
+            append_cstring(out, pool.split_evr(pool.id2str(solvable->evr)).v);
+            break;
+        case AttrSource::RELEASE:
+            append_cstring(out, pool.split_evr(pool.id2str(solvable->evr)).r);
+            break;
+        case AttrSource::ARCH:
+            out.append(pool.id2str(solvable->arch));
+            break;
+        case AttrSource::EVR:
+            out.append(pool.id2str(solvable->evr));
+            break;
+        case AttrSource::FULL_NEVRA: {
+            // same as Pool::get_full_nevra() without building a temporary string
+            const char * evr = pool.id2str(solvable->evr);
+            const char * arch = pool.id2str(solvable->arch);
+            out.append(pool.id2str(solvable->name));
+            if (*evr != '\0') {
+                out.push_back('-');
+                bool add_zero_epoch = true;
+                for (const char * e = evr + 1; *e != '-' && *e != '\0'; ++e) {
+                    if (*e == ':') {
+                        add_zero_epoch = false;
+                        break;
+                    }
+                }
+                if (add_zero_epoch) {
+                    out.append("0:");
+                }
+                out.append(evr);
+            }
+            if (*arch != '\0') {
+                out.push_back('.');
+                out.append(arch);
+            }
+            break;
+        }
+        case AttrSource::SOURCE_NAME: {
+            const char * source_name = pool.lookup_str(id, SOLVABLE_SOURCENAME);
+            out.append(source_name ? source_name : pool.id2str(solvable->name));
+            break;
+        }
+        case AttrSource::SOURCERPM:
+            append_cstring(out, pool.get_sourcerpm(id));
+            break;
+        case AttrSource::STR_KEY:
+            append_cstring(out, pool.lookup_str(id, p_impl->spec.keyname));
+            break;
+        case AttrSource::NUM_KEY:
+            fmt::format_to(std::back_inserter(out), "{}", pool.lookup_num(id, p_impl->spec.keyname));
+            break;
+        case AttrSource::DEPS:
+            for (const auto & [keyname, marker] : p_impl->spec.dep_keys) {
+                p_impl->deps.clear();
+                solvable_lookup_deparray(solvable, keyname, &p_impl->deps.get_queue(), marker);
+                for (Id dep : p_impl->deps) {
+                    append_cstring(out, pool.dep2str(dep));
+                    out.push_back('\n');
+                }
+            }
+            break;
+    }
+}
+
+}  // namespace libdnf5::rpm
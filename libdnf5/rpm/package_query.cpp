@@ -41,6 +41,9 @@ extern "C" {
 #include <fnmatch.h>
 
 #include <filesystem>
+#include <future>
+#include <span>
+#include <thread>
 #include <utility>
 
 namespace libdnf5::rpm {
@@ -220,6 +223,64 @@ Id what_downgrades(libdnf5::solv::RpmPool & spool, const Solvable * solvable) {
     return l;
 }
 
+/// Call `get_result` for every id in `candidates` and collect the returned non-zero ids into a map.
+/// Large candidate sets are split into id ranges evaluated in parallel, therefore `get_result` must only
+/// read the pool. It holds for what_upgrades() and what_downgrades() once the provides are ready.
+template <typename GetResult>
+libdnf5::solv::SolvMap collect_in_parallel(
+    const libdnf5::solv::RpmPool & pool,
+    const libdnf5::solv::SolvMap & candidates,
+    const ParallelEvaluation & parallel_evaluation,
+    GetResult get_result) {
+    const Id min_range_size = parallel_evaluation.min_range_size;
+
+    const auto collect_range =
+        [&candidates, &get_result](Id range_begin, Id range_end, libdnf5::solv::SolvMap & result) {
+            auto it = candidates.begin();
+            it.jump(range_begin);
+            for (const auto end = candidates.end(); it != end && *it < range_end; ++it) {
+                if (const Id id = get_result(*it)) {
+                    result.add_unsafe(id);
+                }
+            }
+        };
+
+    const Id ids_count = candidates.allocated_size();
+    const auto max_workers = parallel_evaluation.max_workers > 0 ? parallel_evaluation.max_workers
+                                                                 : std::max(1u, std::thread::hardware_concurrency());
+    const auto workers = static_cast<Id>(std::min<unsigned int>(
+        max_workers, static_cast<unsigned int>(std::max(1, ids_count / min_range_size))));
+
+    libdnf5::solv::SolvMap result(pool.get_nsolvables());
+    if (workers == 1) {
+        collect_range(0, ids_count, result);
+        return result;
+    }
+
+    const Id range_size = (ids_count + workers - 1) / workers;
+    std::vector<libdnf5::solv::SolvMap> partial_results;
+    partial_results.reserve(static_cast<std::size_t>(workers - 1));
+    std::vector<std::future<void>> futures;
+    futures.reserve(static_cast<std::size_t>(workers - 1));
+    for (Id range_begin = range_size; range_begin < ids_count; range_begin += range_size) {
+        auto & partial_result = partial_results.emplace_back(pool.get_nsolvables());
+        futures.push_back(std::async(
+            std::launch::async,
+            collect_range,
+            range_begin,
+            std::min(range_begin + range_size, ids_count),
+            std::ref(partial_result)));
+    }
+    // the first range is evaluated by the calling thread
+    collect_range(0, range_size, result);
+
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        futures[i].get();
+        result |= partial_results[i];
+    }
+    return result;
+}
+
 inline bool name_compare_lower_id(const Solvable * first, Id id_name) {
     return first->name < id_name;
 }
@@ -236,76 +297,113 @@ static inline bool name_arch_compare_lower(const Solvable * first, const T * sec
     return first->arch < second->arch;
 }
 
-void add_edges(
-    Base & base,
-    std::set<unsigned int> & edges,
-    const PackageQuery & full_query,
-    const std::map<PackageId, unsigned int> & pkg_id2idx,
-    const ReldepList & deps) {
-    // resolve dependencies and add an edge if there is exactly one package satisfying it
-    for (int i = 0; i < deps.size(); ++i) {
-        ReldepList req_in_list(base);
-        req_in_list.add(deps.get_id(i));
-        PackageQuery query(full_query);
-        query.filter_provides(req_in_list);
-        if (query.size() == 1) {
-            auto pkg = *query.begin();
-            edges.insert(pkg_id2idx.at(pkg.get_id()));
-        }
+/// Directed graph stored in the compressed sparse row format. Edges of the node `u` are
+/// `edges[offsets[u]]` .. `edges[offsets[u + 1] - 1]`.
+class DependencyGraph {
+public:
+    DependencyGraph() : offsets{0} {}
+
+    /// Append a new node with the given outgoing edges
+    void add_node(const std::vector<unsigned int> & node_edges) {
+        edges.insert(edges.end(), node_edges.begin(), node_edges.end());
+        offsets.push_back(edges.size());
     }
-}
 
-std::vector<std::vector<unsigned int>> build_graph(
-    Base & base, const PackageQuery & full_query, const std::vector<Package> & pkgs, bool use_recommends) {
-    // create pkg_id2idx to map Packages to their index in pkgs
-    std::map<PackageId, unsigned int> pkg_id2idx;
-    for (size_t i = 0; i < pkgs.size(); ++i) {
-        pkg_id2idx.emplace(pkgs[i].get_id(), i);
+    unsigned int size() const noexcept { return static_cast<unsigned int>(offsets.size() - 1); }
+
+    std::span<const unsigned int> operator[](unsigned int node) const noexcept {
+        return {edges.data() + offsets[node], edges.data() + offsets[node + 1]};
     }
 
-    std::vector<std::vector<unsigned int>> graph;
-    graph.reserve(pkgs.size());
+    /// Return the graph with all edges reversed, edges of each node are kept in ascending order
+    DependencyGraph reverse() const {
+        DependencyGraph rgraph;
+        const auto node_count = size();
 
-    for (unsigned int i = 0; i < pkgs.size(); ++i) {
-        std::set<unsigned int> edges;
-        const auto & package = pkgs[i];
-        add_edges(base, edges, full_query, pkg_id2idx, package.get_requires());
-        if (use_recommends) {
-            add_edges(base, edges, full_query, pkg_id2idx, package.get_recommends());
+        // count incoming edges of each node to compute row offsets
+        rgraph.offsets.assign(node_count + 1, 0);
+        for (auto edge : edges) {
+            ++rgraph.offsets[edge + 1];
+        }
+        for (unsigned int i = 0; i < node_count; ++i) {
+            rgraph.offsets[i + 1] += rgraph.offsets[i];
         }
-        edges.erase(i);  // remove self-edges
-        graph.emplace_back(edges.begin(), edges.end());
-    }
 
-    return graph;
-}
+        // fill rows, source nodes are visited in ascending order
+        rgraph.edges.resize(edges.size());
+        std::vector<std::size_t> fill_pos(rgraph.offsets.begin(), rgraph.offsets.end() - 1);
+        for (unsigned int i = 0; i < node_count; ++i) {
+            for (auto edge : (*this)[i]) {
+                rgraph.edges[fill_pos[edge]++] = i;
+            }
+        }
 
-std::vector<std::vector<unsigned int>> reverse_graph(const std::vector<std::vector<unsigned int>> & graph) {
-    std::vector<std::vector<unsigned int>> rgraph(graph.size());
+        return rgraph;
+    }
 
-    // pre-allocate (reserve) memory to prevent reallocations
-    std::vector<unsigned int> lengths(graph.size(), 0);
-    for (const auto & edges : graph) {
-        for (auto edge : edges) {
-            ++lengths[edge];
+private:
+    std::vector<std::size_t> offsets;
+    std::vector<unsigned int> edges;
+};
+
+/// Resolve dependencies and add an edge if there is exactly one package in the query satisfying it.
+/// The providers are taken directly from the libsolv whatprovides lists.
+void add_edges(
+    ::Pool * pool,
+    std::vector<unsigned int> & edges,
+    const libdnf5::solv::SolvMap & query_map,
+    const std::vector<unsigned int> & solvable_id2idx,
+    const ReldepList & deps) {
+    for (int i = 0; i < deps.size(); ++i) {
+        Id provider = 0;
+        bool single_provider = true;
+        Id p;
+        Id pp;
+        FOR_PROVIDES(p, pp, deps.get_id(i).id) {
+            if (p == provider || !query_map.contains(p)) {
+                continue;
+            }
+            if (provider != 0) {
+                single_provider = false;
+                break;
+            }
+            provider = p;
+        }
+        if (provider != 0 && single_provider) {
+            edges.push_back(solvable_id2idx[static_cast<std::size_t>(provider)]);
         }
     }
-    for (unsigned int i = 0; i < graph.size(); ++i) {
-        rgraph[i].reserve(lengths[i]);
+}
+
+DependencyGraph build_graph(
+    ::Pool * pool, const libdnf5::solv::SolvMap & query_map, const std::vector<Package> & pkgs, bool use_recommends) {
+    // map solvable ids of the packages to their index in pkgs
+    std::vector<unsigned int> solvable_id2idx(static_cast<std::size_t>(pool->nsolvables), 0);
+    for (unsigned int i = 0; i < pkgs.size(); ++i) {
+        solvable_id2idx[static_cast<std::size_t>(pkgs[i].get_id().id)] = i;
     }
 
-    // reverse graph
-    for (unsigned int i = 0; i < graph.size(); ++i) {
-        for (auto edge : graph[i]) {
-            rgraph[edge].push_back(i);
+    DependencyGraph graph;
+    std::vector<unsigned int> edges;
+    for (unsigned int i = 0; i < pkgs.size(); ++i) {
+        edges.clear();
+        const auto & package = pkgs[i];
+        add_edges(pool, edges, query_map, solvable_id2idx, package.get_requires());
+        if (use_recommends) {
+            add_edges(pool, edges, query_map, solvable_id2idx, package.get_recommends());
         }
+        // sort, remove duplicates and self-edges
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        edges.erase(std::remove(edges.begin(), edges.end(), i), edges.end());
+        graph.add_node(edges);
     }
 
-    return rgraph;
+    return graph;
 }
 
-std::vector<std::vector<unsigned int>> kosaraju(const std::vector<std::vector<unsigned int>> & graph) {
-    const auto N = static_cast<unsigned int>(graph.size());
+std::vector<std::vector<unsigned int>> kosaraju(const DependencyGraph & graph) {
+    const auto N = graph.size();
     std::vector<unsigned int> rstack(N);
     std::vector<unsigned int> stack(N);
     std::vector<bool> tag(N, false);
@@ -324,7 +422,7 @@ std::vector<std::vector<unsigned int>> kosaraju(const std::vector<std::vector<un
         unsigned int j = 0;
         tag[u] = true;
         while (true) {
-            const auto & edges = graph[u];
+            const auto edges = graph[u];
             if (j < edges.size()) {
                 const auto v = edges[j++];
                 if (!tag[v]) {
@@ -358,7 +456,7 @@ std::vector<std::vector<unsigned int>> kosaraju(const std::vector<std::vector<un
     // themselves.
     // if there are no such incoming edges the component is a leaf and we
     // add it to the array of leaves.
-    auto rgraph = reverse_graph(graph);
+    auto rgraph = graph.reverse();
     std::set<unsigned int> sccredges;
     std::vector<std::vector<unsigned int>> leaves;
     for (; r < N; ++r) {
@@ -372,7 +470,7 @@ std::vector<std::vector<unsigned int>> kosaraju(const std::vector<std::vector<un
         unsigned int s = N;
         while (top) {
             u = stack[--s] = stack[--top];
-            const auto & redges = rgraph[u];
+            const auto redges = rgraph[u];
             for (unsigned int j = 0; j < redges.size(); ++j) {
                 const unsigned int v = redges[j];
                 sccredges.insert(v);
@@ -2472,17 +2570,14 @@ void PackageQuery::filter_upgrades() {
 
     p_impl->base->get_rpm_package_sack()->p_impl->make_provides_ready();
 
-    libdnf5::solv::SolvMap filter_result(pool.get_nsolvables());
-
-    for (Id candidate_id : *p_impl) {
-        Solvable * solvable = pool.id2solvable(candidate_id);
-        if (solvable->repo == installed_repo) {
-            continue;
-        }
-        if (what_upgrades(pool, solvable) > 0) {
-            filter_result.add_unsafe(candidate_id);
-        }
-    }
+    auto filter_result = collect_in_parallel(
+        pool, *p_impl, p_pq_impl->parallel_evaluation, [&pool, installed_repo](Id candidate_id) -> Id {
+            const Solvable * solvable = pool.id2solvable(candidate_id);
+            if (solvable->repo == installed_repo || what_upgrades(pool, solvable) <= 0) {
+                return 0;
+            }
+            return candidate_id;
+        });
     *p_impl &= filter_result;
 }
 
@@ -2497,16 +2592,15 @@ void PackageQuery::filter_downgrades() {
 
     p_impl->base->get_rpm_package_sack()->p_impl->make_provides_ready();
 
-    for (Id candidate_id : *p_impl) {
-        Solvable * solvable = pool.id2solvable(candidate_id);
-        if (solvable->repo == installed_repo) {
-            p_impl->remove_unsafe(candidate_id);
-            continue;
-        }
-        if (what_downgrades(pool, solvable) <= 0) {
-            p_impl->remove_unsafe(candidate_id);
-        }
-    }
+    auto filter_result = collect_in_parallel(
+        pool, *p_impl, p_pq_impl->parallel_evaluation, [&pool, installed_repo](Id candidate_id) -> Id {
+            const Solvable * solvable = pool.id2solvable(candidate_id);
+            if (solvable->repo == installed_repo || what_downgrades(pool, solvable) <= 0) {
+                return 0;
+            }
+            return candidate_id;
+        });
+    *p_impl &= filter_result;
 }
 
 void PackageQuery::filter_upgradable() {
@@ -2521,28 +2615,29 @@ void PackageQuery::filter_upgradable() {
     auto sack = p_impl->base->get_rpm_package_sack();
     sack->p_impl->make_provides_ready();
 
-    libdnf5::solv::SolvMap filter_result(pool.get_nsolvables());
+    const libdnf5::solv::SolvMap * considered = nullptr;
+    if (p_pq_impl->flags == ExcludeFlags::APPLY_EXCLUDES) {
+        if (pool.is_considered_map_active()) {
+            considered = &pool.get_considered_map();
+        }
+    } else {
+        considered = p_pq_impl->considered_cache ? &*p_pq_impl->considered_cache : nullptr;
+    }
 
-    for (auto pkg_id : sack->p_impl->get_solvables()) {
-        if (p_pq_impl->flags == ExcludeFlags::APPLY_EXCLUDES) {
-            if (pool.is_considered_map_active() && !pool.get_considered_map().contains_unsafe(pkg_id)) {
-                continue;
+    auto filter_result = collect_in_parallel(
+        pool,
+        sack->p_impl->get_solvables(),
+        p_pq_impl->parallel_evaluation,
+        [&pool, installed_repo, considered](Id pkg_id) -> Id {
+            if (considered && !considered->contains_unsafe(pkg_id)) {
+                return 0;
             }
-        } else {
-            if (p_pq_impl->considered_cache && !p_pq_impl->considered_cache->contains_unsafe(pkg_id)) {
-                continue;
+            const Solvable * solvable = pool.id2solvable(pkg_id);
+            if (solvable->repo == installed_repo) {
+                return 0;
             }
-        }
-
-        Solvable * solvable = pool.id2solvable(pkg_id);
-        if (solvable->repo == installed_repo) {
-            continue;
-        }
-        Id what = what_upgrades(pool, solvable);
-        if (what != 0) {
-            filter_result.add_unsafe(what);
-        }
-    }
+            return what_upgrades(pool, solvable);
+        });
     *p_impl &= filter_result;
 }
 
@@ -2558,28 +2653,29 @@ void PackageQuery::filter_downgradable() {
     auto sack = p_impl->base->get_rpm_package_sack();
     sack->p_impl->make_provides_ready();
 
-    libdnf5::solv::SolvMap filter_result(pool.get_nsolvables());
+    const libdnf5::solv::SolvMap * considered = nullptr;
+    if (p_pq_impl->flags == ExcludeFlags::APPLY_EXCLUDES) {
+        if (pool.is_considered_map_active()) {
+            considered = &pool.get_considered_map();
+        }
+    } else {
+        considered = p_pq_impl->considered_cache ? &*p_pq_impl->considered_cache : nullptr;
+    }
 
-    for (auto pkg_id : sack->p_impl->get_solvables()) {
-        if (p_pq_impl->flags == ExcludeFlags::APPLY_EXCLUDES) {
-            if (pool.is_considered_map_active() && !pool.get_considered_map().contains_unsafe(pkg_id)) {
-                continue;
+    auto filter_result = collect_in_parallel(
+        pool,
+        sack->p_impl->get_solvables(),
+        p_pq_impl->parallel_evaluation,
+        [&pool, installed_repo, considered](Id pkg_id) -> Id {
+            if (considered && !considered->contains_unsafe(pkg_id)) {
+                return 0;
             }
-        } else {
-            if (p_pq_impl->considered_cache && !p_pq_impl->considered_cache->contains_unsafe(pkg_id)) {
-                continue;
+            const Solvable * solvable = pool.id2solvable(pkg_id);
+            if (solvable->repo == installed_repo) {
+                return 0;
             }
-        }
-
-        Solvable * solvable = pool.id2solvable(pkg_id);
-        if (solvable->repo == installed_repo) {
-            continue;
-        }
-        Id what = what_downgrades(pool, solvable);
-        if (what != 0) {
-            filter_result.add_unsafe(what);
-        }
-    }
+            return what_downgrades(pool, solvable);
+        });
     *p_impl &= filter_result;
 }
 
@@ -2957,8 +3053,9 @@ std::vector<std::vector<Package>> PackageQuery::filter_leaves(bool return_groupe
     std::vector<Package> pkgs(begin(), end());
 
     // build the directed graph of dependencies
+    p_impl->base->get_rpm_package_sack()->p_impl->make_provides_ready();
     bool use_recommends = p_impl->base->get_config().get_install_weak_deps_option().get_value();
-    auto graph = build_graph(*p_impl->base, *this, pkgs, use_recommends);
+    auto graph = build_graph(*pool, *p_impl, pkgs, use_recommends);
 
     // run Kosaraju's algorithm to find strongly connected components
     // without any incoming edges
@@ -3013,11 +3110,12 @@ void PackageQuery::filter_userinstalled() {
     auto & pool = get_rpm_pool(p_impl->base);
     libdnf5::solv::SolvMap filter_result(pool.get_nsolvables());
     filter_installed();
-    for (const auto & pkg : *this) {
-        auto reason = pkg.get_reason();
+    auto reasons = p_impl->base->get_rpm_package_sack()->p_impl->get_installed_reasons();
+    for (Id id : *p_impl) {
+        auto reason = reasons[static_cast<size_t>(id)];
         if (reason != libdnf5::transaction::TransactionItemReason::WEAK_DEPENDENCY &&
             reason != libdnf5::transaction::TransactionItemReason::DEPENDENCY) {
-            filter_result.add_unsafe(pkg.get_id().id);
+            filter_result.add_unsafe(id);
         }
     }
     *p_impl &= filter_result;
@@ -33,6 +33,15 @@ extern "C" {
 namespace libdnf5::rpm {
 
 
+/// Split of the candidates evaluated in parallel by the PackageQuery filters
+struct ParallelEvaluation {
+    /// Minimal number of solvable ids evaluated by one thread, smaller ranges are not worth the cost of a thread.
+    Id min_range_size{16384};
+    /// Maximal number of threads, 0 means the hardware concurrency.
+    unsigned int max_workers{0};
+};
+
+
 class PackageQuery::PQImpl {
 public:
     static void filter_provides(
@@ -84,6 +93,8 @@ private:
     friend PackageQuery;
     ExcludeFlags flags;
     std::optional<libdnf5::solv::SolvMap> considered_cache;
+    /// The default values are only changed by the tests, to run the parallel evaluation on small package sets
+    ParallelEvaluation parallel_evaluation;
 };
 
 
@@ -18,6 +18,7 @@
 // along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
 
 
+#include "base/base_impl.hpp"
 #include "package_sack_impl.hpp"
 #include "package_set_impl.hpp"
 #include "repo/solv_repo.hpp"
@@ -43,6 +44,8 @@ extern "C" {
 }
 
 #include <algorithm>
+#include <map>
+#include <unordered_map>
 
 
 using LibsolvRepo = Repo;
@@ -54,6 +57,8 @@ void PackageSack::Impl::make_provides_ready() {
         return;
     }
 
+    base::Tracer::Scope trace(base->get_tracer(), "make_provides_ready");
+
     // Temporarily replaces the considered map with an empty one. Ignores "excludes" during calculation provides.
     libdnf5::solv::SolvMap original_considered_map(0);
     get_rpm_pool(base).swap_considered_map(original_considered_map);
@@ -81,13 +86,93 @@ void PackageSack::Impl::make_provides_ready() {
         }
     }
 
-    pool_createwhatprovides(*pool);
+    if (!provides_appended_only || !add_appended_provides(addedfileprovides, addedfileprovides_inst)) {
+        pool_createwhatprovides(*pool);
+    }
+    provides_file_ids.clear();
+    provides_file_ids.insert(addedfileprovides.begin(), addedfileprovides.end());
+    provides_file_ids.insert(addedfileprovides_inst.begin(), addedfileprovides_inst.end());
+    provides_nsolvables = pool.get_nsolvables();
+    provides_nstrings = pool->ss.nstrings;
+    provides_appended_only = false;
     provides_ready = true;
 
     // Sets the original considered map.
     get_rpm_pool(base).swap_considered_map(original_considered_map);
 }
 
+bool PackageSack::Impl::add_appended_provides(
+    const libdnf5::solv::IdQueue & addedfileprovides, const libdnf5::solv::IdQueue & addedfileprovides_inst) {
+    // pool_set_whatprovides() clears the cached providers of relations in a pass over all relations in the pool.
+    // With more provided names than this, recomputing the whole whatprovides is faster.
+    constexpr std::size_t MAX_APPENDED_PROVIDED_NAMES = 128;
+
+    auto & pool = get_rpm_pool(base);
+    auto nsolvables = pool.get_nsolvables();
+    if (pool->whatprovides == nullptr || nsolvables < provides_nsolvables) {
+        return false;
+    }
+
+    // A file dependency that was not known yet can be provided by the solvables that are already in the whatprovides
+    for (const auto & queue : {&addedfileprovides, &addedfileprovides_inst}) {
+        for (Id file_id : *queue) {
+            if (!provides_file_ids.contains(file_id)) {
+                return false;
+            }
+        }
+    }
+
+    // Collect the provided names of the appended solvables the same way as pool_createwhatprovides() does
+    std::map<Id, std::vector<Id>> appended_providers;
+    for (Id id = provides_nsolvables; id < nsolvables; ++id) {
+        Solvable * solvable = pool.id2solvable(id);
+        if (solvable->repo == nullptr || solvable->repo->disabled || solvable->dep_provides == 0) {
+            continue;
+        }
+        if (solvable->repo != pool->installed &&
+            (solvable->arch == ARCH_SRC || solvable->arch == ARCH_NOSRC || pool_badarch_solvable(*pool, solvable))) {
+            continue;
+        }
+        for (Id * provide = solvable->repo->idarraydata + solvable->dep_provides; *provide != 0; ++provide) {
+            const Id name = pool.dep2name(*provide);
+            // The whatprovides only has entries for the names known when it was computed
+            if (name >= provides_nstrings) {
+                return false;
+            }
+            auto & providers = appended_providers[name];
+            if (providers.empty() || providers.back() != id) {
+                providers.push_back(id);
+            }
+        }
+        if (appended_providers.size() > MAX_APPENDED_PROVIDED_NAMES) {
+            return false;
+        }
+    }
+
+    std::vector<Id> merged;
+    libdnf5::solv::IdQueue providers_queue;
+    for (const auto & [name, providers] : appended_providers) {
+        // The whatprovides lists are sorted by solvable id. The appended solvables can already be there
+        // if the whatprovides were recomputed outside of the PackageSack.
+        merged.clear();
+        for (Id * old_provider = pool_whatprovides_ptr(*pool, name); *old_provider != 0; ++old_provider) {
+            merged.push_back(*old_provider);
+        }
+        auto old_size = merged.size();
+        merged.insert(merged.end(), providers.begin(), providers.end());
+        std::inplace_merge(merged.begin(), merged.begin() + static_cast<std::ptrdiff_t>(old_size), merged.end());
+        merged.erase(std::unique(merged.begin(), merged.end()), merged.end());
+
+        providers_queue.clear();
+        for (Id provider : merged) {
+            providers_queue.push_back(provider);
+        }
+        pool_set_whatprovides(*pool, name, pool.queuetowhatprovides(providers_queue));
+    }
+
+    return true;
+}
+
 void PackageSack::Impl::load_versionlock_excludes() {
     PackageSet locked_set(base);
     PackageQuery base_query(base, PackageQuery::ExcludeFlags::IGNORE_EXCLUDES);
@@ -493,6 +578,8 @@ void PackageSack::Impl::recompute_considered_in_pool() {
         return;
     }
 
+    base::Tracer::Scope trace(base->get_tracer(), "recompute_considered_in_pool");
+
     auto considered = compute_considered_map(libdnf5::sack::ExcludeFlags::APPLY_EXCLUDES);
     if (considered) {
         get_rpm_pool(base).swap_considered_map(*considered);
@@ -602,6 +689,40 @@ static libdnf5::rpm::PackageQuery running_kernel_check_path(const libdnf5::BaseW
     return q;
 }
 
+std::vector<transaction::TransactionItemReason> PackageSack::Impl::get_installed_reasons() {
+    auto & pool = get_rpm_pool(base);
+    std::vector<transaction::TransactionItemReason> reasons(
+        static_cast<size_t>(pool.get_nsolvables()), transaction::TransactionItemReason::NONE);
+
+    auto * installed_repo = pool->installed;
+    if (installed_repo == nullptr) {
+        return reasons;
+    }
+
+    auto & system_state = InternalBaseUser::get_system_state(base);
+
+    // Installonly packages share the NA, the system state is asked only once per NA
+    std::unordered_map<std::string, transaction::TransactionItemReason> na_reasons;
+    std::string na;
+    Id solvable_id;
+    Solvable * solvable;
+    FOR_REPO_SOLVABLES(installed_repo, solvable_id, solvable) {
+        na = pool.id2str(solvable->name);
+        na.append(".");
+        na.append(pool.id2str(solvable->arch));
+        auto [it, inserted] = na_reasons.try_emplace(na, transaction::TransactionItemReason::NONE);
+        if (inserted) {
+            it->second = system_state.get_package_reason(na);
+            if (it->second == transaction::TransactionItemReason::NONE) {
+                it->second = transaction::TransactionItemReason::EXTERNAL_USER;
+            }
+        }
+        reasons[static_cast<size_t>(solvable_id)] = it->second;
+    }
+
+    return reasons;
+}
+
 rpm::PackageId PackageSack::Impl::get_running_kernel_id() {
     auto & logger = *base->get_logger();
     if (running_kernel.id != 0) {
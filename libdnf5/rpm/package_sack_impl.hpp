@@ -27,12 +27,14 @@
 #include "libdnf5/base/base.hpp"
 #include "libdnf5/common/sack/exclude_flags.hpp"
 #include "libdnf5/rpm/package.hpp"
+#include "libdnf5/transaction/transaction_item_reason.hpp"
 
 extern "C" {
 #include <solv/pool.h>
 }
 
 #include <optional>
+#include <unordered_set>
 #include <vector>
 
 
@@ -78,10 +80,28 @@ public:
 
     void make_provides_ready();
 
-    void invalidate_provides() { provides_ready = false; }
+    /// Marks the provides outdated, the next make_provides_ready() recomputes them for the whole pool.
+    void invalidate_provides() {
+        provides_ready = false;
+        provides_appended_only = false;
+    }
+
+    /// Marks the provides outdated after solvables were appended to the pool and no existing solvable was changed.
+    /// The next make_provides_ready() only adds providers of the appended solvables if possible.
+    void invalidate_provides_appended() {
+        if (provides_ready) {
+            provides_ready = false;
+            provides_appended_only = true;
+        }
+    }
 
     PackageId get_running_kernel_id();
 
+    /// Return reasons of all installed packages resolved in one pass over the installed repo.
+    /// The vector is indexed by solvable id, solvables which are not installed have the reason NONE.
+    /// The reason of an installed package is the same as returned by Package::get_reason().
+    std::vector<transaction::TransactionItemReason> get_installed_reasons();
+
     /// Sets excluded and included packages according to the configuration.
     ///
     /// Uses the `disable_excludes`, `excludepkgs`, and `includepkgs` configuration options to calculate the `config_includes` and `config_excludes` sets.
@@ -130,7 +150,17 @@ public:
     void recompute_considered_in_pool();
 
 private:
+    /// Adds providers of the solvables appended since the last make_provides_ready() to the pool whatprovides.
+    /// @return `false` if the whatprovides have to be recomputed for the whole pool instead.
+    bool add_appended_provides(
+        const libdnf5::solv::IdQueue & addedfileprovides, const libdnf5::solv::IdQueue & addedfileprovides_inst);
+
     bool provides_ready{false};
+    bool provides_appended_only{false};
+    // Number of solvables, number of strings and file provides ids the whatprovides were computed for
+    int provides_nsolvables{0};
+    int provides_nstrings{0};
+    std::unordered_set<Id> provides_file_ids;
 
     BaseWeakPtr base;
 
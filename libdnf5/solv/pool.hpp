@@ -119,6 +119,25 @@ public:
 
     Id rel2id(Id name, Id evr, int flags, bool create) const { return pool_rel2id(pool, name, evr, flags, create); }
 
+    /// Returns the name Id of a dependency, relations are stripped the same way as in pool_createwhatprovides().
+    /// It is ISRELDEP() and GETRELDEP() from libsolv without the implicit sign conversions.
+    Id dep2name(Id dep) const {
+        while ((static_cast<unsigned int>(dep) & 0x80000000u) != 0) {
+            dep = pool->rels[static_cast<unsigned int>(dep) ^ 0x80000000u].name;
+        }
+        return dep;
+    }
+
+    /// Returns `true` if the dependency is a name or a name with a version comparison.
+    /// Rich dependencies and other relations (e.g. namespaces) return `false`.
+    bool is_simple_dep(Id dep) const {
+        if ((static_cast<unsigned int>(dep) & 0x80000000u) == 0) {
+            return true;
+        }
+        auto flags = pool->rels[static_cast<unsigned int>(dep) ^ 0x80000000u].flags;
+        return flags > 0 && flags <= (REL_LT | REL_EQ | REL_GT);
+    }
+
     Id lookup_id(Id id, Id keyname) const {
         if (id > 0) {
             libdnf5::solv::get_repo(id2solvable(id)).internalize();
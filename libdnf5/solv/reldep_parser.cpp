@@ -19,81 +19,96 @@
 
 #include "reldep_parser.hpp"
 
-#include "utils/regex.hpp"
-
-#include <regex>
 #include <string>
+#include <string_view>
 
 
 namespace libdnf5::solv {
 
-// Avoid using the \s and \S patterns here as they are GNU extensions and aren't portable.
-static const std::regex RELDEP_REGEX("^([^[:space:]]*)[[:space:]]*(<=|>=|<|>|=)?[[:space:]]*([^[:space:]]*)$");
+namespace {
 
-static bool set_cmp_type(
-    libdnf5::rpm::Reldep::CmpType * cmp_type, const std::string & cmp_type_string, long int length) {
-    if (length == 2) {
-        // The second character must be '='
-        if (cmp_type_string[1] != '=') {
-            return false;
-        }
-        if (cmp_type_string[0] == '<') {
-            *cmp_type = libdnf5::rpm::Reldep::CmpType::LTE;
-            return true;
-        } else if (cmp_type_string[0] == '>') {
-            *cmp_type = libdnf5::rpm::Reldep::CmpType::GTE;
+// The same characters as the [[:space:]] class in the "C" locale
+bool is_space(char c) {
+    switch (c) {
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\v':
+        case '\f':
+        case '\r':
             return true;
-        } else {
+        default:
             return false;
-        }
-    } else if (length == 1) {
-        if (cmp_type_string[0] == '>') {
-            *cmp_type = libdnf5::rpm::Reldep::CmpType::GT;
-            return true;
-        } else if (cmp_type_string[0] == '<') {
-            *cmp_type = libdnf5::rpm::Reldep::CmpType::LT;
-            return true;
-        } else if (cmp_type_string[0] == '=') {
-            *cmp_type = libdnf5::rpm::Reldep::CmpType::EQ;
-            return true;
-        } else {
-            return false;
-        }
     }
-    return false;
 }
 
+std::size_t skip_spaces(std::string_view str, std::size_t pos) {
+    while (pos < str.size() && is_space(str[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+std::size_t skip_non_spaces(std::string_view str, std::size_t pos) {
+    while (pos < str.size() && !is_space(str[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+// Parses the comparison operator at the beginning of `str`.
+// Returns the length of the operator or 0 if `str` does not start with one.
+std::size_t parse_cmp_type(std::string_view str, libdnf5::rpm::Reldep::CmpType & cmp_type) {
+    if (str.starts_with("<=")) {
+        cmp_type = libdnf5::rpm::Reldep::CmpType::LTE;
+        return 2;
+    } else if (str.starts_with(">=")) {
+        cmp_type = libdnf5::rpm::Reldep::CmpType::GTE;
+        return 2;
+    } else if (str.starts_with('<')) {
+        cmp_type = libdnf5::rpm::Reldep::CmpType::LT;
+        return 1;
+    } else if (str.starts_with('>')) {
+        cmp_type = libdnf5::rpm::Reldep::CmpType::GT;
+        return 1;
+    } else if (str.starts_with('=')) {
+        cmp_type = libdnf5::rpm::Reldep::CmpType::EQ;
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace
+
 
-bool ReldepParser::parse(const std::string & reldep) {
-    enum { NAME = 1, CMP_TYPE = 2, EVR = 3 };
-    std::smatch match;
-    if (reldep.length() > MAX_STRING_LENGTH_FOR_REGEX_MATCH) {
-        // GCC std::regex_match() exhausts a stack on very long strings.
+bool ReldepParser::parse(std::string_view reldep) {
+    // The accepted format is "name[<white space>]" or "name[<white space>]cmp_type[<white space>]evr",
+    // the name and the evr do not contain white space. The name is the longest prefix without white space,
+    // so e.g. "foo>=1" is parsed as a name.
+    const auto name_end = skip_non_spaces(reldep, 0);
+    name.assign(reldep.substr(0, name_end));
+
+    auto pos = skip_spaces(reldep, name_end);
+    if (pos == reldep.size()) {
+        cmp_type = libdnf5::rpm::Reldep::CmpType::NONE;
+        evr.clear();
+        return true;
+    }
+
+    const auto cmp_type_length = parse_cmp_type(reldep.substr(pos), cmp_type);
+    if (cmp_type_length == 0) {
+        // evr without a comparison operator
         return false;
     }
-    if (!std::regex_match(reldep, match, RELDEP_REGEX)) {
+
+    const auto evr_begin = skip_spaces(reldep, pos + cmp_type_length);
+    const auto evr_end = skip_non_spaces(reldep, evr_begin);
+    if (evr_begin == evr_end || evr_end != reldep.size()) {
+        // missing evr or an extra element
         return false;
-    } else {
-        std::ssub_match cmp_type_sub_match = match[CMP_TYPE];
-        std::ssub_match evr_sub_match = match[EVR];
-        auto cmp_type_length = cmp_type_sub_match.length();
-        auto evr_length = evr_sub_match.length();
-        // Only evr and cmp_type together or only name is a valid reldep
-        if ((cmp_type_length && evr_length) || (!cmp_type_length && !evr_length)) {
-            name = match[NAME].str();
-            if (cmp_type_length) {
-                evr = evr_sub_match.str();
-                auto cmp_type_string = cmp_type_sub_match.str();
-                return set_cmp_type(&cmp_type, cmp_type_string, cmp_type_length);
-            } else {
-                cmp_type = libdnf5::rpm::Reldep::CmpType::NONE;
-                evr.clear();
-                return true;
-            }
-        } else {
-            return false;
-        }
     }
+    evr.assign(reldep.substr(evr_begin));
+    return true;
 }
 
 }  // namespace libdnf5::solv
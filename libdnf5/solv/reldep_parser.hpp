@@ -23,6 +23,7 @@
 #include "libdnf5/rpm/reldep.hpp"
 
 #include <string>
+#include <string_view>
 
 
 namespace libdnf5::solv {
@@ -34,7 +35,7 @@ public:
     ///
     /// @param reldep The reldep string to parse.
     /// @return `true` if parsing was successful.
-    bool parse(const std::string & reldep);
+    bool parse(std::string_view reldep);
 
     const std::string & get_name() const noexcept { return name; }
 
@@ -13,6 +13,7 @@
 
 #include <toml.hpp>
 
+#include <algorithm>
 #include <array>
 #include <map>
 #include <optional>
@@ -153,38 +154,20 @@ bool VendorChangeManager::is_vendor_change_allowed(Solvable & outgoing, Solvable
         return true;
     }
 
-    const auto & outgoing_vendor_mask = get_vendor_change_masks(outgoing_vendor).outgoing_mask;
-    if (outgoing_vendor_mask.empty()) {
-        // The outgoing vendor is not involved in any valid policy change.
-        // Therefore, any change is illegal.
-        return false;
-    }
-
-    const auto & incoming_vendor_mask = get_vendor_change_masks(incoming_vendor).incoming_mask;
-
-    // The resulting mask should only contain vendors present in both input masks (intersection).
-    // SolvMap::operator&= requires the LHS mask size to be less than or equal to the RHS mask size.
-    solv::SolvMap result_vendor_mask{0};
-    if (outgoing_vendor_mask.allocated_size() > incoming_vendor_mask.allocated_size()) {
-        result_vendor_mask = incoming_vendor_mask;
-        result_vendor_mask &= outgoing_vendor_mask;
-    } else {
-        result_vendor_mask = outgoing_vendor_mask;
-        result_vendor_mask &= incoming_vendor_mask;
-    }
-
-    // Iterate through policies allowing vendor changes and verify
+    // Iterate through policies allowing the vendor change and verify
     // if the change is permitted for the specific 'installed' and 'new_solv' packages.
-    for (const auto policy_idx : result_vendor_mask) {
-        const auto & policy = vendor_policies_def.at(static_cast<unsigned int>(policy_idx));
+    // An empty list means the vendors are not involved in any common policy, any change is illegal.
+    for (const auto policy_idx : get_vendor_change_policies(outgoing_vendor, incoming_vendor)) {
+        const auto & policy = vendor_policies_def[policy_idx];
+        auto & matches = package_defs_matches[policy_idx];
 
         // Ensure the current installed package is allowed to leave its vendor
-        if (!matches_package_defs(policy.outgoing_packages, outgoing)) {
+        if (!matches_package_defs(policy.outgoing_packages, matches.outgoing, outgoing)) {
             continue;
         }
 
         // Ensure the new package is allowed to be accepted by the new vendor
-        if (matches_package_defs(policy.incoming_packages, incoming)) {
+        if (matches_package_defs(policy.incoming_packages, matches.incoming, incoming)) {
             return true;  // Vendor change is allowed
         }
     }
@@ -193,22 +176,43 @@ bool VendorChangeManager::is_vendor_change_allowed(Solvable & outgoing, Solvable
 }
 
 
+const std::vector<unsigned int> & VendorChangeManager::get_vendor_change_policies(
+    Id outgoing_vendor, Id incoming_vendor) {
+    const auto key = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(outgoing_vendor)) << 32) |
+                     static_cast<std::uint32_t>(incoming_vendor);
+    if (auto it = vendor_change_policies.find(key); it != vendor_change_policies.end()) {
+        return it->second;
+    }
+
+    // The policies must be present in both the outgoing and the incoming vendor masks (intersection)
+    std::vector<unsigned int> policies;
+    const auto & outgoing_vendor_mask = get_vendor_change_masks(outgoing_vendor).outgoing_mask;
+    if (!outgoing_vendor_mask.empty()) {
+        const auto & incoming_vendor_mask = get_vendor_change_masks(incoming_vendor).incoming_mask;
+        for (const auto policy_idx : outgoing_vendor_mask) {
+            if (incoming_vendor_mask.contains(policy_idx)) {
+                policies.push_back(static_cast<unsigned int>(policy_idx));
+            }
+        }
+    }
+
+    return vendor_change_policies.emplace(key, std::move(policies)).first->second;
+}
+
+
 const VendorChangeManager::VendorChangeMasks & VendorChangeManager::get_vendor_change_masks(Id vendor) {
     constexpr int EXTRA_CAPACITY = 7;
-    static const VendorChangeMasks empty_masks{.vendor = 0};
+    static const VendorChangeMasks empty_masks;
     VendorChangeMasks masks;
 
     if (vendor == 0 || vendor_policies_def.empty()) {
         return empty_masks;
     }
 
-    for (const auto & vendor_to_classes : vendor_masks) {
-        if (vendor_to_classes.vendor == vendor) {
-            return vendor_to_classes;
-        }
+    if (auto it = vendor_masks.find(vendor); it != vendor_masks.end()) {
+        return it->second;
     }
 
-    masks.vendor = vendor;
     auto vendor_str = pool.id2str(vendor);
     for (unsigned int class_idx = 0; class_idx < vendor_policies_def.size(); ++class_idx) {
         const auto & vendor_class_def = vendor_policies_def[class_idx];
@@ -240,16 +244,36 @@ const VendorChangeManager::VendorChangeMasks & VendorChangeManager::get_vendor_c
         }
     }
 
-    return vendor_masks.emplace_back(masks);
+    return vendor_masks.emplace(vendor, std::move(masks)).first->second;
 }
 
 
 bool VendorChangeManager::matches_package_defs(
-    const std::vector<VendorChangeManager::VendorChangePolicy::PackageDef> & pkgs_def, const Solvable & solvable) {
+    const std::vector<VendorChangeManager::VendorChangePolicy::PackageDef> & pkgs_def,
+    std::vector<PackageDefsMatch> & matches,
+    const Solvable & solvable) {
     if (pkgs_def.empty()) {
         return true;  // Default to true if no specific policies are defined
     }
 
+    const auto solvable_id = static_cast<std::size_t>(pool.solvable2id(const_cast<Solvable *>(&solvable)));
+    if (solvable_id >= matches.size()) {
+        // The pool may grow (e.g. by command line packages), size the cache for all current solvables
+        matches.resize(
+            std::max(solvable_id + 1, static_cast<std::size_t>(pool.get_nsolvables())), PackageDefsMatch::UNKNOWN);
+    }
+
+    auto & match = matches[solvable_id];
+    if (match == PackageDefsMatch::UNKNOWN) {
+        match = evaluate_package_defs(pkgs_def, solvable) ? PackageDefsMatch::MATCH : PackageDefsMatch::NO_MATCH;
+    }
+    return match == PackageDefsMatch::MATCH;
+}
+
+
+bool VendorChangeManager::evaluate_package_defs(
+    const std::vector<VendorChangeManager::VendorChangePolicy::PackageDef> & pkgs_def, const Solvable & solvable) {
+
     for (const auto & pkg_def : pkgs_def) {
         bool pass_filters = true;
         for (const auto & filter : pkg_def.filters) {
@@ -790,9 +814,11 @@ void VendorChangeManager::load_vendor_change_policy(const std::filesystem::path
     }
 
     vendor_policies_def.push_back(std::move(policy));
+    package_defs_matches.emplace_back();
 
-    // Clear cached vendor masks
+    // Clear cached vendor masks and vendor change policies
     vendor_masks.clear();
+    vendor_change_policies.clear();
 }
 
 }  // namespace libdnf5::solv
@@ -8,8 +8,10 @@
 
 #include "libdnf5/common/sack/query_cmp.hpp"
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 extern "C" {
@@ -87,14 +89,26 @@ public:
 
 private:
     struct VendorChangeMasks {
-        Id vendor;
         SolvMap outgoing_mask{0};
         SolvMap incoming_mask{0};
     };
 
+    /// Cached result of matching a solvable against the package definitions of a policy
+    enum class PackageDefsMatch : std::uint8_t { UNKNOWN, NO_MATCH, MATCH };
+
+    /// Cached results for one policy, indexed by solvable ID
+    struct PolicyPackageDefsMatches {
+        std::vector<PackageDefsMatch> outgoing;
+        std::vector<PackageDefsMatch> incoming;
+    };
+
     const Pool & pool;
     std::vector<VendorChangePolicy> vendor_policies_def;
-    std::vector<VendorChangeMasks> vendor_masks;
+    std::unordered_map<Id, VendorChangeMasks> vendor_masks;
+    // Indexes of policies permitting the change, keyed by (outgoing vendor, incoming vendor) pair
+    std::unordered_map<std::uint64_t, std::vector<unsigned int>> vendor_change_policies;
+    // Solvables do not change once they are in the pool, so the results stay valid
+    std::vector<PolicyPackageDefsMatches> package_defs_matches;
     SolvMap incoming_vendor_bypassed_solvables{0};
 
     /// Retrieve or cache masks for a specific vendor
@@ -102,11 +116,27 @@ private:
     /// @return Reference to the calculated VendorChangeMasks
     const VendorChangeMasks & get_vendor_change_masks(Id vendor);
 
-    /// Check if a solvable matches any of the provided package definitions
+    /// Retrieve or cache the policies permitting a change between two vendors
+    /// @param outgoing_vendor The vendor ID of the outgoing solvable
+    /// @param incoming_vendor The vendor ID of the incoming solvable
+    /// @return Indexes of the policies in ascending order
+    const std::vector<unsigned int> & get_vendor_change_policies(Id outgoing_vendor, Id incoming_vendor);
+
+    /// Check if a solvable matches any of the provided package definitions, the result is cached
+    /// @param pkgs_def List of package definitions (including exclusions)
+    /// @param matches Cached results for the package definitions
+    /// @param solvable The solvable to evaluate
+    /// @return true if the solvable matches the criteria and is not excluded
+    bool matches_package_defs(
+        const std::vector<VendorChangePolicy::PackageDef> & pkgs_def,
+        std::vector<PackageDefsMatch> & matches,
+        const Solvable & solvable);
+
+    /// Evaluate the provided package definitions for a solvable
     /// @param pkgs_def List of package definitions (including exclusions)
     /// @param solvable The solvable to evaluate
     /// @return true if the solvable matches the criteria and is not excluded
-    bool matches_package_defs(const std::vector<VendorChangePolicy::PackageDef> & pkgs_def, const Solvable & solvable);
+    bool evaluate_package_defs(const std::vector<VendorChangePolicy::PackageDef> & pkgs_def, const Solvable & solvable);
 };
 
 }  // namespace libdnf5::solv
@@ -0,0 +1,116 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "replay_package_resolver.hpp"
+
+#include "libdnf5/base/base.hpp"
+#include "libdnf5/repo/repo_query.hpp"
+#include "libdnf5/rpm/package_query.hpp"
+
+#include <algorithm>
+
+
+namespace libdnf5::transaction {
+
+namespace {
+
+std::string get_name_arch_key(const std::string & name, const std::string & arch) {
+    return name + "." + arch;
+}
+
+const std::vector<libdnf5::rpm::Package> EMPTY_PACKAGES;
+
+}  // namespace
+
+
+ReplayPackageResolver::ReplayPackageResolver(const libdnf5::BaseWeakPtr & base, const TransactionReplay & replay)
+    : base(base),
+      installed_installonly(base) {
+    libdnf5::rpm::PackageQuery query(base);
+    for (const auto & package : query) {
+        name_arch_to_packages[get_name_arch_key(package.get_name(), package.get_arch())].push_back(package);
+    }
+
+    libdnf5::rpm::PackageQuery installonly_query(query);
+    installonly_query.filter_installed();
+    installonly_query.filter_installonly();
+    installed_installonly = installonly_query;
+
+    for (const auto & package_replay : replay.packages) {
+        if (transaction_item_action_is_outbound(package_replay.action)) {
+            outbound_nevras.insert(package_replay.nevra);
+        }
+    }
+
+    load_enabled_repo_ids();
+}
+
+
+const std::vector<libdnf5::rpm::Package> & ReplayPackageResolver::get_name_arch(
+    const libdnf5::rpm::Nevra & nevra) const {
+    auto it = name_arch_to_packages.find(get_name_arch_key(nevra.get_name(), nevra.get_arch()));
+    return it == name_arch_to_packages.end() ? EMPTY_PACKAGES : it->second;
+}
+
+
+std::vector<libdnf5::rpm::Package> ReplayPackageResolver::get_nevra(const libdnf5::rpm::Nevra & nevra) const {
+    std::vector<libdnf5::rpm::Package> result;
+    for (const auto & package : get_name_arch(nevra)) {
+        if (!nevra.get_epoch().empty() && package.get_epoch() != nevra.get_epoch()) {
+            continue;
+        }
+        if (!nevra.get_version().empty() && package.get_version() != nevra.get_version()) {
+            continue;
+        }
+        if (!nevra.get_release().empty() && package.get_release() != nevra.get_release()) {
+            continue;
+        }
+        result.push_back(package);
+    }
+    return result;
+}
+
+
+bool ReplayPackageResolver::contains_installed_installonly(const std::vector<libdnf5::rpm::Package> & packages) const {
+    return std::any_of(packages.begin(), packages.end(), [this](const auto & package) {
+        return installed_installonly.contains(package);
+    });
+}
+
+
+bool ReplayPackageResolver::has_outbound_action(const std::string & nevra) const {
+    return outbound_nevras.contains(nevra);
+}
+
+
+bool ReplayPackageResolver::is_repo_enabled(const std::string & repo_id) const {
+    return enabled_repo_ids.contains(repo_id);
+}
+
+
+void ReplayPackageResolver::load_enabled_repo_ids() {
+    enabled_repo_ids.clear();
+    libdnf5::repo::RepoQuery enabled_repos(base);
+    enabled_repos.filter_enabled(true);
+    for (const auto & repo : enabled_repos) {
+        enabled_repo_ids.insert(repo->get_id());
+    }
+}
+
+}  // namespace libdnf5::transaction
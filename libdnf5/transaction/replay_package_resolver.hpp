@@ -0,0 +1,73 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef LIBDNF5_TRANSACTION_REPLAY_PACKAGE_RESOLVER_HPP
+#define LIBDNF5_TRANSACTION_REPLAY_PACKAGE_RESOLVER_HPP
+
+#include "transaction_sr.hpp"
+
+#include "libdnf5/base/base_weak.hpp"
+#include "libdnf5/rpm/nevra.hpp"
+#include "libdnf5/rpm/package.hpp"
+#include "libdnf5/rpm/package_set.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+namespace libdnf5::transaction {
+
+// Resolves the packages of a replayed transaction.
+// The packages of the sack are indexed by name.arch once, so that each replayed package is looked up
+// without a query over the whole pool. The lookups return the same packages as PackageQuery filters
+// `filter_name` + `filter_arch` (name-arch) and `filter_nevra` (nevra) would, in the same order.
+class ReplayPackageResolver {
+public:
+    ReplayPackageResolver(const libdnf5::BaseWeakPtr & base, const TransactionReplay & replay);
+
+    // Returns packages with the name and arch of the nevra.
+    const std::vector<libdnf5::rpm::Package> & get_name_arch(const libdnf5::rpm::Nevra & nevra) const;
+
+    // Returns packages matching the nevra, the epoch is compared only when the nevra contains it.
+    std::vector<libdnf5::rpm::Package> get_nevra(const libdnf5::rpm::Nevra & nevra) const;
+
+    // Returns `true` if any of the packages is an installed installonly package.
+    bool contains_installed_installonly(const std::vector<libdnf5::rpm::Package> & packages) const;
+
+    // Returns `true` if the replay contains an outbound action (e.g. Remove, Replaced) for the nevra.
+    bool has_outbound_action(const std::string & nevra) const;
+
+    // Returns `true` if an enabled repository with the id exists.
+    bool is_repo_enabled(const std::string & repo_id) const;
+
+private:
+    void load_enabled_repo_ids();
+
+    libdnf5::BaseWeakPtr base;
+    std::unordered_map<std::string, std::vector<libdnf5::rpm::Package>> name_arch_to_packages;
+    libdnf5::rpm::PackageSet installed_installonly;
+    std::unordered_set<std::string> outbound_nevras;
+    std::unordered_set<std::string> enabled_repo_ids;
+};
+
+}  // namespace libdnf5::transaction
+
+#endif  // LIBDNF5_TRANSACTION_REPLAY_PACKAGE_RESOLVER_HPP
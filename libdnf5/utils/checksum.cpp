@@ -0,0 +1,39 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "checksum.hpp"
+
+#include <solv/chksum.h>
+#include <solv/util.h>
+
+
+namespace libdnf5::utils {
+
+std::string get_sha256_hex(std::string_view data) {
+    auto chksum_obj = solv_chksum_create(REPOKEY_TYPE_SHA256);
+    solv_chksum_add(chksum_obj, data.data(), static_cast<int>(data.size()));
+    int chksum_len;
+    auto chksum = solv_chksum_get(chksum_obj, &chksum_len);
+    std::string hex(static_cast<std::size_t>(chksum_len) * 2, '\0');
+    solv_bin2hex(chksum, chksum_len, hex.data());
+    solv_chksum_free(chksum_obj, nullptr);
+    return hex;
+}
+
+}  // namespace libdnf5::utils
@@ -0,0 +1,35 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 2.1 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef LIBDNF5_UTILS_CHECKSUM_HPP
+#define LIBDNF5_UTILS_CHECKSUM_HPP
+
+#include <string>
+#include <string_view>
+
+
+namespace libdnf5::utils {
+
+/// @return The SHA-256 checksum of `data` as a lowercase hexadecimal string.
+std::string get_sha256_hex(std::string_view data);
+
+}  // namespace libdnf5::utils
+
+#endif  // LIBDNF5_UTILS_CHECKSUM_HPP
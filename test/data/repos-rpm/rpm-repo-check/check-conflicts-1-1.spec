@@ -0,0 +1,22 @@
+Name:           check-conflicts
+Epoch:          0
+Version:        1
+Release:        1
+Vendor:         dnf5-test
+
+License:        Public Domain
+URL:            http://example.com/
+
+Summary:        A dummy package
+BuildArch:      noarch
+
+Conflicts:      check-provider < 2
+Conflicts:      check-capability = 1
+Conflicts:      check-missing
+
+%description
+A dummy package.
+
+%files
+
+%changelog
@@ -0,0 +1,18 @@
+Name:           check-duplicate
+Epoch:          0
+Version:        1
+Release:        1
+Vendor:         dnf5-test
+
+License:        Public Domain
+URL:            http://example.com/
+
+Summary:        A dummy package
+BuildArch:      noarch
+
+%description
+A dummy package.
+
+%files
+
+%changelog
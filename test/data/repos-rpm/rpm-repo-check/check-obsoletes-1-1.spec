@@ -0,0 +1,22 @@
+Name:           check-obsoletes
+Epoch:          0
+Version:        1
+Release:        1
+Vendor:         dnf5-test
+
+License:        Public Domain
+URL:            http://example.com/
+
+Summary:        A dummy package
+BuildArch:      noarch
+
+Obsoletes:      check-provider < 2
+Obsoletes:      check-capability
+Obsoletes:      check-missing
+
+%description
+A dummy package.
+
+%files
+
+%changelog
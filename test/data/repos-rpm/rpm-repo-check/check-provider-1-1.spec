@@ -0,0 +1,25 @@
+Name:           check-provider
+Epoch:          0
+Version:        1
+Release:        1
+Vendor:         dnf5-test
+
+License:        Public Domain
+URL:            http://example.com/
+
+Summary:        A dummy package
+BuildArch:      noarch
+
+Provides:       check-capability = 1
+
+%description
+A dummy package.
+
+%install
+mkdir -p %{buildroot}/usr/share/check-provider
+touch %{buildroot}/usr/share/check-provider/data
+
+%files
+/usr/share/check-provider/data
+
+%changelog
@@ -0,0 +1,27 @@
+Name:           check-requires
+Epoch:          0
+Version:        1
+Release:        1
+Vendor:         dnf5-test
+
+License:        Public Domain
+URL:            http://example.com/
+
+Summary:        A dummy package
+BuildArch:      noarch
+
+Requires:       check-provider >= 1
+Requires:       check-provider >= 2
+Requires:       check-capability
+Requires:       check-missing
+Requires:       /usr/share/check-provider/data
+Requires:       /usr/share/check-missing/data
+Requires:       (check-capability or check-missing)
+Requires:       (check-missing if check-provider)
+
+%description
+A dummy package.
+
+%files
+
+%changelog
@@ -0,0 +1,21 @@
+Name:           check-rpmlib
+Epoch:          0
+Version:        1
+Release:        1
+Vendor:         dnf5-test
+
+License:        Public Domain
+URL:            http://example.com/
+
+Summary:        A dummy package
+BuildArch:      noarch
+
+Requires:       rpmlib(CompressedFileNames) <= 3.0.4-1
+Requires:       check-provider
+
+%description
+A dummy package.
+
+%files
+
+%changelog
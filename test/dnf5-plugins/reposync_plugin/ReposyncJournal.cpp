@@ -0,0 +1,141 @@
+// Copyright Contributors to the DNF5 project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of DNF5: https://github.com/rpm-software-management/dnf5/
+//
+// DNF5 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// DNF5 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DNF5.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "ReposyncJournal.hpp"
+
+#include "journal.hpp"
+
+#include <fstream>
+#include <string>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ReposyncJournalTest);
+
+namespace {
+
+constexpr const char * CHECKSUM = "sha256:0123456789abcdef";
+
+void write_file(const std::filesystem::path & path, const std::string & content) {
+    std::ofstream file(path, std::ios::trunc);
+    file << content;
+}
+
+// Records `pkg_path` into a newly written journal the way reposync does after a completed download.
+void record_package(const std::filesystem::path & journal_path, const std::filesystem::path & pkg_path, bool verified) {
+    dnf5::ReposyncJournal journal(journal_path);
+    CPPUNIT_ASSERT(journal.open());
+    journal.record(pkg_path, CHECKSUM, verified);
+    journal.flush();
+}
+
+}  // namespace
+
+
+void ReposyncJournalTest::setUp() {
+    temp_dir = std::make_unique<libdnf5::utils::fs::TempDir>("dnf5_reposync_journal_test");
+    // the journal lives in a not yet existing cache directory
+    journal_path = temp_dir->get_path() / "cache" / "repo1-0123456789abcdef" / "reposync.journal";
+    pkg_path = temp_dir->get_path() / "mirror" / "pkg-1-1.noarch.rpm";
+    std::filesystem::create_directories(pkg_path.parent_path());
+    write_file(pkg_path, "package content");
+}
+
+
+void ReposyncJournalTest::tearDown() {
+    temp_dir.reset();
+}
+
+
+void ReposyncJournalTest::test_resume() {
+    record_package(journal_path, pkg_path, true);
+
+    dnf5::ReposyncJournal journal(journal_path);
+    const auto * entry = journal.find_valid(pkg_path, CHECKSUM);
+    CPPUNIT_ASSERT(entry != nullptr);
+    CPPUNIT_ASSERT(entry->verified);
+    CPPUNIT_ASSERT_EQUAL(std::filesystem::file_size(pkg_path), entry->size);
+
+    // a package downloaded without --gpgcheck is resumed, but still has to be verified
+    record_package(journal_path, pkg_path, false);
+    dnf5::ReposyncJournal unverified_journal(journal_path);
+    entry = unverified_journal.find_valid(pkg_path, CHECKSUM);
+    CPPUNIT_ASSERT(entry != nullptr);
+    CPPUNIT_ASSERT(!entry->verified);
+
+    // the journal is not stored in the download directory
+    CPPUNIT_ASSERT(!std::filesystem::exists(pkg_path.parent_path() / "reposync.journal"));
+}
+
+
+void ReposyncJournalTest::test_invalidated_by_changed_file() {
+    record_package(journal_path, pkg_path, true);
+
+    // e.g. a truncated download replaced the recorded file
+    write_file(pkg_path, "package");
+    dnf5::ReposyncJournal journal(journal_path);
+    CPPUNIT_ASSERT(journal.find_valid(pkg_path, CHECKSUM) == nullptr);
+
+    std::filesystem::remove(pkg_path);
+    CPPUNIT_ASSERT(journal.find_valid(pkg_path, CHECKSUM) == nullptr);
+}
+
+
+void ReposyncJournalTest::test_invalidated_by_changed_checksum() {
+    record_package(journal_path, pkg_path, true);
+
+    // the repository metadata now list a different package at the same location
+    dnf5::ReposyncJournal journal(journal_path);
+    CPPUNIT_ASSERT(journal.find_valid(pkg_path, "sha256:fedcba9876543210") == nullptr);
+    CPPUNIT_ASSERT(journal.find_valid(temp_dir->get_path() / "mirror" / "other.rpm", CHECKSUM) == nullptr);
+}
+
+
+void ReposyncJournalTest::test_rewrite_drops_stale_entries() {
+    record_package(journal_path, pkg_path, true);
+
+    {
+        // the package is no longer part of the synchronized repository, so it is not kept
+        dnf5::ReposyncJournal journal(journal_path);
+        CPPUNIT_ASSERT(journal.open());
+        CPPUNIT_ASSERT(journal.find_valid(pkg_path, CHECKSUM) != nullptr);
+        journal.flush();
+    }
+
+    dnf5::ReposyncJournal journal(journal_path);
+    CPPUNIT_ASSERT(journal.find_valid(pkg_path, CHECKSUM) == nullptr);
+}
+
+
+void ReposyncJournalTest::test_malformed_lines_ignored() {
+    record_package(journal_path, pkg_path, true);
+
+    {
+        // line written partially during an interruption
+        std::ofstream journal_stream(journal_path, std::ios::app);
+        journal_stream << "sha256:0123\t15\t";
+    }
+
+    dnf5::ReposyncJournal journal(journal_path);
+    CPPUNIT_ASSERT(journal.find_valid(pkg_path, CHECKSUM) != nullptr);
+    CPPUNIT_ASSERT(journal.open());
+    journal.keep(pkg_path, *journal.find_valid(pkg_path, CHECKSUM));
+    journal.flush();
+
+    dnf5::ReposyncJournal rewritten_journal(journal_path);
+    CPPUNIT_ASSERT(rewritten_journal.find_valid(pkg_path, CHECKSUM) != nullptr);
+}
@@ -0,0 +1,54 @@
+// Copyright Contributors to the DNF5 project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of DNF5: https://github.com/rpm-software-management/dnf5/
+//
+// DNF5 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// DNF5 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DNF5.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef DNF5_TEST_REPOSYNC_JOURNAL_HPP
+#define DNF5_TEST_REPOSYNC_JOURNAL_HPP
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <libdnf5/utils/fs/temp.hpp>
+
+#include <filesystem>
+#include <memory>
+
+class ReposyncJournalTest : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(ReposyncJournalTest);
+    CPPUNIT_TEST(test_resume);
+    CPPUNIT_TEST(test_invalidated_by_changed_file);
+    CPPUNIT_TEST(test_invalidated_by_changed_checksum);
+    CPPUNIT_TEST(test_rewrite_drops_stale_entries);
+    CPPUNIT_TEST(test_malformed_lines_ignored);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+
+    void test_resume();
+    void test_invalidated_by_changed_file();
+    void test_invalidated_by_changed_checksum();
+    void test_rewrite_drops_stale_entries();
+    void test_malformed_lines_ignored();
+
+private:
+    std::unique_ptr<libdnf5::utils::fs::TempDir> temp_dir;
+    std::filesystem::path journal_path;
+    std::filesystem::path pkg_path;
+};
+
+#endif  // DNF5_TEST_REPOSYNC_JOURNAL_HPP
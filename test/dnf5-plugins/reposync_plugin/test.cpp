@@ -0,0 +1,30 @@
+// Copyright Contributors to the DNF5 project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of DNF5: https://github.com/rpm-software-management/dnf5
+//
+// DNF5 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// DNF5 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DNF5.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/TestFactoryRegistry.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <iostream>
+
+int main() {
+    auto suite = CPPUNIT_NS::TestFactoryRegistry::getRegistry().makeTest();
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest(suite);
+    return !runner.run();
+}
@@ -0,0 +1,167 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "CheckTest.hpp"
+
+#include "check.hpp"
+
+#include <dnf5/context.hpp>
+#include <libdnf5/base/base.hpp>
+#include <libdnf5/common/exception.hpp>
+#include <libdnf5/repo/repo_sack.hpp>
+#include <rpm/rpmio.h>
+#include <rpm/rpmlib.h>
+#include <rpm/rpmts.h>
+
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+
+using namespace dnf5;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CheckTest);
+
+namespace {
+
+void * install_notify(
+    const void *, const rpmCallbackType what, const rpm_loff_t, const rpm_loff_t, const void * key, void * data) {
+    auto ** fd = static_cast<FD_t *>(data);
+    switch (what) {
+        case RPMCALLBACK_INST_OPEN_FILE:
+            *fd = Fopen(static_cast<const char *>(key), "r.ufdio");
+            return *fd;
+        case RPMCALLBACK_INST_CLOSE_FILE:
+            Fclose(*fd);
+            *fd = nullptr;
+            break;
+        default:
+            break;
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+
+void CheckTest::setUp() {
+    temp_dir = std::make_unique<libdnf5::utils::fs::TempDir>("dnf5_check_test");
+    auto installroot = temp_dir->get_path() / "installroot";
+    std::filesystem::create_directory(installroot);
+
+    // Install the fixture packages into an empty rpmdb without resolving dependencies,
+    // so the database ends up with missing requires, conflicts, obsoletes and duplicates.
+    std::vector<std::string> rpm_paths;
+    for (const auto & entry :
+         std::filesystem::directory_iterator(PROJECT_BINARY_DIR "/test/data/repos-rpm/rpm-repo-check")) {
+        const auto path = entry.path().string();
+        if (path.ends_with(".rpm") && !path.ends_with(".src.rpm")) {
+            rpm_paths.push_back(path);
+        }
+    }
+    CPPUNIT_ASSERT(!rpm_paths.empty());
+
+    CPPUNIT_ASSERT_EQUAL(0, rpmReadConfigFiles(nullptr, nullptr));
+    rpmts ts = rpmtsCreate();
+    rpmtsSetRootDir(ts, installroot.c_str());
+    rpmtsSetFlags(ts, RPMTRANS_FLAG_JUSTDB | RPMTRANS_FLAG_NOSCRIPTS | RPMTRANS_FLAG_NOTRIGGERS);
+    rpmtsSetVSFlags(ts, _RPMVSF_NODIGESTS | _RPMVSF_NOSIGNATURES);
+    FD_t open_fd{nullptr};
+    rpmtsSetNotifyCallback(ts, install_notify, &open_fd);
+
+    for (const auto & path : rpm_paths) {
+        FD_t fd = Fopen(path.c_str(), "r.ufdio");
+        CPPUNIT_ASSERT(fd != nullptr && !Ferror(fd));
+        Header h{nullptr};
+        const auto rc = rpmReadPackageFile(ts, fd, path.c_str(), &h);
+        Fclose(fd);
+        CPPUNIT_ASSERT(rc == RPMRC_OK);
+        CPPUNIT_ASSERT_EQUAL(0, rpmtsAddInstallElement(ts, h, path.c_str(), 0, nullptr));
+        headerFree(h);
+    }
+
+    const auto ignore_set = RPMPROB_FILTER_REPLACEPKG | RPMPROB_FILTER_OLDPACKAGE | RPMPROB_FILTER_REPLACENEWFILES |
+                            RPMPROB_FILTER_REPLACEOLDFILES | RPMPROB_FILTER_DISKSPACE | RPMPROB_FILTER_DISKNODES;
+    const auto rc = rpmtsRun(ts, nullptr, static_cast<rpmprobFilterFlags>(ignore_set));
+    rpmtsFree(ts);
+    CPPUNIT_ASSERT_EQUAL(0, rc);
+}
+
+
+void CheckTest::tearDown() {
+    temp_dir.reset();
+}
+
+
+std::string CheckTest::run_check(bool use_rpmdb) {
+    std::vector<std::unique_ptr<libdnf5::Logger>> loggers;
+    Context context(std::move(loggers));
+
+    auto & base = context.get_base();
+    auto & config = base.get_config();
+    config.get_installroot_option().set((temp_dir->get_path() / "installroot").string());
+    config.get_cachedir_option().set((temp_dir->get_path() / "cache").string());
+    config.get_plugins_option().set(false);
+    base.setup();
+
+    auto & parser = context.get_argument_parser();
+    auto * root_cmd = parser.add_new_command("dnf5");
+    parser.set_root_command(root_cmd);
+
+    CheckCommand cmd(context);
+    cmd.set_argument_parser();
+    root_cmd->register_command(cmd.get_argument_parser_command());
+
+    std::vector<const char *> argv{"dnf5", "check"};
+    if (use_rpmdb) {
+        argv.push_back("--rpmdb");
+    }
+    parser.parse(static_cast<int>(argv.size()), argv.data());
+    cmd.configure();
+    if (!use_rpmdb) {
+        base.get_repo_sack()->load_repos(libdnf5::repo::Repo::Type::SYSTEM);
+    }
+
+    std::ostringstream output;
+    auto * orig_buf = std::cout.rdbuf(output.rdbuf());
+    try {
+        cmd.run();
+    } catch (const libdnf5::Error & ex) {
+        output << ex.what() << std::endl;
+    }
+    std::cout.rdbuf(orig_buf);
+
+    return output.str();
+}
+
+
+void CheckTest::test_system_repo_report_equals_rpmdb_report() {
+    // The system repo mode is evaluated first; the command keeps its options in globals
+    // and "--rpmdb" cannot be unset by a later parse.
+    const auto system_repo_report = run_check(false);
+    const auto rpmdb_report = run_check(true);
+
+    CPPUNIT_ASSERT_EQUAL(rpmdb_report, system_repo_report);
+    CPPUNIT_ASSERT(system_repo_report.find(" missing require \"check-missing\"") != std::string::npos);
+    CPPUNIT_ASSERT(system_repo_report.find(" missing require \"/usr/share/check-missing/data\"") != std::string::npos);
+    CPPUNIT_ASSERT(system_repo_report.find(" installed conflict ") != std::string::npos);
+    CPPUNIT_ASSERT(system_repo_report.find(" obsoleted by ") != std::string::npos);
+    CPPUNIT_ASSERT(system_repo_report.find(" duplicate with \"check-duplicate-") != std::string::npos);
+    // rpmlib() requires are not provided by packages, they must not be reported as missing
+    CPPUNIT_ASSERT(system_repo_report.find("rpmlib(") == std::string::npos);
+}
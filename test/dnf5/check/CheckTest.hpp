@@ -0,0 +1,48 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef DNF5_TEST_CHECK_HPP
+#define DNF5_TEST_CHECK_HPP
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <libdnf5/utils/fs/temp.hpp>
+
+#include <memory>
+#include <string>
+
+class CheckTest : public CppUnit::TestCase {
+    CPPUNIT_TEST_SUITE(CheckTest);
+    CPPUNIT_TEST(test_system_repo_report_equals_rpmdb_report);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+    void tearDown() override;
+
+    void test_system_repo_report_equals_rpmdb_report();
+
+private:
+    /// Runs the check command on the installroot and returns its output followed by the error message.
+    std::string run_check(bool use_rpmdb);
+
+    std::unique_ptr<libdnf5::utils::fs::TempDir> temp_dir;
+};
+
+#endif  // DNF5_TEST_CHECK_HPP
@@ -20,12 +20,19 @@
 
 #include "test_repoquery.hpp"
 
+#include "../../shared/utils.hpp"
+
+#include <fmt/args.h>
 #include <libdnf5-cli/output/repoquery.hpp>
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <chrono>
+#include <set>
 #include <string_view>
 #include <system_error>
+#include <vector>
 
 CPPUNIT_TEST_SUITE_REGISTRATION(RepoqueryTest);
 
@@ -163,6 +170,61 @@ void RepoqueryTest::test_format_set_with_tags_with_spacing() {
 }
 
 
+void RepoqueryTest::test_format_set_unsorted() {
+    // Lines are not deduplicated
+    {
+        MemStream stream;
+        libdnf5::cli::output::print_pkg_set_with_format_unsorted(stream.get_file(), *pkgs, "test\n");
+        CPPUNIT_ASSERT_EQUAL(std::string_view("test\ntest\ntest\n"), stream.get_string_view());
+    }
+
+    // Same lines as the sorted output, only in the package set order
+    {
+        MemStream stream;
+        libdnf5::cli::output::print_pkg_set_with_format_unsorted(stream.get_file(), *pkgs, "%{name}-%{evr}\n");
+        auto lines = libdnf5::utils::string::split(std::string(stream.get_string_view()), "\n");
+        std::sort(lines.begin(), lines.end());
+        CPPUNIT_ASSERT_EQUAL(
+            std::vector<std::string>({"", "pkg-1.2-3", "pkg-libs-1:1.3-4", "unresolvable-1:2-3"}), lines);
+    }
+}
+
+
+void RepoqueryTest::test_format_set_multiple_chunks() {
+    // Enough packages to be formatted in several chunks by the workers
+    add_repo_synthetic("synthetic", 10000);
+    libdnf5::rpm::PackageQuery query(base);
+
+    std::string expected;
+    std::vector<std::string> expected_lines;
+    for (auto package : query) {
+        expected_lines.push_back(fmt::format("{} {:>8}\n", package.get_full_nevra(), package.get_arch()));
+        expected.append(expected_lines.back());
+    }
+
+    // Chunks are written in the package set order
+    {
+        MemStream stream;
+        libdnf5::cli::output::print_pkg_set_with_format_unsorted(stream.get_file(), query, "%{full_nevra} %8{arch}\n");
+        CPPUNIT_ASSERT_EQUAL(std::string_view(expected), stream.get_string_view());
+    }
+
+    // Lines of all chunks are merged in the sorted order
+    {
+        std::sort(expected_lines.begin(), expected_lines.end());
+        expected_lines.erase(std::unique(expected_lines.begin(), expected_lines.end()), expected_lines.end());
+        expected.clear();
+        for (const auto & line : expected_lines) {
+            expected.append(line);
+        }
+
+        MemStream stream;
+        libdnf5::cli::output::print_pkg_set_with_format(stream.get_file(), query, "%{full_nevra} %8{arch}\n");
+        CPPUNIT_ASSERT_EQUAL(std::string_view(expected), stream.get_string_view());
+    }
+}
+
+
 void RepoqueryTest::test_pkg_attr_uniq_sorted() {
     // requires
     {
@@ -203,3 +265,85 @@ void RepoqueryTest::test_requires_filelists() {
     CPPUNIT_ASSERT_EQUAL(libdnf5::cli::output::requires_filelists("%{name}"), false);
     CPPUNIT_ASSERT_EQUAL(libdnf5::cli::output::requires_filelists("%{files}"), true);
 }
+
+
+namespace {
+
+constexpr std::size_t PERFORMANCE_PACKAGE_COUNT = 100000;
+constexpr const char * PERFORMANCE_QUERYFORMAT = "%{full_nevra} %{provides}\n";
+
+// Baseline for the performance tests, formats PERFORMANCE_QUERYFORMAT the way print_pkg_set_with_format()
+// did before the queryformat was compiled into a plan: a fmt argument store filled using the Package
+// getters for each package and lines sorted by inserting them into a std::set. Unsorted lines are
+// printed right away.
+void print_baseline(FILE * target, const libdnf5::rpm::PackageSet & pkgs, bool sorted) {
+    std::set<std::string> output;
+    fmt::dynamic_format_arg_store<fmt::format_context> arg_store;
+    for (auto package : pkgs) {
+        arg_store.clear();
+        arg_store.push_back(package.get_full_nevra());
+        std::string joined;
+        for (const auto & reldep : package.get_provides()) {
+            joined.append(reldep.to_string());
+            joined.push_back('\n');
+        }
+        arg_store.push_back(joined);
+        if (sorted) {
+            output.insert(fmt::vformat("{} {}\n", arg_store));
+        } else {
+            fmt::print(target, "{}", fmt::vformat("{} {}\n", arg_store));
+        }
+    }
+    for (const auto & line : output) {
+        fmt::print(target, "{}", line);
+    }
+}
+
+// Runs `print` and returns the output and the time it took
+template <typename Print>
+std::pair<std::string, std::chrono::duration<double>> measure(Print && print) {
+    MemStream stream;
+    auto start_time = std::chrono::steady_clock::now();
+    print(stream.get_file());
+    CPPUNIT_ASSERT_EQUAL(fflush(stream.get_file()), 0);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+    return {std::string(stream.get_string_view()), elapsed};
+}
+
+}  // namespace
+
+
+void RepoqueryTest::test_format_set_performance() {
+    add_repo_synthetic("synthetic", PERFORMANCE_PACKAGE_COUNT);
+    libdnf5::rpm::PackageQuery query(base);
+
+    // The first pass loads lazily loaded repodata, both measured variants then start warm
+    measure([&query](FILE * target) { print_baseline(target, query, true); });
+
+    auto [baseline_output, baseline_time] =
+        measure([&query](FILE * target) { print_baseline(target, query, true); });
+    auto [output, time] = measure([&query](FILE * target) {
+        libdnf5::cli::output::print_pkg_set_with_format(target, query, PERFORMANCE_QUERYFORMAT);
+    });
+    fmt::print(stderr, "\nqueryformat sorted: baseline {:.3f} s, plan {:.3f} s\n", baseline_time.count(), time.count());
+
+    CPPUNIT_ASSERT(baseline_output == output);
+}
+
+
+void RepoqueryTest::test_format_set_unsorted_performance() {
+    add_repo_synthetic("synthetic", PERFORMANCE_PACKAGE_COUNT);
+    libdnf5::rpm::PackageQuery query(base);
+
+    measure([&query](FILE * target) { print_baseline(target, query, false); });
+
+    auto [baseline_output, baseline_time] =
+        measure([&query](FILE * target) { print_baseline(target, query, false); });
+    auto [output, time] = measure([&query](FILE * target) {
+        libdnf5::cli::output::print_pkg_set_with_format_unsorted(target, query, PERFORMANCE_QUERYFORMAT);
+    });
+    fmt::print(
+        stderr, "\nqueryformat unsorted: baseline {:.3f} s, plan {:.3f} s\n", baseline_time.count(), time.count());
+
+    CPPUNIT_ASSERT(baseline_output == output);
+}
@@ -34,12 +34,21 @@
 class RepoqueryTest : public BaseTestCase {
     CPPUNIT_TEST_SUITE(RepoqueryTest);
 
+#ifndef WITH_PERFORMANCE_TESTS
     CPPUNIT_TEST(test_format_set_with_simple_str);
     CPPUNIT_TEST(test_format_set_with_tags);
     CPPUNIT_TEST(test_format_set_with_invalid_tags);
     CPPUNIT_TEST(test_format_set_with_tags_with_spacing);
+    CPPUNIT_TEST(test_format_set_unsorted);
+    CPPUNIT_TEST(test_format_set_multiple_chunks);
     CPPUNIT_TEST(test_pkg_attr_uniq_sorted);
     CPPUNIT_TEST(test_requires_filelists);
+#endif
+
+#ifdef WITH_PERFORMANCE_TESTS
+    CPPUNIT_TEST(test_format_set_performance);
+    CPPUNIT_TEST(test_format_set_unsorted_performance);
+#endif
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -50,9 +59,14 @@ public:
     void test_format_set_with_tags();
     void test_format_set_with_invalid_tags();
     void test_format_set_with_tags_with_spacing();
+    void test_format_set_unsorted();
+    void test_format_set_multiple_chunks();
     void test_pkg_attr_uniq_sorted();
     void test_requires_filelists();
 
+    void test_format_set_performance();
+    void test_format_set_unsorted_performance();
+
 private:
     std::unique_ptr<libdnf5::rpm::PackageQuery> pkgs;
 };
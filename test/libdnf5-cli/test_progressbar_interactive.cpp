@@ -144,6 +144,51 @@ int count_cursor_up_lines(const std::string & text) {
     return lines_up;
 }
 
+// Stands in for a terminal, keeps everything written to it.
+class FakeTerminal : public std::streambuf {
+public:
+    const std::string & get_output() const noexcept { return output; }
+    std::size_t get_bytes_written() const noexcept { return output.size(); }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            output.push_back(traits_type::to_char_type(ch));
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char * str, std::streamsize count) override {
+        output.append(str, static_cast<std::size_t>(count));
+        return count;
+    }
+
+private:
+    std::string output;
+};
+
+// Redirects std::cerr, where MultiProgressBar::print() writes, to the fake terminal.
+class CerrRedirect {
+public:
+    explicit CerrRedirect(FakeTerminal & terminal) : original(std::cerr.rdbuf(&terminal)) {}
+    ~CerrRedirect() { std::cerr.rdbuf(original); }
+
+    CerrRedirect(const CerrRedirect &) = delete;
+    CerrRedirect & operator=(const CerrRedirect &) = delete;
+
+private:
+    std::streambuf * original;
+};
+
+// Strips the parts of the progress bar lines that depend on timing (speed and time widgets).
+std::vector<std::string> strip_timing(const std::string & screen) {
+    auto lines = libdnf5::utils::string::split(screen, "\n");
+    for (auto & line : lines) {
+        line = line.substr(0, line.find('|'));
+    }
+    return lines;
+}
+
 }  //namespace
 
 void ProgressbarInteractiveTest::setUp() {
@@ -940,3 +985,106 @@ void ProgressbarInteractiveTest::test_multi_progress_bars_on_change_with_message
 
     ASSERT_MATCHES(expected, perform_control_sequences(oss.str()));
 }
+
+void ProgressbarInteractiveTest::test_multi_progress_bars_incremental_rendering() {
+    // Incremental rendering rewrites only the lines that changed since the previous render.
+    // The resulting screen has to be the same as with full redraws while much less is written to the terminal.
+
+    auto render = [](bool incremental) {
+        FakeTerminal terminal;
+        std::ostream stream(&terminal);
+
+        libdnf5::cli::progressbar::MultiProgressBar multi_progress_bar(
+            libdnf5::cli::progressbar::MultiProgressBar::TrackingMode::ON_CHANGE);
+        multi_progress_bar.set_incremental_rendering(incremental);
+
+        std::vector<libdnf5::cli::progressbar::DownloadProgressBar *> bars;
+        for (int idx = 1; idx <= 10; ++idx) {
+            auto bar =
+                std::make_unique<libdnf5::cli::progressbar::DownloadProgressBar>(100, fmt::format("test{}", idx));
+            bar->set_auto_finish(false);
+            bars.push_back(bar.get());
+            multi_progress_bar.add_bar(std::move(bar));
+        }
+        for (auto * bar : bars) {
+            multi_progress_bar.bar_start(*bar);
+        }
+        stream << multi_progress_bar;
+
+        for (int64_t ticks = 10; ticks <= 100; ticks += 10) {
+            for (auto * bar : bars) {
+                multi_progress_bar.bar_set_ticks(*bar, ticks);
+                stream << multi_progress_bar;
+            }
+            if (ticks == 50) {
+                // the in-progress area grows and shrinks back
+                multi_progress_bar.bar_add_message(
+                    *bars[3], libdnf5::cli::progressbar::MessageType::INFO, "test message1");
+                stream << multi_progress_bar;
+                multi_progress_bar.bar_pop_message(*bars[3]);
+                stream << multi_progress_bar;
+            }
+        }
+
+        for (auto * bar : bars) {
+            multi_progress_bar.bar_set_state(*bar, libdnf5::cli::progressbar::ProgressBarState::SUCCESS);
+            stream << multi_progress_bar;
+        }
+        stream << "Complete!";
+
+        return terminal.get_output();
+    };
+
+    const auto full_output = render(false);
+    const auto incremental_output = render(true);
+
+    const auto screen = perform_control_sequences(incremental_output);
+    CPPUNIT_ASSERT_EQUAL(strip_timing(perform_control_sequences(full_output)), strip_timing(screen));
+    Pattern expected =
+        "\\[ 1/10\\] test1 *100%*"
+        "\\[10/10\\] test10 *100%*\n"
+        "----------------------------------------------------------------------\n"
+        "\\[10/10\\] Total *100%*\n"
+        "Complete!*";
+    ASSERT_MATCHES(expected, screen);
+
+    // typically only the changed bar and the total bar are rewritten
+    CPPUNIT_ASSERT(incremental_output.size() * 2 < full_output.size());
+}
+
+void ProgressbarInteractiveTest::test_multi_progress_bar_max_frame_rate() {
+    // Progress reported within the frame interval is coalesced, the final state is printed immediately.
+
+    auto download = [](std::size_t max_frame_rate) {
+        FakeTerminal terminal;
+        {
+            CerrRedirect redirect(terminal);
+
+            libdnf5::cli::progressbar::MultiProgressBar multi_progress_bar(
+                libdnf5::cli::progressbar::MultiProgressBar::TrackingMode::ON_CHANGE);
+            multi_progress_bar.set_max_frame_rate(max_frame_rate);
+
+            auto bar = std::make_unique<libdnf5::cli::progressbar::DownloadProgressBar>(1000, "test");
+            bar->set_auto_finish(false);
+            auto * bar_raw = bar.get();
+            multi_progress_bar.add_bar(std::move(bar));
+
+            multi_progress_bar.bar_start(*bar_raw);
+            for (int64_t ticks = 1; ticks <= 1000; ++ticks) {
+                multi_progress_bar.bar_set_ticks(*bar_raw, ticks);
+                multi_progress_bar.print();
+            }
+            multi_progress_bar.bar_set_state(*bar_raw, libdnf5::cli::progressbar::ProgressBarState::SUCCESS);
+            multi_progress_bar.print();
+        }
+        return terminal.get_output();
+    };
+
+    const auto unlimited_output = download(0);
+    // a single frame per second, the loop above takes much less time
+    const auto limited_output = download(1);
+
+    CPPUNIT_ASSERT(limited_output.size() * 100 < unlimited_output.size());
+    // the final state is printed
+    CPPUNIT_ASSERT(limited_output.find("100%") != std::string::npos);
+}
@@ -42,6 +42,8 @@ class ProgressbarInteractiveTest : public CppUnit::TestCase {
     CPPUNIT_TEST(test_multi_progress_bar_on_change_already_downloaded);
     CPPUNIT_TEST(test_multi_progress_bars_on_change_with_messages_with_total);
     CPPUNIT_TEST(test_multi_progress_bars_on_change_with_messages);
+    CPPUNIT_TEST(test_multi_progress_bars_incremental_rendering);
+    CPPUNIT_TEST(test_multi_progress_bar_max_frame_rate);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -64,6 +66,8 @@ public:
     void test_multi_progress_bar_on_change_already_downloaded();
     void test_multi_progress_bars_on_change_with_messages_with_total();
     void test_multi_progress_bars_on_change_with_messages();
+    void test_multi_progress_bars_incremental_rendering();
+    void test_multi_progress_bar_max_frame_rate();
 };
 
 
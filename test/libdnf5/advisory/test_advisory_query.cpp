@@ -249,3 +249,55 @@ void AdvisoryAdvisoryQueryTest::test_get_advisory_packages_sorted() {
     CPPUNIT_ASSERT_EQUAL(std::string("pkg"), adv_pkgs[1].get_name());
     CPPUNIT_ASSERT_EQUAL(std::string("0.1-1"), adv_pkgs[1].get_evr());
 }
+
+void AdvisoryAdvisoryQueryTest::test_filter_packages_pool_change() {
+    // The advisory package index is built by the first query and has to be rebuilt when the pool grows
+    libdnf5::rpm::PackageQuery pkg_query(base);
+    AdvisoryQuery adv_query(base);
+    adv_query.filter_packages(pkg_query, libdnf5::sack::QueryCmp::EQ);
+    std::vector<Advisory> expected = {get_advisory("DNF-2019-1")};
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(adv_query));
+
+    add_repo_solv("solv-humongous");
+
+    libdnf5::rpm::PackageQuery all_pkgs(base);
+    adv_query = AdvisoryQuery(base);
+    adv_query.filter_packages(all_pkgs, libdnf5::sack::QueryCmp::EQ);
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(adv_query));
+
+    adv_query = AdvisoryQuery(base);
+    adv_query.filter_packages(all_pkgs, libdnf5::sack::QueryCmp::NEQ);
+    expected = {get_advisory("DNF-2020-1"), get_advisory("PKG-NEWER"), get_advisory("PKG-OLDER")};
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(adv_query));
+
+    adv_query = AdvisoryQuery(base);
+    adv_query.filter_packages(all_pkgs, libdnf5::sack::QueryCmp::LTE);
+    expected = {get_advisory("DNF-2019-1"), get_advisory("PKG-OLDER")};
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(adv_query));
+
+    // Only packages of advisories in the query are returned
+    adv_query = AdvisoryQuery(base);
+    adv_query.filter_name("PKG-OLDER");
+    std::vector<AdvisoryPackage> adv_pkgs =
+        adv_query.get_advisory_packages_sorted(all_pkgs, libdnf5::sack::QueryCmp::LTE);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, adv_pkgs.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("pkg"), adv_pkgs[0].get_name());
+    CPPUNIT_ASSERT_EQUAL(std::string("0.1-1"), adv_pkgs[0].get_evr());
+}
+
+void AdvisoryAdvisoryQueryTest::test_filter_packages_performance() {
+    add_repo_solv("solv-humongous");
+    libdnf5::rpm::PackageQuery pkg_query(base);
+
+    for (int i = 0; i < 10000; i++) {
+        AdvisoryQuery adv_query(base);
+        adv_query.filter_packages(pkg_query, libdnf5::sack::QueryCmp::GT);
+        CPPUNIT_ASSERT_EQUAL((size_t)1, adv_query.size());
+    }
+
+    for (int i = 0; i < 10000; i++) {
+        AdvisoryQuery adv_query(base);
+        adv_query.filter_packages(pkg_query, libdnf5::sack::QueryCmp::EQ);
+        CPPUNIT_ASSERT_EQUAL((size_t)1, adv_query.size());
+    }
+}
@@ -29,6 +29,7 @@
 class AdvisoryAdvisoryQueryTest : public BaseTestCase {
     CPPUNIT_TEST_SUITE(AdvisoryAdvisoryQueryTest);
 
+#ifndef WITH_PERFORMANCE_TESTS
     CPPUNIT_TEST(test_size);
     CPPUNIT_TEST(test_filter_name);
     CPPUNIT_TEST(test_filter_type);
@@ -39,6 +40,12 @@ class AdvisoryAdvisoryQueryTest : public BaseTestCase {
     CPPUNIT_TEST(test_filter_reference);
     CPPUNIT_TEST(test_filter_severity);
     CPPUNIT_TEST(test_get_advisory_packages_sorted);
+    CPPUNIT_TEST(test_filter_packages_pool_change);
+#endif
+
+#ifdef WITH_PERFORMANCE_TESTS
+    CPPUNIT_TEST(test_filter_packages_performance);
+#endif
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -55,6 +62,8 @@ public:
     void test_filter_reference();
     void test_filter_severity();
     void test_get_advisory_packages_sorted();
+    void test_filter_packages_pool_change();
+    void test_filter_packages_performance();
 };
 
 
@@ -23,6 +23,8 @@
 #include <libdnf5/base/base.hpp>
 #include <libdnf5/rpm/package_query.hpp>
 
+#include <algorithm>
+
 
 CPPUNIT_TEST_SUITE_REGISTRATION(BaseTest);
 
@@ -85,3 +87,45 @@ void BaseTest::test_unlock_not_locked() {
     // Unlocking should work now
     base->unlock();
 }
+
+void BaseTest::test_tracer() {
+    auto base = get_preconfigured_base();
+    auto & tracer = base->get_tracer();
+
+    // The tracer is disabled by default, nothing is recorded
+    {
+        libdnf5::base::Tracer::Scope scope(tracer, "disabled");
+    }
+    CPPUNIT_ASSERT(tracer.get_spans().empty());
+
+    tracer.set_enabled(true);
+    {
+        libdnf5::base::Tracer::Scope outer(tracer, "outer");
+        libdnf5::base::Tracer::Scope inner(tracer, "inner", "detail");
+    }
+    base->setup();
+    tracer.set_enabled(false);
+
+    auto spans = tracer.get_spans();
+    CPPUNIT_ASSERT(spans.size() >= 3);
+    CPPUNIT_ASSERT_EQUAL(std::string("outer"), spans[0].name);
+    CPPUNIT_ASSERT_EQUAL(0u, spans[0].depth);
+    CPPUNIT_ASSERT_EQUAL(std::string("inner"), spans[1].name);
+    CPPUNIT_ASSERT_EQUAL(std::string("detail"), spans[1].detail);
+    CPPUNIT_ASSERT_EQUAL(1u, spans[1].depth);
+    CPPUNIT_ASSERT(spans[1].start_us >= spans[0].start_us);
+    CPPUNIT_ASSERT(spans[1].duration_us <= spans[0].duration_us);
+
+    auto setup_span = std::find_if(
+        spans.begin(), spans.end(), [](const libdnf5::base::TraceSpan & span) { return span.name == "setup"; });
+    CPPUNIT_ASSERT(setup_span != spans.end());
+    CPPUNIT_ASSERT_EQUAL(0u, setup_span->depth);
+
+    // Spans recorded while the tracer is disabled are dropped, the recorded ones are kept until cleared
+    {
+        libdnf5::base::Tracer::Scope scope(tracer, "disabled");
+    }
+    CPPUNIT_ASSERT_EQUAL(spans.size(), tracer.get_spans().size());
+    tracer.clear();
+    CPPUNIT_ASSERT(tracer.get_spans().empty());
+}
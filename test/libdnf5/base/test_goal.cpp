@@ -21,10 +21,16 @@
 #include "test_goal.hpp"
 
 #include "../shared/utils.hpp"
+#include "synthetic_repomd.hpp"
+#include "transaction/transaction_sr.hpp"
 
+#include <fmt/format.h>
 #include <libdnf5/base/goal.hpp>
 #include <libdnf5/base/transaction_package.hpp>
 #include <libdnf5/rpm/package_query.hpp>
+#include <libdnf5/utils/fs/file.hpp>
+
+#include <set>
 
 
 CPPUNIT_TEST_SUITE_REGISTRATION(BaseGoalTest);
@@ -613,3 +619,326 @@ void BaseGoalTest::test_install_or_reinstall() {
             TransactionItemState::STARTED)};
     CPPUNIT_ASSERT_EQUAL(expected, transaction.get_transaction_packages());
 }
+
+void BaseGoalTest::test_autoremove_performance() {
+    // synth-N requires synth-(N-1), synth-(N/2) and synth-(N/3)
+    constexpr int package_count = 5000;
+    add_system_repo_synthetic(package_count);
+    for (int idx = 0; idx < package_count; ++idx) {
+        auto na = fmt::format("synth-{}.{}", idx, idx % 5 == 0 ? "noarch" : "x86_64");
+        set_system_package_reason(
+            na, idx == package_count / 2 ? TransactionItemReason::USER : TransactionItemReason::DEPENDENCY);
+    }
+    base.get_config().get_clean_requirements_on_remove_option().set(true);
+
+    for (int i = 0; i < 10; ++i) {
+        // the same as `dnf5 autoremove`
+        libdnf5::rpm::PackageQuery unneeded(base);
+        unneeded.filter_unneeded();
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(package_count / 2 - 1), unneeded.size());
+
+        libdnf5::Goal goal(base);
+        for (const auto & pkg : unneeded) {
+            goal.add_rpm_remove(pkg);
+        }
+        auto transaction = goal.resolve();
+        CPPUNIT_ASSERT_EQUAL(unneeded.size(), transaction.get_transaction_packages().size());
+    }
+}
+
+namespace {
+
+// The nevra of a package generated by write_repo_synthetic()
+std::string synthetic_nevra(std::size_t idx, std::size_t release_offset) {
+    return fmt::format(
+        "synth-{}-1.{}-{}.{}", idx, idx % 10, idx % 7 + 1 + release_offset, idx % 5 == 0 ? "noarch" : "x86_64");
+}
+
+}  // namespace
+
+std::filesystem::path BaseGoalTest::write_synthetic_upgrade_replay(std::size_t package_count) {
+    TransactionReplay replay;
+    for (std::size_t idx = 0; idx < package_count; ++idx) {
+        replay.packages.push_back(
+            {.action = TransactionItemAction::UPGRADE,
+             .reason = TransactionItemReason::DEPENDENCY,
+             .group_id = "",
+             .nevra = synthetic_nevra(idx, 10),
+             .package_path = "",
+             .repo_id = "synthetic"});
+        replay.packages.push_back(
+            {.action = TransactionItemAction::REPLACED,
+             .reason = TransactionItemReason::DEPENDENCY,
+             .group_id = "",
+             .nevra = synthetic_nevra(idx, 0),
+             .package_path = "",
+             .repo_id = "@System"});
+    }
+    auto replay_path = temp_dir->get_path() / "transaction.json";
+    libdnf5::utils::fs::File(replay_path, "w").write(json_serialize(replay));
+    return replay_path;
+}
+
+void BaseGoalTest::test_replay() {
+    add_system_repo_synthetic(20);
+    add_repo_synthetic("synthetic", 20, 10);
+
+    TransactionReplay replay = parse_transaction_replay(
+        libdnf5::utils::fs::File(write_synthetic_upgrade_replay(10), "r").read());
+    // Already installed package, the problem is reported as a warning with ignore_installed
+    replay.packages.push_back(
+        {.action = TransactionItemAction::INSTALL,
+         .reason = TransactionItemReason::USER,
+         .group_id = "",
+         .nevra = synthetic_nevra(15, 0),
+         .package_path = "",
+         .repo_id = ""});
+    // Not available package, the problem is reported as a warning with skip_unavailable
+    replay.packages.push_back(
+        {.action = TransactionItemAction::REMOVE,
+         .reason = TransactionItemReason::USER,
+         .group_id = "",
+         .nevra = "synth-99-1.0-1.x86_64",
+         .package_path = "",
+         .repo_id = ""});
+    auto replay_path = temp_dir->get_path() / "transaction-problems.json";
+    libdnf5::utils::fs::File(replay_path, "w").write(json_serialize(replay));
+
+    libdnf5::GoalJobSettings settings;
+    settings.set_ignore_installed(true);
+    settings.set_skip_unavailable(libdnf5::GoalSetting::SET_TRUE);
+    libdnf5::Goal goal(base);
+    goal.add_serialized_transaction(replay_path, settings);
+    auto transaction = goal.resolve();
+
+    std::set<std::string> expected;
+    for (std::size_t idx = 0; idx < 10; ++idx) {
+        expected.insert("Upgrade " + synthetic_nevra(idx, 10));
+        expected.insert("Replaced " + synthetic_nevra(idx, 0));
+    }
+    std::set<std::string> result;
+    for (const auto & tspkg : transaction.get_transaction_packages()) {
+        result.insert(transaction_item_action_to_string(tspkg.get_action()) + " " + tspkg.get_package().get_nevra());
+    }
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::NO_PROBLEM, transaction.get_problems());
+    CPPUNIT_ASSERT_EQUAL(expected, result);
+
+    std::set<std::pair<libdnf5::GoalProblem, std::string>> problems;
+    for (const auto & log : transaction.get_resolve_logs()) {
+        problems.emplace(log.get_problem(), *log.get_spec());
+    }
+    const std::set<std::pair<libdnf5::GoalProblem, std::string>> expected_problems{
+        {libdnf5::GoalProblem::ALREADY_INSTALLED, synthetic_nevra(15, 0)},
+        {libdnf5::GoalProblem::NOT_FOUND, "synth-99-1.0-1.x86_64"}};
+    CPPUNIT_ASSERT(expected_problems == problems);
+}
+
+void BaseGoalTest::test_replay_stored_packages() {
+    // Packages stored with the replayed transaction are added to a new repository while replaying
+    auto packages_dir = temp_dir->get_path() / "packages";
+    std::filesystem::create_directory(packages_dir);
+    for (const auto * file_name : {"one-1-1.noarch.rpm", "one-2-1.noarch.rpm"}) {
+        std::filesystem::copy_file(
+            PROJECT_BINARY_DIR "/test/data/repos-rpm/rpm-repo1/" + std::string(file_name), packages_dir / file_name);
+    }
+    // The excluded stored package has to stay invisible
+    base.get_config().get_excludepkgs_option().set(std::vector<std::string>{"one-2-1.noarch"});
+
+    TransactionReplay replay;
+    replay.packages.push_back(
+        {.action = TransactionItemAction::INSTALL,
+         .reason = TransactionItemReason::USER,
+         .group_id = "",
+         .nevra = "one-1-1.noarch",
+         .package_path = "packages/one-1-1.noarch.rpm",
+         .repo_id = "stored-repo"});
+    replay.packages.push_back(
+        {.action = TransactionItemAction::INSTALL,
+         .reason = TransactionItemReason::USER,
+         .group_id = "",
+         .nevra = "one-2-1.noarch",
+         .package_path = "packages/one-2-1.noarch.rpm",
+         .repo_id = "stored-repo"});
+    auto replay_path = temp_dir->get_path() / "transaction-stored.json";
+    libdnf5::utils::fs::File(replay_path, "w").write(json_serialize(replay));
+
+    libdnf5::GoalJobSettings settings;
+    settings.set_skip_unavailable(libdnf5::GoalSetting::SET_TRUE);
+    libdnf5::Goal goal(base);
+    goal.add_serialized_transaction(replay_path, settings);
+    auto transaction = goal.resolve();
+
+    std::vector<libdnf5::base::TransactionPackage> expected = {libdnf5::base::TransactionPackage(
+        get_pkg("one-0:1-1.noarch", "stored-repo"),
+        TransactionItemAction::INSTALL,
+        TransactionItemReason::USER,
+        TransactionItemState::STARTED)};
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::NO_PROBLEM, transaction.get_problems());
+    CPPUNIT_ASSERT_EQUAL(expected, transaction.get_transaction_packages());
+
+    std::set<std::pair<libdnf5::GoalProblem, std::string>> problems;
+    for (const auto & log : transaction.get_resolve_logs()) {
+        problems.emplace(log.get_problem(), *log.get_spec());
+    }
+    const std::set<std::pair<libdnf5::GoalProblem, std::string>> expected_problems{
+        {libdnf5::GoalProblem::NOT_FOUND, "one-2-1.noarch"}};
+    CPPUNIT_ASSERT(expected_problems == problems);
+}
+
+void BaseGoalTest::test_replay_performance() {
+    // the same as `dnf5 replay` of a large system upgrade
+    constexpr std::size_t package_count = 3000;
+    add_system_repo_synthetic(package_count);
+    add_repo_synthetic("synthetic", package_count, 10);
+    auto replay_path = write_synthetic_upgrade_replay(package_count);
+
+    libdnf5::Goal goal(base);
+    goal.add_serialized_transaction(replay_path);
+    auto transaction = goal.resolve();
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::NO_PROBLEM, transaction.get_problems());
+    CPPUNIT_ASSERT_EQUAL(2 * package_count, transaction.get_transaction_packages().size());
+}
+
+void BaseGoalTest::test_group_install() {
+    add_repo(
+        "comps",
+        write_repo_comps(
+            temp_dir->get_path(),
+            "comps",
+            "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<comps>\n"
+            "  <group>\n"
+            "    <id>synth-group</id>\n"
+            "    <name>Synthetic group</name>\n"
+            "    <packagelist>\n"
+            "      <packagereq type=\"mandatory\">synth-3</packagereq>\n"
+            "      <packagereq type=\"mandatory\">missing-package</packagereq>\n"
+            "      <packagereq type=\"default\">synth-5</packagereq>\n"
+            "      <packagereq type=\"optional\">synth-15</packagereq>\n"
+            "      <packagereq type=\"conditional\" requires=\"synth-4\">synth-9</packagereq>\n"
+            "      <packagereq type=\"conditional\" requires=\"synth-20\">synth-11</packagereq>\n"
+            "      <packagereq type=\"conditional\" requires=\"missing-package\">synth-12</packagereq>\n"
+            "    </packagelist>\n"
+            "  </group>\n"
+            "</comps>\n"));
+    add_repo_synthetic("synthetic", 30);
+
+    base.get_config().get_skip_unavailable_option().set(true);
+    libdnf5::Goal goal(base);
+    goal.add_group_install("synth-group", TransactionItemReason::USER);
+    auto transaction = goal.resolve();
+
+    // synth-3, synth-5 and synth-9 (its condition synth-4 is a dependency of synth-5) are installed with the group,
+    // the rest of synth-0 ... synth-9 are their dependencies
+    std::set<std::string> expected;
+    for (std::size_t idx = 0; idx < 10; ++idx) {
+        const bool group_package = idx == 3 || idx == 5 || idx == 9;
+        auto reason = group_package ? TransactionItemReason::GROUP : TransactionItemReason::DEPENDENCY;
+        expected.insert(transaction_item_reason_to_string(reason) + " " + synthetic_nevra(idx, 0));
+    }
+    std::set<std::string> result;
+    for (const auto & tspkg : transaction.get_transaction_packages()) {
+        CPPUNIT_ASSERT_EQUAL(TransactionItemAction::INSTALL, tspkg.get_action());
+        result.insert(transaction_item_reason_to_string(tspkg.get_reason()) + " " + tspkg.get_package().get_nevra());
+    }
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::NO_PROBLEM, transaction.get_problems());
+    CPPUNIT_ASSERT_EQUAL(expected, result);
+
+    std::set<std::pair<libdnf5::GoalProblem, std::string>> problems;
+    for (const auto & log : transaction.get_resolve_logs()) {
+        problems.emplace(log.get_problem(), *log.get_spec());
+    }
+    const std::set<std::pair<libdnf5::GoalProblem, std::string>> expected_problems{
+        {libdnf5::GoalProblem::NOT_FOUND, "missing-package"}};
+    CPPUNIT_ASSERT(expected_problems == problems);
+}
+
+void BaseGoalTest::test_group_remove_required() {
+    // Group packages still required by the remaining installed packages are kept with the DEPENDENCY reason.
+    // A group package is required if its provides match a requirement, its files do not count.
+    add_system_repo_testcase(
+        "=Ver: 3.0\n"
+        "=Pkg: grp-file 1 1 noarch\n"
+        "=Fls: /usr/bin/tool\n"
+        "=Pkg: grp-with 1 1 noarch\n"
+        "=Prv: cap-x\n"
+        "=Pkg: grp-versioned 1 1 noarch\n"
+        "=Prv: cap-v = 2\n"
+        "=Pkg: grp-versioned-old 1 1 noarch\n"
+        "=Prv: cap-w = 1\n"
+        "=Pkg: grp-unused 1 1 noarch\n"
+        "=Pkg: other-tool 1 1 noarch\n"
+        "=Prv: cap-x\n"
+        "=Prv: cap-y\n"
+        "=Prv: cap-v = 3\n"
+        "=Prv: cap-w = 2\n"
+        "=Fls: /usr/bin/tool\n"
+        "=Pkg: user-file 1 1 noarch\n"
+        "=Req: /usr/bin/tool\n"
+        "=Pkg: user-with 1 1 noarch\n"
+        "=Req: (cap-x + cap-y)\n"
+        "=Pkg: user-versioned 1 1 noarch\n"
+        "=Req: cap-v >= 2\n"
+        "=Req: cap-w > 1\n");
+    const std::vector<std::string> group_packages{
+        "grp-file", "grp-with", "grp-versioned", "grp-versioned-old", "grp-unused"};
+    for (const auto & name : group_packages) {
+        set_system_package_reason(name + ".noarch", TransactionItemReason::GROUP);
+    }
+    for (const auto * name : {"other-tool", "user-file", "user-with", "user-versioned"}) {
+        set_system_package_reason(std::string(name) + ".noarch", TransactionItemReason::USER);
+    }
+    add_system_group("synth-group", group_packages);
+
+    libdnf5::Goal goal(base);
+    goal.add_group_remove("synth-group", TransactionItemReason::USER);
+    auto transaction = goal.resolve();
+
+    const auto remove = transaction_item_action_to_string(TransactionItemAction::REMOVE);
+    const auto reason_change = transaction_item_action_to_string(TransactionItemAction::REASON_CHANGE);
+    const std::set<std::string> expected{
+        // only the file of grp-file is required by user-file
+        remove + " grp-file-1-1.noarch",
+        // cap-x of grp-with matches `(cap-x with cap-y)` of user-with, even though grp-with does not provide cap-y
+        reason_change + " grp-with-1-1.noarch",
+        // cap-v = 2 matches `cap-v >= 2` of user-versioned
+        reason_change + " grp-versioned-1-1.noarch",
+        // cap-w = 1 does not match `cap-w > 1` of user-versioned
+        remove + " grp-versioned-old-1-1.noarch",
+        remove + " grp-unused-1-1.noarch"};
+    std::set<std::string> result;
+    for (const auto & tspkg : transaction.get_transaction_packages()) {
+        result.insert(transaction_item_action_to_string(tspkg.get_action()) + " " + tspkg.get_package().get_nevra());
+    }
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::NO_PROBLEM, transaction.get_problems());
+    CPPUNIT_ASSERT_EQUAL(expected, result);
+}
+
+void BaseGoalTest::test_group_install_performance() {
+    // the same as `dnf5 group install` of a large desktop group
+    constexpr std::size_t package_count = 3000;
+    constexpr std::size_t group_package_count = 1500;
+    std::string comps =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<comps>\n  <group>\n    <id>synth-desktop</id>\n    <name>Synthetic desktop</name>\n    <packagelist>\n";
+    for (std::size_t idx = 0; idx < group_package_count; ++idx) {
+        // every group package is listed by name, every tenth one is conditional on the previous one
+        if (idx % 10 == 9) {
+            comps += fmt::format(
+                "      <packagereq type=\"conditional\" requires=\"synth-{}\">synth-{}</packagereq>\n",
+                2 * idx - 2,
+                2 * idx);
+        } else {
+            comps += fmt::format("      <packagereq type=\"mandatory\">synth-{}</packagereq>\n", 2 * idx);
+        }
+    }
+    comps += "    </packagelist>\n  </group>\n</comps>\n";
+    add_repo("comps", write_repo_comps(temp_dir->get_path(), "comps", comps));
+    add_repo_synthetic("synthetic", package_count);
+
+    libdnf5::Goal goal(base);
+    goal.add_group_install("synth-desktop", TransactionItemReason::USER);
+    auto transaction = goal.resolve();
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::NO_PROBLEM, transaction.get_problems());
+    CPPUNIT_ASSERT(transaction.get_transaction_packages().size() >= group_package_count);
+}
@@ -26,6 +26,8 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 
+#include <filesystem>
+
 
 class BaseGoalTest : public LibdnfPrivateTestCase {
     CPPUNIT_TEST_SUITE(BaseGoalTest);
@@ -56,9 +58,16 @@ class BaseGoalTest : public LibdnfPrivateTestCase {
     CPPUNIT_TEST(test_downgrade_user);
     CPPUNIT_TEST(test_distrosync);
     CPPUNIT_TEST(test_distrosync_all);
+    CPPUNIT_TEST(test_replay);
+    CPPUNIT_TEST(test_replay_stored_packages);
+    CPPUNIT_TEST(test_group_install);
+    CPPUNIT_TEST(test_group_remove_required);
 #endif
 
 #ifdef WITH_PERFORMANCE_TESTS
+    CPPUNIT_TEST(test_autoremove_performance);
+    CPPUNIT_TEST(test_replay_performance);
+    CPPUNIT_TEST(test_group_install_performance);
 #endif
 
     CPPUNIT_TEST_SUITE_END();
@@ -91,6 +100,19 @@ public:
     void test_downgrade_user();
     void test_distrosync();
     void test_distrosync_all();
+    void test_replay();
+    void test_replay_stored_packages();
+    void test_group_install();
+    void test_group_remove_required();
+
+    void test_autoremove_performance();
+    void test_replay_performance();
+    void test_group_install_performance();
+
+private:
+    // Write a replay upgrading synthetic packages 0 ... package_count - 1 generated with release offset 0
+    // to release offset 10 and return its path.
+    std::filesystem::path write_synthetic_upgrade_replay(std::size_t package_count);
 };
 
 
@@ -0,0 +1,267 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+
+#include "test_synthetic_repo.hpp"
+
+#include "../shared/private_accessor.hpp"
+#include "synthetic_repomd.hpp"
+
+#include <json.h>
+#include <libdnf5/advisory/advisory_query.hpp>
+#include <libdnf5/base/goal.hpp>
+#include <libdnf5/comps/group/query.hpp>
+#include <libdnf5/conf/const.hpp>
+#include <libdnf5/rpm/package_query.hpp>
+#include <libdnf5/transaction/transaction.hpp>
+#include <libdnf5/transaction/transaction_history.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SyntheticRepoBenchmarkTest);
+
+
+namespace {
+
+// Allows accessing private methods
+create_private_getter_template;
+create_getter(new_transaction, &libdnf5::transaction::TransactionHistory::new_transaction);
+create_getter(fill_transaction_packages, &libdnf5::transaction::Transaction::fill_transaction_packages);
+create_getter(start, &libdnf5::transaction::Transaction::start);
+create_getter(finish, &libdnf5::transaction::Transaction::finish);
+
+constexpr std::size_t DEFAULT_PACKAGE_COUNT = 20000;
+constexpr std::size_t MIN_PACKAGE_COUNT = 1000;
+constexpr std::size_t MAX_PACKAGE_COUNT = 200000;
+
+// Sets up another base with the installroot and cachedir of the test base
+void setup_base_sharing_cache(libdnf5::Base & base, const std::filesystem::path & temp_dir) {
+    base.get_config().get_installroot_option().set(temp_dir / "installroot");
+    base.get_config().get_cachedir_option().set(temp_dir / "cache");
+    base.get_config().get_optional_metadata_types_option().set(libdnf5::OPTIONAL_METADATA_TYPES);
+    base.get_config().get_plugins_option().set(false);
+    base.get_vars()->set("arch", "x86_64");
+    base.setup();
+}
+
+}  // namespace
+
+
+void SyntheticRepoBenchmarkTest::setUp() {
+    LibdnfPrivateTestCase::setUp();
+
+    package_count = DEFAULT_PACKAGE_COUNT;
+    if (const char * value = std::getenv("LIBDNF5_BENCHMARK_PACKAGES"); value != nullptr && *value != '\0') {
+        package_count = std::stoul(value);
+    }
+    CPPUNIT_ASSERT_MESSAGE(
+        "LIBDNF5_BENCHMARK_PACKAGES must be between 1000 and 200000",
+        package_count >= MIN_PACKAGE_COUNT && package_count <= MAX_PACKAGE_COUNT);
+}
+
+
+void SyntheticRepoBenchmarkTest::report(
+    const std::string & benchmark, std::chrono::duration<double> elapsed, std::size_t iterations) {
+    json_object * result = json_object_new_object();
+    json_object_object_add(result, "suite", json_object_new_string("SyntheticRepoBenchmarkTest"));
+    json_object_object_add(result, "benchmark", json_object_new_string(benchmark.c_str()));
+    if (const char * label = std::getenv("LIBDNF5_BENCHMARK_LABEL"); label != nullptr) {
+        json_object_object_add(result, "label", json_object_new_string(label));
+    }
+    json_object_object_add(result, "packages", json_object_new_int64(static_cast<int64_t>(package_count)));
+    json_object_object_add(result, "iterations", json_object_new_int64(static_cast<int64_t>(iterations)));
+    json_object_object_add(result, "seconds", json_object_new_double(elapsed.count()));
+    json_object_object_add(
+        result,
+        "seconds_per_iteration",
+        json_object_new_double(elapsed.count() / static_cast<double>(iterations)));
+
+    const char * results_path = std::getenv("LIBDNF5_BENCHMARK_RESULTS");
+    std::ofstream results(results_path != nullptr ? results_path : "benchmark_results.jsonl", std::ios::app);
+    results << json_object_to_json_string_ext(result, JSON_C_TO_STRING_PLAIN) << '\n';
+    json_object_put(result);
+}
+
+
+void SyntheticRepoBenchmarkTest::test_load_cold() {
+    // the same as the first `dnf5 makecache`, the metadata are parsed and the solv cache is written
+    auto repo_path = write_repo_repomd_synthetic(temp_dir->get_path(), "synthetic", package_count);
+
+    auto start_time = std::chrono::steady_clock::now();
+    add_repo("synthetic", repo_path);
+    report("load_cold", std::chrono::steady_clock::now() - start_time);
+
+    CPPUNIT_ASSERT_EQUAL(package_count, libdnf5::rpm::PackageQuery(base).size());
+    CPPUNIT_ASSERT_EQUAL((package_count + 99) / 100, libdnf5::comps::GroupQuery(base).size());
+}
+
+
+void SyntheticRepoBenchmarkTest::test_load_warm() {
+    // the same as any dnf5 command with valid metadata in the cache, the solv cache is loaded
+    auto repo_path = write_repo_repomd_synthetic(temp_dir->get_path(), "synthetic", package_count);
+    {
+        libdnf5::Base cache_base;
+        setup_base_sharing_cache(cache_base, temp_dir->get_path());
+        auto repo = cache_base.get_repo_sack()->create_repo("synthetic");
+        repo->get_config().get_baseurl_option().set("file://" + repo_path.native());
+        cache_base.get_repo_sack()->load_repos(libdnf5::repo::Repo::Type::AVAILABLE);
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+    add_repo("synthetic", repo_path);
+    report("load_warm", std::chrono::steady_clock::now() - start_time);
+
+    CPPUNIT_ASSERT_EQUAL(package_count, libdnf5::rpm::PackageQuery(base).size());
+}
+
+
+void SyntheticRepoBenchmarkTest::test_upgrade_resolve() {
+    // the same as `dnf5 upgrade` of the whole system
+    add_system_repo_synthetic(package_count);
+    add_repo("synthetic", write_repo_repomd_synthetic(temp_dir->get_path(), "synthetic", package_count, 10));
+
+    auto start_time = std::chrono::steady_clock::now();
+    libdnf5::Goal goal(base);
+    goal.add_rpm_upgrade();
+    auto transaction = goal.resolve();
+    report("upgrade_resolve", std::chrono::steady_clock::now() - start_time);
+
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::NO_PROBLEM, transaction.get_problems());
+    CPPUNIT_ASSERT_EQUAL(2 * package_count, transaction.get_transaction_packages().size());
+}
+
+
+void SyntheticRepoBenchmarkTest::test_repoquery() {
+    // the same as `dnf5 repoquery` with several filters
+    add_system_repo_synthetic(package_count);
+    add_repo("synthetic", write_repo_repomd_synthetic(temp_dir->get_path(), "synthetic", package_count, 10));
+
+    // Returns the sizes of the query results, they are checked outside of the timed loop
+    auto run_queries = [this]() {
+        libdnf5::rpm::PackageQuery by_name_arch(base);
+        by_name_arch.filter_name("synth-1*", libdnf5::sack::QueryCmp::GLOB);
+        by_name_arch.filter_arch("x86_64");
+
+        libdnf5::rpm::PackageQuery by_provides(base);
+        by_provides.filter_provides("libsynth42.so.1()(64bit)");
+
+        libdnf5::rpm::PackageQuery by_requires(base);
+        by_requires.filter_requires("libsynth42.so.1()(64bit)");
+
+        libdnf5::rpm::PackageQuery by_file(base);
+        by_file.filter_file("/usr/share/synth-7/data-3.dat");
+
+        libdnf5::rpm::PackageQuery upgrades(base);
+        upgrades.filter_latest_evr();
+        upgrades.filter_upgrades();
+
+        return std::array<std::size_t, 5>{
+            by_name_arch.size(), by_provides.size(), by_requires.size(), by_file.size(), upgrades.size()};
+    };
+
+    // warm up, the lazily created indexes (provides, file lists) are not part of the measurement
+    auto sizes = run_queries();
+
+    constexpr std::size_t iterations = 10;
+    auto start_time = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        sizes = run_queries();
+    }
+    report("repoquery", std::chrono::steady_clock::now() - start_time, iterations);
+
+    CPPUNIT_ASSERT(sizes[0] > 0);
+    // synth-42 in both the system and the available repo
+    CPPUNIT_ASSERT_EQUAL(std::size_t{2}, sizes[1]);
+    // synth-43, synth-84, synth-85, synth-126, synth-127 and synth-128 in both repos
+    CPPUNIT_ASSERT_EQUAL(std::size_t{12}, sizes[2]);
+    // the file is listed only in filelists of the available repo
+    CPPUNIT_ASSERT_EQUAL(std::size_t{1}, sizes[3]);
+    CPPUNIT_ASSERT_EQUAL(package_count, sizes[4]);
+}
+
+
+void SyntheticRepoBenchmarkTest::test_advisory_filter() {
+    // the same as `dnf5 advisory list --updates` and `dnf5 upgrade --security`
+    add_system_repo_synthetic(package_count);
+    add_repo("synthetic", write_repo_repomd_synthetic(temp_dir->get_path(), "synthetic", package_count, 10));
+
+    // every third advisory is a security one, each advisory lists ten packages
+    std::size_t security_packages = 0;
+    for (std::size_t block = 0; block * 10 < package_count; block += 3) {
+        security_packages += std::min(std::size_t{10}, package_count - block * 10);
+    }
+
+    libdnf5::rpm::PackageQuery installed(base);
+    installed.filter_installed();
+
+    // Returns the sizes of the query results, they are checked outside of the timed loop
+    auto run_queries = [this, &installed]() {
+        libdnf5::advisory::AdvisoryQuery advisories(base);
+        advisories.filter_packages(installed, libdnf5::sack::QueryCmp::GT);
+
+        libdnf5::advisory::AdvisoryQuery security(base);
+        security.filter_type("security");
+        libdnf5::rpm::PackageQuery upgrades(base);
+        upgrades.filter_upgrades();
+        upgrades.filter_advisories(security, libdnf5::sack::QueryCmp::GTE);
+
+        return std::array<std::size_t, 2>{advisories.size(), upgrades.size()};
+    };
+
+    // warm up, the lazily created indexes are not part of the measurement
+    auto sizes = run_queries();
+
+    constexpr std::size_t iterations = 10;
+    auto start_time = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        sizes = run_queries();
+    }
+    report("advisory_filter", std::chrono::steady_clock::now() - start_time, iterations);
+
+    CPPUNIT_ASSERT_EQUAL((package_count + 9) / 10, sizes[0]);
+    CPPUNIT_ASSERT_EQUAL(security_packages, sizes[1]);
+}
+
+
+void SyntheticRepoBenchmarkTest::test_transaction_fill() {
+    // the history part of running the transaction of `dnf5 upgrade`, the rpm transaction itself is left out
+    add_system_repo_synthetic(package_count);
+    add_repo("synthetic", write_repo_repomd_synthetic(temp_dir->get_path(), "synthetic", package_count, 10));
+
+    libdnf5::Goal goal(base);
+    goal.add_rpm_upgrade();
+    auto transaction = goal.resolve();
+    CPPUNIT_ASSERT_EQUAL(libdnf5::GoalProblem::NO_PROBLEM, transaction.get_problems());
+
+    auto start_time = std::chrono::steady_clock::now();
+    libdnf5::transaction::TransactionHistory history(base.get_weak_ptr());
+    auto db_transaction = (history.*get(new_transaction{}))();
+    (db_transaction.*get(fill_transaction_packages{}))(transaction.get_transaction_packages());
+    (db_transaction.*get(start{}))();
+    (db_transaction.*get(finish{}))(libdnf5::transaction::TransactionState::OK);
+    report("transaction_fill", std::chrono::steady_clock::now() - start_time);
+
+    CPPUNIT_ASSERT_EQUAL(2 * package_count, db_transaction.get_packages().size());
+}
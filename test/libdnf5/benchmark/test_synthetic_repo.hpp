@@ -0,0 +1,72 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+
+#ifndef LIBDNF5_TEST_BENCHMARK_SYNTHETIC_REPO_HPP
+#define LIBDNF5_TEST_BENCHMARK_SYNTHETIC_REPO_HPP
+
+
+#include "libdnf_private_test_case.hpp"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <chrono>
+#include <string>
+
+
+// Benchmarks of the common dnf5 operations on a large generated repository.
+//
+// The number of generated packages is read from the LIBDNF5_BENCHMARK_PACKAGES environment variable
+// (20000 by default, at most 200000). The results are appended as JSON lines to the file named by
+// the LIBDNF5_BENCHMARK_RESULTS environment variable (benchmark_results.jsonl by default) to be compared
+// across commits. The optional LIBDNF5_BENCHMARK_LABEL (e.g. a commit hash) is stored with each result.
+class SyntheticRepoBenchmarkTest : public LibdnfPrivateTestCase {
+    CPPUNIT_TEST_SUITE(SyntheticRepoBenchmarkTest);
+
+#ifdef WITH_PERFORMANCE_TESTS
+    CPPUNIT_TEST(test_load_cold);
+    CPPUNIT_TEST(test_load_warm);
+    CPPUNIT_TEST(test_upgrade_resolve);
+    CPPUNIT_TEST(test_repoquery);
+    CPPUNIT_TEST(test_advisory_filter);
+    CPPUNIT_TEST(test_transaction_fill);
+#endif
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+
+    void test_load_cold();
+    void test_load_warm();
+    void test_upgrade_resolve();
+    void test_repoquery();
+    void test_advisory_filter();
+    void test_transaction_fill();
+
+private:
+    // Append the result of the `benchmark` to the results file.
+    void report(const std::string & benchmark, std::chrono::duration<double> elapsed, std::size_t iterations = 1);
+
+    std::size_t package_count{0};
+};
+
+
+#endif  // LIBDNF5_TEST_BENCHMARK_SYNTHETIC_REPO_HPP
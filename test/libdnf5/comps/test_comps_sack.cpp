@@ -0,0 +1,181 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "test_comps_sack.hpp"
+
+#include "../shared/utils.hpp"
+#include "synthetic_repomd.hpp"
+
+#include <libdnf5/comps/environment/query.hpp>
+#include <libdnf5/comps/group/query.hpp>
+#include <libdnf5/utils/format.hpp>
+
+#include <set>
+#include <sstream>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CompsSackTest);
+
+
+using namespace libdnf5::comps;
+
+
+libdnf5::repo::RepoWeakPtr CompsSackTest::add_repo_comps_synthetic(
+    const std::string & repoid, std::size_t group_count, std::size_t environment_count, bool load) {
+    std::ostringstream comps;
+    comps << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<comps>\n";
+    for (std::size_t idx = 0; idx < group_count; ++idx) {
+        comps << fmt::format("  <group>\n    <id>synth-group-{}</id>\n", idx);
+        comps << fmt::format("    <name>Synthetic group {} from {}</name>\n", idx, repoid);
+        comps << fmt::format("    <description>Synthetic group {}</description>\n", idx);
+        comps << fmt::format("    <default>{}</default>\n", idx % 3 == 0 ? "true" : "false");
+        comps << fmt::format("    <uservisible>{}</uservisible>\n", idx % 2 == 0 ? "true" : "false");
+        comps << "    <packagelist>\n";
+        for (std::size_t pkg = 0; pkg < 20; ++pkg) {
+            const auto pkg_idx = (idx * 7 + pkg) % (group_count * 4 + 1);
+            switch (pkg % 4) {
+                case 0:
+                    comps << fmt::format("      <packagereq type=\"mandatory\">synth-{}</packagereq>\n", pkg_idx);
+                    break;
+                case 1:
+                    comps << fmt::format("      <packagereq type=\"default\">synth-{}</packagereq>\n", pkg_idx);
+                    break;
+                case 2:
+                    comps << fmt::format(
+                        "      <packagereq type=\"conditional\" requires=\"synth-{}\">synth-{}</packagereq>\n",
+                        pkg_idx + 1,
+                        pkg_idx);
+                    break;
+                default:
+                    comps << fmt::format("      <packagereq type=\"optional\">synth-{}</packagereq>\n", pkg_idx);
+            }
+        }
+        comps << "    </packagelist>\n  </group>\n";
+    }
+    for (std::size_t idx = 0; idx < environment_count; ++idx) {
+        comps << fmt::format("  <environment>\n    <id>synth-environment-{}</id>\n", idx);
+        comps << fmt::format("    <name>Synthetic environment {}</name>\n", idx);
+        comps << "    <grouplist>\n";
+        for (std::size_t grp = 0; grp < 10 && grp < group_count; ++grp) {
+            comps << fmt::format("      <groupid>synth-group-{}</groupid>\n", (idx * 10 + grp) % group_count);
+        }
+        comps << "    </grouplist>\n  </environment>\n";
+    }
+    comps << "</comps>\n";
+
+    return add_repo(repoid, write_repo_comps(temp_dir->get_path(), repoid, comps.str()), load);
+}
+
+
+void CompsSackTest::test_index() {
+    add_repo_comps_synthetic("synthetic-a", 30, 3, false);
+    add_repo_comps_synthetic("synthetic-b", 20, 2);
+
+    GroupQuery q_groups(base);
+    CPPUNIT_ASSERT_EQUAL(std::size_t{30}, q_groups.size());
+
+    // Groups defined in both repositories are merged, the definition from the later repoid is preferred
+    q_groups.filter_groupid("synth-group-5");
+    auto group = q_groups.get();
+    CPPUNIT_ASSERT_EQUAL((std::set<std::string>{"synthetic-a", "synthetic-b"}), group.get_repos());
+    CPPUNIT_ASSERT_EQUAL(std::string("Synthetic group 5 from synthetic-b"), group.get_name());
+    CPPUNIT_ASSERT_EQUAL(std::size_t{20}, group.get_packages().size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t{5}, group.get_packages_of_type(PackageType::CONDITIONAL).size());
+
+    q_groups = GroupQuery(base);
+    q_groups.filter_groupid("synth-group-25");
+    CPPUNIT_ASSERT_EQUAL((std::set<std::string>{"synthetic-a"}), q_groups.get().get_repos());
+
+    // The packages are the same when computed again from the sack cache
+    CPPUNIT_ASSERT_EQUAL(get_group("synth-group-5").get_packages().size(), group.get_packages().size());
+
+    EnvironmentQuery q_environments(base);
+    CPPUNIT_ASSERT_EQUAL(std::size_t{3}, q_environments.size());
+
+    // Excludes are applied on the indexed groups
+    GroupQuery q_excludes(base);
+    q_excludes.filter_groupid("synth-group-1*", libdnf5::sack::QueryCmp::GLOB);
+    base.get_comps_sack()->set_user_group_excludes(q_excludes);
+    CPPUNIT_ASSERT_EQUAL(std::size_t{19}, GroupQuery(base).size());
+    base.get_comps_sack()->clear_user_group_excludes();
+    CPPUNIT_ASSERT_EQUAL(std::size_t{30}, GroupQuery(base).size());
+}
+
+
+void CompsSackTest::test_index_disabled_repo() {
+    auto repo_a = add_repo_comps_synthetic("synthetic-a", 30, 0, false);
+    add_repo_comps_synthetic("synthetic-b", 20, 0);
+
+    // Build the index with both repositories enabled
+    CPPUNIT_ASSERT_EQUAL(std::size_t{30}, GroupQuery(base).size());
+
+    // Disabled repositories are checked when the query is created, not when the index is built
+    repo_a->disable();
+    GroupQuery q_groups(base);
+    CPPUNIT_ASSERT_EQUAL(std::size_t{20}, q_groups.size());
+    q_groups.filter_groupid("synth-group-5");
+    CPPUNIT_ASSERT_EQUAL((std::set<std::string>{"synthetic-b"}), q_groups.get().get_repos());
+
+    GroupQuery q_all_groups(base, GroupQuery::ExcludeFlags::USE_DISABLED_REPOSITORIES);
+    CPPUNIT_ASSERT_EQUAL(std::size_t{30}, q_all_groups.size());
+}
+
+
+void CompsSackTest::test_index_invalidated_by_comps_load() {
+    add_repo_comps_synthetic("synthetic-a", 10, 1);
+
+    // Build the index with the groups of the first repository
+    CPPUNIT_ASSERT_EQUAL(std::size_t{10}, GroupQuery(base).size());
+    CPPUNIT_ASSERT_EQUAL(std::string("Synthetic group 5 from synthetic-a"), get_group("synth-group-5").get_name());
+    CPPUNIT_ASSERT_EQUAL(std::size_t{1}, EnvironmentQuery(base).size());
+
+    // Loading comps of another repository rebuilds the index
+    add_repo_comps_synthetic("synthetic-b", 25, 2);
+    CPPUNIT_ASSERT_EQUAL(std::size_t{25}, GroupQuery(base).size());
+    CPPUNIT_ASSERT_EQUAL(std::string("Synthetic group 5 from synthetic-b"), get_group("synth-group-5").get_name());
+    CPPUNIT_ASSERT_EQUAL(std::size_t{2}, EnvironmentQuery(base).size());
+}
+
+
+void CompsSackTest::test_query_performance() {
+    add_repo_comps_synthetic("synthetic-a", 5000, 200, false);
+    add_repo_comps_synthetic("synthetic-b", 5000, 200);
+
+    // Group install, group list and the comps service create many queries over the same comps pool
+    std::size_t groups = 0;
+    for (int i = 0; i < 50; ++i) {
+        GroupQuery q_groups(base);
+        q_groups.filter_groupid("synth-group-1*", libdnf5::sack::QueryCmp::GLOB);
+        groups += q_groups.size();
+        EnvironmentQuery q_environments(base);
+        groups += q_environments.size();
+    }
+    CPPUNIT_ASSERT_EQUAL(std::size_t{50 * (1111 + 200)}, groups);
+
+    std::size_t packages = 0;
+    for (int i = 0; i < 5; ++i) {
+        GroupQuery q_groups(base);
+        q_groups.filter_package_name(std::vector<std::string>{"synth-1"});
+        for (auto group : q_groups) {
+            packages += group.get_packages().size();
+        }
+    }
+    CPPUNIT_ASSERT(packages > 0);
+}
@@ -0,0 +1,59 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef LIBDNF5_TEST_COMPS_COMPS_SACK_HPP
+#define LIBDNF5_TEST_COMPS_COMPS_SACK_HPP
+
+#include "libdnf_private_test_case.hpp"
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class CompsSackTest : public LibdnfPrivateTestCase {
+    CPPUNIT_TEST_SUITE(CompsSackTest);
+
+#ifndef WITH_PERFORMANCE_TESTS
+    CPPUNIT_TEST(test_index);
+    CPPUNIT_TEST(test_index_disabled_repo);
+    CPPUNIT_TEST(test_index_invalidated_by_comps_load);
+#endif
+
+#ifdef WITH_PERFORMANCE_TESTS
+    CPPUNIT_TEST(test_query_performance);
+#endif
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void test_index();
+    void test_index_disabled_repo();
+    void test_index_invalidated_by_comps_load();
+
+    void test_query_performance();
+
+private:
+    // Generate a repository with `group_count` synthetic groups and `environment_count` synthetic environments
+    // into the temp_dir and add it. Every group lists 20 packages, every environment lists 10 groups.
+    libdnf5::repo::RepoWeakPtr add_repo_comps_synthetic(
+        const std::string & repoid, std::size_t group_count, std::size_t environment_count, bool load = true);
+};
+
+#endif
@@ -21,10 +21,14 @@
 #include "libdnf_private_test_case.hpp"
 
 #include "../shared/private_accessor.hpp"
+#include "../shared/synthetic_repo.hpp"
 #include "base/base_impl.hpp"
 #include "utils/string.hpp"
 
 #include <libdnf5/rpm/nevra.hpp>
+#include <libdnf5/utils/format.hpp>
+
+#include <fstream>
 
 
 namespace {
@@ -33,6 +37,8 @@ namespace {
 create_private_getter_template;
 create_getter(priv_impl, &libdnf5::Base::p_impl);
 create_getter(add_rpm_package, &libdnf5::repo::Repo::add_rpm_package);
+create_getter(add_libsolv_testcase, &libdnf5::repo::Repo::add_libsolv_testcase);
+create_getter(add_xml_comps, &libdnf5::repo::Repo::add_xml_comps);
 
 }  // namespace
 
@@ -50,3 +56,42 @@ libdnf5::rpm::Package LibdnfPrivateTestCase::add_system_pkg(
     return (*(repo_sack->get_system_repo()).*get(add_rpm_package{}))(
         PROJECT_BINARY_DIR "/test/data/" + relative_path, false);
 }
+
+
+void LibdnfPrivateTestCase::add_system_repo_synthetic(std::size_t package_count, std::size_t release_offset) {
+    auto repo_path = write_repo_synthetic(temp_dir->get_path(), "system-synthetic", package_count, release_offset);
+    (*(repo_sack->get_system_repo()).*get(add_libsolv_testcase{}))(repo_path.native());
+}
+
+
+void LibdnfPrivateTestCase::add_system_repo_testcase(const std::string & testcase) {
+    auto repo_path = temp_dir->get_path() / "system-testcase.repo";
+    std::ofstream(repo_path) << testcase;
+    (*(repo_sack->get_system_repo()).*get(add_libsolv_testcase{}))(repo_path.native());
+}
+
+
+void LibdnfPrivateTestCase::set_system_package_reason(
+    const std::string & na, libdnf5::transaction::TransactionItemReason reason) {
+    (base.*get(priv_impl()))->get_system_state().set_package_reason(na, reason);
+}
+
+
+void LibdnfPrivateTestCase::add_system_group(const std::string & groupid, const std::vector<std::string> & packages) {
+    auto xml_path = temp_dir->get_path() / (groupid + ".xml");
+    {
+        std::ofstream xml(xml_path);
+        xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<comps>\n  <group>\n";
+        xml << fmt::format("    <id>{0}</id>\n    <name>{0}</name>\n    <packagelist>\n", groupid);
+        for (const auto & package : packages) {
+            xml << fmt::format("      <packagereq type=\"mandatory\">{}</packagereq>\n", package);
+        }
+        xml << "    </packagelist>\n  </group>\n</comps>\n";
+    }
+    (*(repo_sack->get_system_repo()).*get(add_xml_comps{}))(xml_path.native());
+
+    libdnf5::system::GroupState state;
+    state.userinstalled = true;
+    state.packages = packages;
+    (base.*get(priv_impl()))->get_system_state().set_group_state(groupid, state);
+}
@@ -27,11 +27,24 @@
 #include <libdnf5/transaction/transaction_item_reason.hpp>
 
 #include <string>
+#include <vector>
 
 class LibdnfPrivateTestCase : public BaseTestCase {
 public:
     libdnf5::rpm::Package add_system_pkg(
         const std::string & relative_path, libdnf5::transaction::TransactionItemReason reason);
+
+    // Same as add_repo_synthetic(), but the packages are loaded into the system repo.
+    void add_system_repo_synthetic(std::size_t package_count, std::size_t release_offset = 0);
+
+    // Write the libsolv testcase `testcase` content into the temp_dir and load its packages into the system repo.
+    void add_system_repo_testcase(const std::string & testcase);
+
+    // Set the reason of an installed package NA (Name.Arch) in the system state.
+    void set_system_package_reason(const std::string & na, libdnf5::transaction::TransactionItemReason reason);
+
+    // Add a user installed group with mandatory `packages` to the system repo and its state to the system state.
+    void add_system_group(const std::string & groupid, const std::vector<std::string> & packages);
 };
 
 #endif  // TEST_LIBDNF5_LIBDNF_PRIVATE_TEST_CASE_HPP
@@ -26,6 +26,8 @@
 #include "../shared/utils.hpp"
 #include "base/base_impl.hpp"
 #include "module/module_db.hpp"
+#include "module/module_sack_impl.hpp"
+#include "module/module_solve_cache.hpp"
 #include "system/state.hpp"
 
 #include <libdnf5/base/goal.hpp>
@@ -37,6 +39,8 @@
 #include <libdnf5/module/nsvcap.hpp>
 #include <libdnf5/utils/format.hpp>
 
+#include <algorithm>
+#include <filesystem>
 #include <string>
 
 CPPUNIT_TEST_SUITE_REGISTRATION(ModuleTest);
@@ -47,6 +51,10 @@ namespace {
 // Accessor of private Base::p_impl, see private_accessor.hpp
 create_private_getter_template;
 create_getter(priv_impl, &libdnf5::Base::p_impl);
+create_getter(priv_module_sack_impl, &libdnf5::module::ModuleSack::p_impl);
+create_getter(priv_module_db, &libdnf5::module::ModuleSack::Impl::module_db);
+create_getter(priv_metadata_checksums, &libdnf5::module::ModuleSack::Impl::metadata_checksums);
+create_getter(priv_active_modules_resolved, &libdnf5::module::ModuleSack::active_modules_resolved);
 
 }  // namespace
 
@@ -863,4 +871,88 @@ void ModuleTest::test_module_globs() {
     CPPUNIT_ASSERT_EQUAL(expected_active_module_specs, active_module_specs);
 }
 
+void ModuleTest::test_module_solve_cache() {
+    add_repo_repomd("repomd-modules");
+
+    auto module_sack = base.get_module_sack();
+    auto & module_sack_impl = *((*module_sack).*get(priv_module_sack_impl()));
+    const auto cachedir = base.get_config().get_cachedir_option().get_value();
+
+    // The first modular filtering solves the modules and stores the result
+    module_sack_impl.module_filtering();
+    CPPUNIT_ASSERT(std::filesystem::exists(std::filesystem::path(cachedir) / ModuleSolveCache::CACHE_FILENAME));
+
+    std::vector<std::string> expected_active_module_specs{
+        "NoStaticContext:latest:1::x86_64",
+        "berries:main:4:6c81f848:x86_64",
+        "gooseberry:5.5:2:72aaf46b6:x86_64",
+        "gooseberry:5.5:3:72aaf46b6:x86_64"};
+    std::vector<std::string> active_module_specs;
+    for (auto & module_item : module_sack->get_active_modules()) {
+        active_module_specs.push_back(module_item->get_full_identifier());
+    }
+    std::sort(active_module_specs.begin(), active_module_specs.end());
+    CPPUNIT_ASSERT_EQUAL(expected_active_module_specs, active_module_specs);
+
+    ModuleSolveCache solve_cache(base.get_weak_ptr(), cachedir);
+    const auto key = module_sack_impl.get_solve_cache_key();
+    auto cached = solve_cache.load(key);
+    CPPUNIT_ASSERT(cached.has_value());
+    CPPUNIT_ASSERT_EQUAL(expected_active_module_specs.size(), cached->active_modules.size());
+    CPPUNIT_ASSERT(!cached->include_nevras.empty());
+    CPPUNIT_ASSERT(!cached->exclude_nevras.empty());
+
+    // With the same key the stored result is used instead of solving, store a different one to verify it
+    std::vector<std::string> berries_solvable_names;
+    for (auto & module_item : module_sack->get_active_modules()) {
+        if (module_item->get_name() == "berries") {
+            berries_solvable_names.push_back(module_item->get_name_stream_staticcontext());
+        }
+    }
+    cached->active_modules = berries_solvable_names;
+    solve_cache.save(key, *cached);
+
+    auto & active_modules_resolved = (*module_sack).*get(priv_active_modules_resolved());
+    auto get_active_module_specs = [&]() {
+        std::vector<std::string> specs;
+        for (auto & module_item : module_sack->get_active_modules()) {
+            specs.push_back(module_item->get_full_identifier());
+        }
+        std::sort(specs.begin(), specs.end());
+        return specs;
+    };
+
+    // Already resolved active modules are not replaced by the stored result
+    module_sack_impl.module_filtering();
+    CPPUNIT_ASSERT_EQUAL(expected_active_module_specs, get_active_module_specs());
+
+    // The stored result is not used when the solver debug data are requested
+    active_modules_resolved = false;
+    base.get_config().get_debug_solver_option().set(true);
+    base.get_config().get_debugdir_option().set(temp_dir->get_path() / "debugdata");
+    module_sack_impl.module_filtering();
+    CPPUNIT_ASSERT_EQUAL(expected_active_module_specs, get_active_module_specs());
+    base.get_config().get_debug_solver_option().set(false);
+
+    active_modules_resolved = false;
+    module_sack_impl.module_filtering();
+    CPPUNIT_ASSERT_EQUAL(std::vector<std::string>{"berries:main:4:6c81f848:x86_64"}, get_active_module_specs());
+
+    // The order in which the module metadata were loaded does not change the key
+    auto & metadata_checksums = module_sack_impl.*get(priv_metadata_checksums());
+    metadata_checksums.push_back("other-repo:0123456789abcdef");
+    const auto key_with_other_repo = module_sack_impl.get_solve_cache_key();
+    std::reverse(metadata_checksums.begin(), metadata_checksums.end());
+    CPPUNIT_ASSERT_EQUAL(key_with_other_repo, module_sack_impl.get_solve_cache_key());
+    CPPUNIT_ASSERT(key != key_with_other_repo);
+    metadata_checksums.erase(
+        std::find(metadata_checksums.begin(), metadata_checksums.end(), "other-repo:0123456789abcdef"));
+    CPPUNIT_ASSERT_EQUAL(key, module_sack_impl.get_solve_cache_key());
+
+    // A change of the module state changes the key
+    (module_sack_impl.*get(priv_module_db()))->change_status("berries", ModuleStatus::DISABLED);
+    CPPUNIT_ASSERT(key != module_sack_impl.get_solve_cache_key());
+    CPPUNIT_ASSERT(!solve_cache.load(module_sack_impl.get_solve_cache_key()).has_value());
+}
+
 #endif  // WITH_MODULEMD
@@ -45,6 +45,7 @@ class ModuleTest : public BaseTestCase {
     CPPUNIT_TEST(test_module_disable_enabled);
     CPPUNIT_TEST(test_module_reset);
     CPPUNIT_TEST(test_module_globs);
+    CPPUNIT_TEST(test_module_solve_cache);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -62,6 +63,7 @@ public:
     void test_module_disable_enabled();
     void test_module_reset();
     void test_module_globs();
+    void test_module_solve_cache();
 
     std::unique_ptr<libdnf5::utils::fs::TempDir> temp_dir;
 };
@@ -0,0 +1,187 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "test_mirror_health.hpp"
+
+#include "../shared/utils.hpp"
+#include "repo/mirror_health.hpp"
+
+#include <fmt/format.h>
+#include <libdnf5/utils/fs/file.hpp>
+
+#include <ctime>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MirrorHealthTest);
+
+using namespace libdnf5::repo;
+
+
+void MirrorHealthTest::setUp() {
+    BaseTestCase::setUp();
+    parent_dir_path = temp_dir->get_path();
+    full_path = parent_dir_path / MirrorHealth::MEMORY_FILENAME;
+}
+
+void MirrorHealthTest::test_empty_when_storage_missing() {
+    MirrorHealth health(base.get_weak_ptr(), parent_dir_path / "unknown/path", -1);
+    CPPUNIT_ASSERT(!health.get_record("http://mirror1/"));
+
+    // nothing changed, nothing is written
+    health.save();
+    CPPUNIT_ASSERT(!std::filesystem::exists(parent_dir_path / "unknown/path"));
+}
+
+void MirrorHealthTest::test_empty_when_invalid_format() {
+    libdnf5::utils::fs::File(full_path, "w").write("[\"mirror1\", \"mirror2\"");
+    MirrorHealth health(base.get_weak_ptr(), parent_dir_path, -1);
+    CPPUNIT_ASSERT(!health.get_record("mirror1"));
+}
+
+void MirrorHealthTest::test_records_are_saved_and_loaded() {
+    {
+        MirrorHealth health(base.get_weak_ptr(), parent_dir_path / "new/path", -1);
+        health.add_success("http://mirror1/", 0.5, 1000);
+        health.add_success("http://mirror1/", 0.1, 2000);
+        health.add_failure("http://mirror2/");
+        health.add_failure("");
+        health.save();
+    }
+
+    MirrorHealth health(base.get_weak_ptr(), parent_dir_path / "new/path", -1);
+    const auto * mirror1 = health.get_record("http://mirror1/");
+    CPPUNIT_ASSERT(mirror1);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.38, mirror1->rtt, 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1300, mirror1->throughput, 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2, mirror1->successes, 1e-3);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0, mirror1->failures, 1e-6);
+
+    const auto * mirror2 = health.get_record("http://mirror2/");
+    CPPUNIT_ASSERT(mirror2);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0, mirror2->successes, 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1, mirror2->failures, 1e-6);
+
+    CPPUNIT_ASSERT(!health.get_record(""));
+}
+
+void MirrorHealthTest::test_old_records_are_dropped() {
+    libdnf5::utils::fs::File(full_path, "w")
+        .write(fmt::format(
+            "[{0}.\"http://old/\"]\nthroughput = 100.0\nsuccesses = 1.0\nupdated = 1\n"
+            "[{0}.\"http://new/\"]\nthroughput = 100.0\nsuccesses = 1.0\nupdated = {1}\n",
+            MirrorHealth::MIRRORS_TOML_KEY,
+            std::time(nullptr)));
+
+    MirrorHealth health_forever(base.get_weak_ptr(), parent_dir_path, -1);
+    CPPUNIT_ASSERT(health_forever.get_record("http://old/"));
+    CPPUNIT_ASSERT(health_forever.get_record("http://new/"));
+
+    MirrorHealth health_week(base.get_weak_ptr(), parent_dir_path, 60 * 60 * 24 * 7);
+    CPPUNIT_ASSERT(!health_week.get_record("http://old/"));
+    CPPUNIT_ASSERT(health_week.get_record("http://new/"));
+
+    // the dropped record is removed from the storage
+    health_week.save();
+    MirrorHealth health_reloaded(base.get_weak_ptr(), parent_dir_path, -1);
+    CPPUNIT_ASSERT(!health_reloaded.get_record("http://old/"));
+    CPPUNIT_ASSERT(health_reloaded.get_record("http://new/"));
+}
+
+void MirrorHealthTest::test_save_merges_stored_records() {
+    // two processes load the same records and record their downloads
+    {
+        MirrorHealth health(base.get_weak_ptr(), parent_dir_path, -1);
+        health.add_success("http://mirror1/", 0.5, 1000);
+        health.save();
+    }
+    MirrorHealth health1(base.get_weak_ptr(), parent_dir_path, -1);
+    MirrorHealth health2(base.get_weak_ptr(), parent_dir_path, -1);
+    health1.add_success("http://mirror1/", 0.1, 2000);
+    health2.add_failure("http://mirror1/");
+    health2.add_failure("http://mirror2/");
+    health1.save();
+    health2.save();
+
+    // the downloads of both are kept
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1, health2.get_record("http://mirror2/")->failures, 1e-3);
+    MirrorHealth health(base.get_weak_ptr(), parent_dir_path, -1);
+    const auto * mirror1 = health.get_record("http://mirror1/");
+    CPPUNIT_ASSERT(mirror1);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.38, mirror1->rtt, 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1300, mirror1->throughput, 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2, mirror1->successes, 1e-3);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1, mirror1->failures, 1e-3);
+    const auto * mirror2 = health.get_record("http://mirror2/");
+    CPPUNIT_ASSERT(mirror2);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1, mirror2->failures, 1e-3);
+
+    // nothing is added twice by another save
+    health2.add_failure("http://mirror2/");
+    health2.save();
+    MirrorHealth health_reloaded(base.get_weak_ptr(), parent_dir_path, -1);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2, health_reloaded.get_record("http://mirror2/")->failures, 1e-3);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1, health_reloaded.get_record("http://mirror1/")->failures, 1e-3);
+}
+
+void MirrorHealthTest::test_sort_mirrors() {
+    MirrorHealth health(base.get_weak_ptr(), parent_dir_path, -1);
+    health.add_success("http://slow/", 0.1, 100);
+    health.add_success("http://fast/", 0.1, 10000);
+    health.add_failure("http://broken/");
+    health.add_failure("http://flaky/");
+    health.add_failure("http://flaky/");
+    health.add_success("http://flaky/", 0.1, 100000);
+    health.add_success("http://recovered/", 0.1, 1000);
+    health.add_success("http://recovered/", 0.1, 1000);
+    health.add_failure("http://recovered/");
+
+    std::vector<std::string> mirrors{
+        "http://broken/",
+        "http://unknown1/",
+        "http://flaky/",
+        "http://slow/",
+        "http://recovered/",
+        "http://unknown2/",
+        "http://fast/"};
+    std::vector<std::string> expected{
+        "http://fast/",
+        "http://recovered/",
+        "http://slow/",
+        "http://unknown1/",
+        "http://unknown2/",
+        "http://flaky/",
+        "http://broken/"};
+    CPPUNIT_ASSERT_EQUAL(expected, health.sort_mirrors(mirrors));
+
+    std::vector<std::string> expected_healthy{"http://fast/", "http://recovered/", "http://slow/"};
+    CPPUNIT_ASSERT_EQUAL(expected_healthy, health.get_healthy_mirrors(mirrors));
+}
+
+void MirrorHealthTest::test_find_mirror() {
+    std::vector<std::string> mirrors{"http://mirror/", "http://mirror/fedora/", "http://other/"};
+    CPPUNIT_ASSERT_EQUAL(
+        std::string("http://mirror/fedora/"),
+        MirrorHealth::find_mirror("http://mirror/fedora/Packages/a/a-1-1.noarch.rpm", mirrors));
+    CPPUNIT_ASSERT_EQUAL(
+        std::string("http://other/"), MirrorHealth::find_mirror("http://other/repodata/repomd.xml", mirrors));
+    CPPUNIT_ASSERT_EQUAL(
+        std::string("http://unknown/repo/"),
+        MirrorHealth::find_mirror("http://unknown/repo/repodata/repomd.xml", mirrors));
+    CPPUNIT_ASSERT_EQUAL(std::string(), MirrorHealth::find_mirror("http://unknown/metalink", mirrors));
+}
@@ -0,0 +1,56 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+#ifndef LIBDNF5_TEST_REPO_MIRROR_HEALTH_HPP
+#define LIBDNF5_TEST_REPO_MIRROR_HEALTH_HPP
+
+#include "../shared/base_test_case.hpp"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <filesystem>
+
+
+class MirrorHealthTest : public BaseTestCase {
+    CPPUNIT_TEST_SUITE(MirrorHealthTest);
+    CPPUNIT_TEST(test_empty_when_storage_missing);
+    CPPUNIT_TEST(test_empty_when_invalid_format);
+    CPPUNIT_TEST(test_records_are_saved_and_loaded);
+    CPPUNIT_TEST(test_old_records_are_dropped);
+    CPPUNIT_TEST(test_save_merges_stored_records);
+    CPPUNIT_TEST(test_sort_mirrors);
+    CPPUNIT_TEST(test_find_mirror);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp() override;
+
+    void test_empty_when_storage_missing();
+    void test_empty_when_invalid_format();
+    void test_records_are_saved_and_loaded();
+    void test_old_records_are_dropped();
+    void test_save_merges_stored_records();
+    void test_sort_mirrors();
+    void test_find_mirror();
+
+private:
+    std::filesystem::path parent_dir_path;
+    std::filesystem::path full_path;
+};
+
+#endif
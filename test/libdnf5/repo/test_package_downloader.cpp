@@ -21,12 +21,14 @@
 
 #include "../shared/utils.hpp"
 #include "repo/temp_files_memory.hpp"
+#include "utils/fs/utils.hpp"
 #include "utils/string.hpp"
 
 #include "libdnf5/utils/fs/file.hpp"
 
 #include <libdnf5/base/base.hpp>
 #include <libdnf5/repo/package_downloader.hpp>
+#include <libdnf5/repo/repo_cache.hpp>
 #include <libdnf5/rpm/package_query.hpp>
 
 #include <algorithm>
@@ -180,3 +182,105 @@ void PackageDownloaderTest::test_package_downloader_temp_files_memory() {
 
     CPPUNIT_ASSERT_EQUAL(expected, memory.get_files());
 }
+
+void PackageDownloaderTest::test_package_downloader_store() {
+    add_repo_rpm("rpm-repo1");
+
+    libdnf5::rpm::PackageQuery query(base);
+    query.filter_name("one");
+    query.filter_arch("noarch");
+    CPPUNIT_ASSERT_EQUAL((size_t)2, query.size());
+
+    const auto store_dir = temp_dir->get_path() / "store";
+    base.get_config().get_package_store_dir_option().set(store_dir.string());
+
+    auto cbs_unique_ptr = std::make_unique<DownloadCallbacks>();
+    auto cbs = cbs_unique_ptr.get();
+    base.set_download_callbacks(std::move(cbs_unique_ptr));
+
+    // the first download transfers the packages and adds them to the store
+    const auto first_dir = temp_dir->get_path() / "first";
+    libdnf5::repo::PackageDownloader first_downloader(base);
+    for (const auto & package : query) {
+        first_downloader.add(package, first_dir.string());
+    }
+    first_downloader.download();
+    CPPUNIT_ASSERT_EQUAL((size_t)0, first_downloader.get_store_reused_count());
+    for (const auto & package : query) {
+        const auto checksum = package.get_checksum();
+        const auto & hex = checksum.get_checksum();
+        const auto object = store_dir / checksum.get_type_str() / hex.substr(0, 2) / hex.substr(2);
+        CPPUNIT_ASSERT(std::filesystem::exists(object));
+        // the store object is a read-only hard link to the downloaded file, it takes no additional space
+        const auto file_name = std::filesystem::path(package.get_location()).filename();
+        CPPUNIT_ASSERT(std::filesystem::equivalent(object, first_dir / file_name));
+        CPPUNIT_ASSERT(
+            (std::filesystem::status(object).permissions() & std::filesystem::perms::owner_write) ==
+            std::filesystem::perms::none);
+    }
+
+    // the second download to a different destination places the packages from the store
+    const auto second_dir = temp_dir->get_path() / "second";
+    libdnf5::repo::PackageDownloader second_downloader(base);
+    unsigned long long expected_bytes{0};
+    for (const auto & package : query) {
+        second_downloader.add(package, second_dir.string());
+        expected_bytes += package.get_download_size();
+    }
+    cbs->end_status.clear();
+    cbs->end_msg.clear();
+    second_downloader.download();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, second_downloader.get_store_reused_count());
+    CPPUNIT_ASSERT_EQUAL(expected_bytes, second_downloader.get_store_reused_bytes());
+    CPPUNIT_ASSERT(second_downloader.get_failed_packages().empty());
+    CPPUNIT_ASSERT_EQUAL(
+        (std::vector<DownloadCallbacks::TransferStatus>{
+            DownloadCallbacks::TransferStatus::ALREADYEXISTS, DownloadCallbacks::TransferStatus::ALREADYEXISTS}),
+        cbs->end_status);
+    for (const auto & package : query) {
+        const auto file_name = std::filesystem::path(package.get_location()).filename();
+        CPPUNIT_ASSERT(std::filesystem::equivalent(first_dir / file_name, second_dir / file_name));
+    }
+
+    // a damaged store object of a wrong size is not placed, the package is downloaded again
+    const auto damaged_package = *query.begin();
+    const auto damaged_checksum = damaged_package.get_checksum();
+    const auto & damaged_hex = damaged_checksum.get_checksum();
+    const auto damaged_object =
+        store_dir / damaged_checksum.get_type_str() / damaged_hex.substr(0, 2) / damaged_hex.substr(2);
+    std::filesystem::remove(damaged_object);
+    {
+        libdnf5::utils::fs::File file(damaged_object, "w");
+        file.write(std::string_view("damaged"));
+    }
+    const auto third_dir = temp_dir->get_path() / "third";
+    libdnf5::repo::PackageDownloader third_downloader(base);
+    for (const auto & package : query) {
+        third_downloader.add(package, third_dir.string());
+    }
+    third_downloader.download();
+    CPPUNIT_ASSERT_EQUAL((size_t)1, third_downloader.get_store_reused_count());
+    CPPUNIT_ASSERT(third_downloader.get_failed_packages().empty());
+    for (const auto & package : query) {
+        const auto file_name = std::filesystem::path(package.get_location()).filename();
+        CPPUNIT_ASSERT(libdnf5::utils::fs::have_files_same_content_noexcept(
+            (first_dir / file_name).c_str(), (third_dir / file_name).c_str()));
+    }
+    // the damaged object was replaced by the new download
+    const auto damaged_file_name = std::filesystem::path(damaged_package.get_location()).filename();
+    CPPUNIT_ASSERT(std::filesystem::equivalent(damaged_object, third_dir / damaged_file_name));
+
+    // objects are kept while any destination links them and removed once none does
+    std::filesystem::remove_all(first_dir);
+    std::filesystem::remove_all(second_dir);
+    libdnf5::repo::RepoCache::remove_unused_store_packages(base.get_weak_ptr());
+    for (const auto & package : query) {
+        const auto checksum = package.get_checksum();
+        const auto & hex = checksum.get_checksum();
+        CPPUNIT_ASSERT(std::filesystem::exists(store_dir / checksum.get_type_str() / hex.substr(0, 2) / hex.substr(2)));
+    }
+    std::filesystem::remove_all(third_dir);
+    auto stats = libdnf5::repo::RepoCache::remove_unused_store_packages(base.get_weak_ptr());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, stats.get_files_removed());
+    CPPUNIT_ASSERT(std::filesystem::is_empty(store_dir / damaged_checksum.get_type_str()));
+}
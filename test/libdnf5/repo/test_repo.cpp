@@ -23,7 +23,16 @@
 #include "utils/string.hpp"
 
 #include <libdnf5/base/base.hpp>
+#include <libdnf5/conf/const.hpp>
+#include <libdnf5/repo/repo_cache.hpp>
 #include <libdnf5/repo/repo_errors.hpp>
+#include <libdnf5/rpm/package_query.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
 
 
 CPPUNIT_TEST_SUITE_REGISTRATION(RepoTest);
@@ -279,3 +288,153 @@ void RepoTest::test_load_repo_gpgcheck_refused_key_shows_error() {
         1,
         signing_key_error_cnt);
 }
+
+void RepoTest::test_add_cmdline_packages() {
+    const std::string data_dir = PROJECT_BINARY_DIR "/test/data/";
+    const std::vector<std::string> paths{
+        data_dir + "repos-rpm/rpm-repo1/one-2-1.noarch.rpm",
+        data_dir + "cmdline-rpms/cmdline-1.2-3.noarch.rpm",
+        data_dir + "repos-rpm/rpm-repo1/one-1-1.noarch.rpm",
+        data_dir + "repos-rpm/rpm-repo1/one-2-1.noarch.rpm"};
+    const std::map<std::string, std::string> expected_nevras{
+        {paths[0], "one-0:2-1.noarch"}, {paths[1], "cmdline-0:1.2-3.noarch"}, {paths[2], "one-0:1-1.noarch"}};
+
+    auto check_packages = [&](const std::map<std::string, libdnf5::rpm::Package> & packages) {
+        CPPUNIT_ASSERT_EQUAL(expected_nevras.size(), packages.size());
+        for (const auto & [path, nevra] : expected_nevras) {
+            const auto & pkg = packages.at(path);
+            CPPUNIT_ASSERT_EQUAL(nevra, pkg.get_full_nevra());
+            CPPUNIT_ASSERT_EQUAL(path, pkg.get_package_path());
+            CPPUNIT_ASSERT(!pkg.get_checksum().get_checksum().empty());
+        }
+    };
+
+    const auto packages = repo_sack->add_cmdline_packages(paths, true);
+    check_packages(packages);
+
+    // the headers read are cached
+    const auto headers_cache_dir =
+        std::filesystem::path(packages.begin()->second.get_repo()->get_cachedir()) / "solv" / "rpm-headers";
+    std::size_t cached_headers{0};
+    for ([[maybe_unused]] const auto & entry : std::filesystem::directory_iterator(headers_cache_dir)) {
+        ++cached_headers;
+    }
+    CPPUNIT_ASSERT_EQUAL(expected_nevras.size(), cached_headers);
+
+    // adding the same files again loads the packages from the cache
+    check_packages(repo_sack->add_cmdline_packages(paths, true));
+
+    // headers not used for a long time are pruned
+    const auto stale_header = headers_cache_dir / "0123456789abcdef.solv";
+    std::ofstream(stale_header) << "stale";
+    std::filesystem::last_write_time(
+        stale_header, std::filesystem::file_time_type::clock::now() - std::chrono::hours(24 * 365));
+    check_packages(repo_sack->add_cmdline_packages(paths, true));
+    CPPUNIT_ASSERT(!std::filesystem::exists(stale_header));
+    cached_headers = 0;
+    for ([[maybe_unused]] const auto & entry : std::filesystem::directory_iterator(headers_cache_dir)) {
+        ++cached_headers;
+    }
+    CPPUNIT_ASSERT_EQUAL(expected_nevras.size(), cached_headers);
+
+    // the cache is removed by the packages cleanup
+    libdnf5::repo::RepoCache repo_cache(base, packages.begin()->second.get_repo()->get_cachedir());
+    auto statistics = repo_cache.remove_rpm_headers();
+    CPPUNIT_ASSERT_EQUAL(expected_nevras.size(), statistics.get_files_removed());
+    CPPUNIT_ASSERT(!std::filesystem::exists(headers_cache_dir));
+}
+
+
+namespace {
+
+std::string read_file(const std::filesystem::path & path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+// Sets up another base with the installroot and cachedir of the test base
+void setup_base_sharing_cache(libdnf5::Base & base, const std::filesystem::path & temp_dir) {
+    base.get_config().get_installroot_option().set(temp_dir / "installroot");
+    base.get_config().get_cachedir_option().set(temp_dir / "cache");
+    base.get_config().get_optional_metadata_types_option().set(libdnf5::OPTIONAL_METADATA_TYPES);
+    base.get_config().get_plugins_option().set(false);
+    base.get_vars()->set("arch", "x86_64");
+    base.setup();
+}
+
+void load_repomd_repo(libdnf5::Base & base, const std::string & repoid) {
+    auto repo = base.get_repo_sack()->create_repo(repoid);
+    repo->get_config().get_baseurl_option().set("file://" PROJECT_SOURCE_DIR "/test/data/repos-repomd/" + repoid);
+    base.get_repo_sack()->load_repos(libdnf5::repo::Repo::Type::AVAILABLE);
+}
+
+}  // namespace
+
+
+void RepoTest::test_fileprovides_cache() {
+    std::string repoid("repomd-repo1");
+    auto repo = add_repo_repomd(repoid);
+
+    const auto main_cache = std::filesystem::path(repo->get_cachedir()) / "solv" / (repoid + ".solv");
+    CPPUNIT_ASSERT(std::filesystem::exists(main_cache));
+    const auto main_cache_content = read_file(main_cache);
+
+    // a package from another repo requires a file from the filelists of repomd-repo1
+    const auto requiring_repo_path = temp_dir->get_path() / "requiring.repo";
+    std::ofstream(requiring_repo_path) << "=Ver: 3.0\n=Pkg: conf-user 1 1 noarch\n=Req: /etc/pkg.conf\n";
+
+    auto check_file_provider = [&](libdnf5::Base & base) {
+        base.get_repo_sack()->create_repo_from_libsolv_testcase("requiring", requiring_repo_path.native());
+        libdnf5::rpm::PackageQuery query(base);
+        query.filter_provides("/etc/pkg.conf");
+        CPPUNIT_ASSERT_EQUAL((size_t)1, query.size());
+        CPPUNIT_ASSERT_EQUAL(std::string("pkg-0:1.2-3.x86_64"), (*query.begin()).get_full_nevra());
+    };
+
+    // the added file provides are stored in an extension, the main cache is not rewritten
+    check_file_provider(base);
+    const auto fileprovides_cache = main_cache.parent_path() / (repoid + "-fileprovides.solvx");
+    CPPUNIT_ASSERT(std::filesystem::exists(fileprovides_cache));
+    CPPUNIT_ASSERT(main_cache_content == read_file(main_cache));
+    const auto fileprovides_cache_content = read_file(fileprovides_cache);
+
+    // a new base loads the added file provides with the main cache and rewrites none of the caches
+    libdnf5::Base base2;
+    setup_base_sharing_cache(base2, temp_dir->get_path());
+    load_repomd_repo(base2, repoid);
+
+    check_file_provider(base2);
+    CPPUNIT_ASSERT(main_cache_content == read_file(main_cache));
+    CPPUNIT_ASSERT(fileprovides_cache_content == read_file(fileprovides_cache));
+}
+
+
+void RepoTest::test_load_repos_expired_and_missing_metadata() {
+    // fill the cache of repomd-repo1 using another base
+    {
+        libdnf5::Base cache_base;
+        setup_base_sharing_cache(cache_base, temp_dir->get_path());
+        load_repomd_repo(cache_base, "repomd-repo1");
+    }
+
+    // repomd-repo1 has expired metadata that are checked for sync, repomd-comps-core has no metadata
+    // and is downloaded in the same batch
+    auto expired_repo = add_repo_repomd("repomd-repo1", false);
+    expired_repo->get_config().get_metadata_expire_option().set(0);
+    add_repo_repomd("repomd-comps-core", false);
+
+    auto dl_callbacks = std::make_unique<DownloadCallbacks>();
+    auto dl_callbacks_ptr = dl_callbacks.get();
+    base.set_download_callbacks(std::move(dl_callbacks));
+
+    repo_sack->load_repos(libdnf5::repo::Repo::Type::AVAILABLE);
+
+    CPPUNIT_ASSERT_EQUAL(2, dl_callbacks_ptr->start_cnt);
+    CPPUNIT_ASSERT_EQUAL(2, dl_callbacks_ptr->end_cnt);
+    CPPUNIT_ASSERT(dl_callbacks_ptr->end_error_messages.empty());
+
+    libdnf5::rpm::PackageQuery query(base);
+    query.filter_repo_id("repomd-repo1");
+    CPPUNIT_ASSERT_EQUAL((size_t)3, query.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("core"), get_group("core").get_groupid());
+}
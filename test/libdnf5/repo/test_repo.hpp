@@ -36,6 +36,9 @@ class RepoTest : public BaseTestCase {
     CPPUNIT_TEST(test_load_repos_load_available_system);
     CPPUNIT_TEST(test_load_repo_gpgcheck_no_keyring_error);
     CPPUNIT_TEST(test_load_repo_gpgcheck_refused_key_shows_error);
+    CPPUNIT_TEST(test_add_cmdline_packages);
+    CPPUNIT_TEST(test_fileprovides_cache);
+    CPPUNIT_TEST(test_load_repos_expired_and_missing_metadata);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -48,6 +51,9 @@ public:
     void test_load_repos_load_available_system();
     void test_load_repo_gpgcheck_no_keyring_error();
     void test_load_repo_gpgcheck_refused_key_shows_error();
+    void test_add_cmdline_packages();
+    void test_fileprovides_cache();
+    void test_load_repos_expired_and_missing_metadata();
 };
 
 #endif
@@ -0,0 +1,120 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "test_package_attr_reader.hpp"
+
+#include <libdnf5/common/exception.hpp>
+#include <libdnf5/rpm/package_attr_reader.hpp>
+#include <libdnf5/rpm/package_query.hpp>
+
+#include <functional>
+#include <map>
+#include <string>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PackageAttrReaderTest);
+
+
+void PackageAttrReaderTest::setUp() {
+    BaseTestCase::setUp();
+    add_repo_repomd("repomd-repo1");
+    add_repo_solv("solv-repo1");
+}
+
+
+void PackageAttrReaderTest::test_is_supported() {
+    CPPUNIT_ASSERT(libdnf5::rpm::PackageAttrReader::is_supported("name"));
+    CPPUNIT_ASSERT(libdnf5::rpm::PackageAttrReader::is_supported("requires"));
+    CPPUNIT_ASSERT(!libdnf5::rpm::PackageAttrReader::is_supported("files"));
+    CPPUNIT_ASSERT(!libdnf5::rpm::PackageAttrReader::is_supported("repoid"));
+    CPPUNIT_ASSERT(!libdnf5::rpm::PackageAttrReader::is_supported("unknown"));
+
+    CPPUNIT_ASSERT_THROW(libdnf5::rpm::PackageAttrReader(base.get_weak_ptr(), "files"), libdnf5::UserAssertionError);
+}
+
+
+namespace {
+
+using Package = libdnf5::rpm::Package;
+
+std::string join_reldeps(const libdnf5::rpm::ReldepList & reldeps) {
+    std::string result;
+    for (const auto & reldep : reldeps) {
+        result.append(reldep.to_string());
+        result.push_back('\n');
+    }
+    return result;
+}
+
+// Values of the attributes formatted the same way as by the repoquery --queryformat using the Package getters
+const std::map<std::string, std::function<std::string(const Package &)>> EXPECTED_VALUES = {
+    {"name", &Package::get_name},
+    {"epoch", &Package::get_epoch},
+    {"version", &Package::get_version},
+    {"release", &Package::get_release},
+    {"arch", &Package::get_arch},
+    {"evr", &Package::get_evr},
+    {"full_nevra", &Package::get_full_nevra},
+    {"group", &Package::get_group},
+    {"downloadsize", [](const Package & pkg) { return std::to_string(pkg.get_download_size()); }},
+    {"installsize", [](const Package & pkg) { return std::to_string(pkg.get_install_size()); }},
+    {"license", &Package::get_license},
+    {"source_name", &Package::get_source_name},
+    {"sourcerpm", &Package::get_sourcerpm},
+    {"buildtime", [](const Package & pkg) { return std::to_string(pkg.get_build_time()); }},
+    {"packager", &Package::get_packager},
+    {"vendor", &Package::get_vendor},
+    {"url", &Package::get_url},
+    {"summary", &Package::get_summary},
+    {"description", &Package::get_description},
+    {"provides", [](const Package & pkg) { return join_reldeps(pkg.get_provides()); }},
+    {"requires", [](const Package & pkg) { return join_reldeps(pkg.get_requires()); }},
+    {"requires_pre", [](const Package & pkg) { return join_reldeps(pkg.get_requires_pre()); }},
+    {"conflicts", [](const Package & pkg) { return join_reldeps(pkg.get_conflicts()); }},
+    {"obsoletes", [](const Package & pkg) { return join_reldeps(pkg.get_obsoletes()); }},
+    {"prereq_ignoreinst", [](const Package & pkg) { return join_reldeps(pkg.get_prereq_ignoreinst()); }},
+    {"regular_requires", [](const Package & pkg) { return join_reldeps(pkg.get_regular_requires()); }},
+    {"recommends", [](const Package & pkg) { return join_reldeps(pkg.get_recommends()); }},
+    {"suggests", [](const Package & pkg) { return join_reldeps(pkg.get_suggests()); }},
+    {"enhances", [](const Package & pkg) { return join_reldeps(pkg.get_enhances()); }},
+    {"supplements", [](const Package & pkg) { return join_reldeps(pkg.get_supplements()); }},
+    {"depends", [](const Package & pkg) { return join_reldeps(pkg.get_depends()); }},
+    {"installtime", [](const Package & pkg) { return std::to_string(pkg.get_install_time()); }},
+};
+
+}  // namespace
+
+
+void PackageAttrReaderTest::test_append_matches_package_getters() {
+    libdnf5::rpm::PackageQuery query(base);
+    CPPUNIT_ASSERT(!query.empty());
+
+    for (const auto & [attr_name, expected_value] : EXPECTED_VALUES) {
+        CPPUNIT_ASSERT(libdnf5::rpm::PackageAttrReader::is_supported(attr_name));
+        libdnf5::rpm::PackageAttrReader reader(base.get_weak_ptr(), attr_name);
+        for (const auto & package : query) {
+            // the reader appends to the existing content
+            std::string value = "prefix:";
+            reader.append(package, value);
+            CPPUNIT_ASSERT_EQUAL_MESSAGE(
+                attr_name + " of " + package.get_full_nevra(), "prefix:" + expected_value(package), value);
+        }
+    }
+}
@@ -22,12 +22,15 @@
 
 #include "../shared/private_accessor.hpp"
 #include "../shared/utils.hpp"
+#include "rpm/package_query_impl.hpp"
 
+#include <fmt/format.h>
 #include <libdnf5/rpm/checksum.hpp>
 #include <libdnf5/rpm/package_query.hpp>
 #include <libdnf5/rpm/package_set.hpp>
 
 #include <filesystem>
+#include <limits>
 #include <set>
 #include <vector>
 
@@ -40,6 +43,8 @@ namespace {
 
 create_private_getter_template;
 create_getter(add_rpm_package, &libdnf5::repo::Repo::add_rpm_package);
+create_getter(pq_impl, &libdnf5::rpm::PackageQuery::p_pq_impl);
+create_getter(parallel_evaluation, &libdnf5::rpm::PackageQuery::PQImpl::parallel_evaluation);
 
 // make constructor public so we can create Package instances in the tests
 class TestPackage : public Package {
@@ -814,6 +819,125 @@ void RpmPackageQueryTest::test_filter_chain() {
 }
 
 
+void RpmPackageQueryTest::test_filter_leaves() {
+    // synth-N requires synth-(N-1), synth-(N/2) and synth-(N/3), only the last package is not required
+    add_repo_synthetic("synthetic", 10);
+
+    PackageQuery query(base);
+    auto groups = query.filter_leaves_groups();
+    std::vector<Package> expected = {get_pkg("synth-9-0:1.9-3.x86_64")};
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(query));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), groups.size());
+    CPPUNIT_ASSERT_EQUAL(expected, groups[0]);
+
+    // Each dependency is provided by two packages now, so no edges are added and all packages are leaves
+    add_repo_synthetic("synthetic2", 10);
+
+    PackageQuery query2(base);
+    query2.filter_leaves();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(20), query2.size());
+}
+
+
+void RpmPackageQueryTest::test_filter_upgrades_downgrades() {
+    constexpr std::size_t package_count = 10000;
+    add_system_repo_synthetic(package_count, 1);
+    add_repo_synthetic("older", package_count, 0);
+    add_repo_synthetic("newer", package_count, 2);
+
+    PackageQuery installed(base);
+    installed.filter_installed();
+    PackageQuery older(base);
+    older.filter_repo_id("older");
+    PackageQuery newer(base);
+    newer.filter_repo_id("newer");
+    CPPUNIT_ASSERT_EQUAL(package_count, installed.size());
+
+    PackageQuery newer_noarch(newer);
+    newer_noarch.filter_arch("noarch");
+
+    // Evaluates all the filters, `min_range_size` and `max_workers` set how the candidates are split
+    // between the threads
+    auto evaluate = [this, &newer_noarch](Id min_range_size, unsigned int max_workers) {
+        auto tuned = [min_range_size, max_workers](PackageQuery query) {
+            (*(query.*get(pq_impl{}))).*get(parallel_evaluation{}) = {min_range_size, max_workers};
+            return query;
+        };
+
+        std::vector<std::vector<Package>> results;
+        auto upgrades = tuned(PackageQuery(base));
+        upgrades.filter_upgrades();
+        results.push_back(to_vector(upgrades));
+        auto downgrades = tuned(PackageQuery(base));
+        downgrades.filter_downgrades();
+        results.push_back(to_vector(downgrades));
+        auto upgradable = tuned(PackageQuery(base));
+        upgradable.filter_upgradable();
+        results.push_back(to_vector(upgradable));
+        auto downgradable = tuned(PackageQuery(base));
+        downgradable.filter_downgradable();
+        results.push_back(to_vector(downgradable));
+        // only candidates from the query are evaluated
+        auto noarch_upgrades = tuned(newer_noarch);
+        noarch_upgrades.filter_upgrades();
+        results.push_back(to_vector(noarch_upgrades));
+        return results;
+    };
+
+    // the candidates are evaluated by a single thread
+    auto serial_results = evaluate(std::numeric_limits<Id>::max(), 1);
+    CPPUNIT_ASSERT_EQUAL(to_vector(newer), serial_results[0]);
+    CPPUNIT_ASSERT_EQUAL(to_vector(older), serial_results[1]);
+    CPPUNIT_ASSERT_EQUAL(to_vector(installed), serial_results[2]);
+    CPPUNIT_ASSERT_EQUAL(to_vector(installed), serial_results[3]);
+    CPPUNIT_ASSERT_EQUAL(to_vector(newer_noarch), serial_results[4]);
+
+    // the candidates are split into four ranges evaluated by four threads, regardless of the hardware
+    auto parallel_results = evaluate(1024, 4);
+    for (std::size_t idx = 0; idx < serial_results.size(); ++idx) {
+        CPPUNIT_ASSERT_EQUAL(serial_results[idx], parallel_results[idx]);
+    }
+}
+
+
+void RpmPackageQueryTest::test_filter_userinstalled_unneeded() {
+    // synth-N requires synth-(N-1), synth-(N/2) and synth-(N/3), synth-9 requires all the other packages
+    add_system_repo_synthetic(10);
+    for (int idx = 0; idx < 10; ++idx) {
+        if (idx == 5) {
+            // no reason stored for synth-5, it is treated as installed by the user outside of dnf
+            continue;
+        }
+        auto na = fmt::format("synth-{}.{}", idx, idx % 5 == 0 ? "noarch" : "x86_64");
+        set_system_package_reason(
+            na,
+            idx == 9 ? libdnf5::transaction::TransactionItemReason::USER
+                     : libdnf5::transaction::TransactionItemReason::DEPENDENCY);
+    }
+
+    PackageQuery userinstalled(base);
+    userinstalled.filter_userinstalled();
+    std::vector<Package> expected = {get_pkg("synth-5-0:1.5-6.noarch", true), get_pkg("synth-9-0:1.9-3.x86_64", true)};
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(userinstalled));
+
+    PackageQuery unneeded(base);
+    unneeded.filter_unneeded();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), unneeded.size());
+
+    // Only synth-5 and its dependencies are needed now
+    set_system_package_reason("synth-9.x86_64", libdnf5::transaction::TransactionItemReason::DEPENDENCY);
+
+    PackageQuery unneeded2(base);
+    unneeded2.filter_unneeded();
+    expected = {
+        get_pkg("synth-6-0:1.6-7.x86_64", true),
+        get_pkg("synth-7-0:1.7-1.x86_64", true),
+        get_pkg("synth-8-0:1.8-2.x86_64", true),
+        get_pkg("synth-9-0:1.9-3.x86_64", true)};
+    CPPUNIT_ASSERT_EQUAL(expected, to_vector(unneeded2));
+}
+
+
 void RpmPackageQueryTest::test_resolve_pkg_spec() {
     add_repo_solv("solv-repo1");
 
@@ -999,3 +1123,32 @@ void RpmPackageQueryTest::test_filter_provides_performance() {
         query.filter_provides("prv-all");
     }
 }
+
+
+void RpmPackageQueryTest::test_filter_leaves_performance() {
+    add_repo_synthetic("synthetic", 5000);
+
+    for (int i = 0; i < 10; ++i) {
+        PackageQuery query(base);
+        query.filter_leaves();
+    }
+}
+
+
+void RpmPackageQueryTest::test_filter_upgrades_downgrades_performance() {
+    constexpr std::size_t package_count = 50000;
+    add_system_repo_synthetic(package_count, 1);
+    add_repo_synthetic("older", package_count, 0);
+    add_repo_synthetic("newer", package_count, 2);
+
+    for (int i = 0; i < 10; ++i) {
+        PackageQuery upgrades(base);
+        upgrades.filter_upgrades();
+        PackageQuery downgrades(base);
+        downgrades.filter_downgrades();
+        PackageQuery upgradable(base);
+        upgradable.filter_upgradable();
+        PackageQuery downgradable(base);
+        downgradable.filter_downgradable();
+    }
+}
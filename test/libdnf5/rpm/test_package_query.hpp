@@ -22,12 +22,12 @@
 #define TEST_LIBDNF5_RPM_PACKAGE_QUERY_HPP
 
 
-#include "../shared/base_test_case.hpp"
+#include "../libdnf_private_test_case.hpp"
 
 #include <cppunit/extensions/HelperMacros.h>
 
 
-class RpmPackageQueryTest : public BaseTestCase {
+class RpmPackageQueryTest : public LibdnfPrivateTestCase {
     CPPUNIT_TEST_SUITE(RpmPackageQueryTest);
 
 #ifndef WITH_PERFORMANCE_TESTS
@@ -51,6 +51,9 @@ class RpmPackageQueryTest : public BaseTestCase {
     CPPUNIT_TEST(test_filter_advisories);
     CPPUNIT_TEST(test_filter_checksum);
     CPPUNIT_TEST(test_filter_chain);
+    CPPUNIT_TEST(test_filter_leaves);
+    CPPUNIT_TEST(test_filter_upgrades_downgrades);
+    CPPUNIT_TEST(test_filter_userinstalled_unneeded);
     CPPUNIT_TEST(test_resolve_pkg_spec);
     CPPUNIT_TEST(test_update);
     CPPUNIT_TEST(test_intersection);
@@ -60,6 +63,8 @@ class RpmPackageQueryTest : public BaseTestCase {
 #ifdef WITH_PERFORMANCE_TESTS
     CPPUNIT_TEST(test_filter_latest_evr_performance);
     CPPUNIT_TEST(test_filter_provides_performance);
+    CPPUNIT_TEST(test_filter_leaves_performance);
+    CPPUNIT_TEST(test_filter_upgrades_downgrades_performance);
 #endif
 
     CPPUNIT_TEST_SUITE_END();
@@ -87,6 +92,9 @@ public:
     void test_filter_advisories();
     void test_filter_checksum();
     void test_filter_chain();
+    void test_filter_leaves();
+    void test_filter_upgrades_downgrades();
+    void test_filter_userinstalled_unneeded();
     void test_resolve_pkg_spec();
     void test_update();
     void test_intersection();
@@ -94,12 +102,8 @@ public:
 
     void test_filter_latest_evr_performance();
     void test_filter_provides_performance();
-
-    // TODO(jmracek) Add tests when system repo will be available
-    // PackageQuery & filter_upgrades();
-    // PackageQuery & filter_downgrades();
-    // PackageQuery & filter_upgradable();
-    // PackageQuery & filter_downgradable();
+    void test_filter_leaves_performance();
+    void test_filter_upgrades_downgrades_performance();
 };
 
 
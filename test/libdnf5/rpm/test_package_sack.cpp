@@ -20,12 +20,16 @@
 
 #include "test_package_sack.hpp"
 
+#include "../shared/private_accessor.hpp"
 #include "../shared/utils.hpp"
+#include "rpm/package_sack_impl.hpp"
 
+#include <libdnf5/rpm/package_query.hpp>
 #include <libdnf5/rpm/package_sack.hpp>
 #include <libdnf5/rpm/package_set.hpp>
 
 #include <filesystem>
+#include <map>
 #include <set>
 #include <vector>
 
@@ -42,6 +46,29 @@ public:
     TestPackage(libdnf5::Base & base, PackageId id) : libdnf5::rpm::Package(base.get_weak_ptr(), id) {}
 };
 
+// Accessor of private PackageSack::p_impl, see private_accessor.hpp
+create_private_getter_template;
+create_getter(priv_impl, &libdnf5::rpm::PackageSack::p_impl);
+
+// Map every provide of every package in the sack to the NEVRAs of its providers.
+std::map<std::string, std::set<std::string>> get_providers(libdnf5::Base & base) {
+    std::map<std::string, std::set<std::string>> providers;
+    for (const auto & pkg : PackageQuery(base)) {
+        for (const auto & provide : pkg.get_provides()) {
+            auto [it, inserted] = providers.try_emplace(provide.to_string());
+            if (!inserted) {
+                continue;
+            }
+            PackageQuery query(base);
+            query.filter_provides(provide);
+            for (const auto & provider : query) {
+                it->second.insert(provider.get_full_nevra());
+            }
+        }
+    }
+    return providers;
+}
+
 }  // namespace
 
 
@@ -123,3 +150,41 @@ void RpmPackageSackTest::test_remove_user_includes() {
     sack->remove_user_includes(*pkgset);
     CPPUNIT_ASSERT(sack->get_user_includes().contains(*pkg0) == false);
 }
+
+
+void RpmPackageSackTest::test_appended_repo_provides() {
+    auto & sack_impl = *(*sack.*get(priv_impl()));
+    add_repo_synthetic("synthetic", 50);
+
+    // make the provides ready before appending more solvables
+    PackageQuery query(base);
+    query.filter_provides("synth-3");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, query.size());
+
+    // solvables of the appended repository are merged into the existing provides
+    add_repo_synthetic("synthetic-updates", 50, 1);
+    auto appended = get_providers(base);
+
+    PackageQuery query_both(base);
+    query_both.filter_provides("synth-3");
+    CPPUNIT_ASSERT_EQUAL((size_t)2, query_both.size());
+    PackageQuery query_appended(base);
+    query_appended.filter_provides("synth-3 > 1.3-4");
+    CPPUNIT_ASSERT_EQUAL((size_t)1, query_appended.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("synth-3-0:1.3-5.x86_64"), (*query_appended.begin()).get_full_nevra());
+
+    // the result must match provides rebuilt from scratch
+    sack_impl.invalidate_provides();
+    auto rebuilt = get_providers(base);
+    CPPUNIT_ASSERT(appended == rebuilt);
+
+    // provided names unknown when the provides were computed require a full rebuild
+    add_repo_solv("solv-repo1");
+    auto appended_new_names = get_providers(base);
+    PackageQuery query_new_name(base);
+    query_new_name.filter_provides("pkg");
+    CPPUNIT_ASSERT(!query_new_name.empty());
+
+    sack_impl.invalidate_provides();
+    CPPUNIT_ASSERT(appended_new_names == get_providers(base));
+}
@@ -39,6 +39,8 @@ class RpmPackageSackTest : public BaseTestCase {
     CPPUNIT_TEST(test_add_user_includes);
     CPPUNIT_TEST(test_remove_user_includes);
 
+    CPPUNIT_TEST(test_appended_repo_provides);
+
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -52,6 +54,8 @@ public:
     void test_add_user_includes();
     void test_remove_user_includes();
 
+    void test_appended_repo_provides();
+
 private:
     std::unique_ptr<libdnf5::rpm::PackageSet> pkgset;
     std::unique_ptr<libdnf5::rpm::Package> pkg0;
@@ -20,13 +20,52 @@
 
 #include "test_match_string.hpp"
 
+#include <fnmatch.h>
 #include <libdnf5/common/exception.hpp>
 #include <libdnf5/common/sack/match_string.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <regex>
+
+#if !defined(FNM_EXTMATCH)
+#define FNM_EXTMATCH (0)
+#endif
 
 using namespace libdnf5::sack;
 
 
+namespace {
+
+std::string to_lower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::tolower(c); });
+    return value;
+}
+
+// The match_string() implementation from before StringMatcher, which prepared the pattern for every value
+bool reference_match_string(const std::string & value, QueryCmp cmp, const std::string & pattern) {
+    switch (cmp) {
+        case QueryCmp::IEXACT:
+            return to_lower(value) == to_lower(pattern);
+        case QueryCmp::GLOB:
+            return fnmatch(pattern.c_str(), value.c_str(), FNM_EXTMATCH) == 0;
+        case QueryCmp::IGLOB:
+            return fnmatch(pattern.c_str(), value.c_str(), FNM_CASEFOLD | FNM_EXTMATCH) == 0;
+        case QueryCmp::REGEX:
+            return std::regex_match(value, std::regex(pattern));
+        case QueryCmp::IREGEX:
+            return std::regex_match(value, std::regex(pattern, std::regex::icase));
+        case QueryCmp::ICONTAINS:
+            return to_lower(value).find(to_lower(pattern)) != std::string::npos;
+        default:
+            CPPUNIT_FAIL("Unsupported comparison type");
+    }
+    return false;
+}
+
+}  // namespace
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(SackMatchStringTest);
 
 
@@ -239,6 +278,17 @@ void SackMatchStringTest::test() {
             CPPUNIT_ASSERT_EQUAL(
                 !operator_tests.results[i], match_string(value, operator_tests.cmp | QueryCmp::NOT, test_patterns[i]));
         }
+
+        // The same matcher reused for several values gives the same results.
+        for (std::size_t i = 0; i < sizeof(test_patterns) / sizeof(test_patterns[0]); ++i) {
+            const StringMatcher matcher(operator_tests.cmp, test_patterns[i]);
+            const StringMatcher not_matcher(operator_tests.cmp | QueryCmp::NOT, test_patterns[i]);
+            for (int repeat = 0; repeat < 2; ++repeat) {
+                CPPUNIT_ASSERT_EQUAL(operator_tests.results[i], matcher.match(value));
+                CPPUNIT_ASSERT_EQUAL(!operator_tests.results[i], not_matcher.match(value));
+                CPPUNIT_ASSERT_EQUAL(false, matcher.match("xyz"));
+            }
+        }
     }
 }
 
@@ -257,3 +307,108 @@ void SackMatchStringTest::test_invalid() {
     CPPUNIT_ASSERT_THROW(match_string("VALUE", QueryCmp::LT, PATTERN), libdnf5::AssertionError);
     CPPUNIT_ASSERT_THROW(match_string("VALUE", QueryCmp::LTE, PATTERN), libdnf5::AssertionError);
 }
+
+
+void SackMatchStringTest::test_matcher_multiple_patterns() {
+    const StringMatcher matcher(QueryCmp::ISTARTSWITH, std::vector<std::string>{"FOO", "Bar"});
+    CPPUNIT_ASSERT(matcher.match("foobar"));
+    CPPUNIT_ASSERT(matcher.match("BARfoo"));
+    CPPUNIT_ASSERT(!matcher.match("bazfoo"));
+
+    const StringMatcher not_matcher(QueryCmp::NOT | QueryCmp::REGEX, std::vector<std::string>{"fo+", "ba[rz]"});
+    CPPUNIT_ASSERT(!not_matcher.match("fooo"));
+    CPPUNIT_ASSERT(!not_matcher.match("baz"));
+    CPPUNIT_ASSERT(not_matcher.match("bar1"));
+
+    // no pattern matches nothing, with the NOT modifier everything
+    CPPUNIT_ASSERT(!StringMatcher(QueryCmp::EXACT, std::vector<std::string>{}).match("foo"));
+    CPPUNIT_ASSERT(StringMatcher(QueryCmp::NOT | QueryCmp::EXACT, std::vector<std::string>{}).match("foo"));
+}
+
+
+void SackMatchStringTest::test_matcher_multiple_values() {
+    const std::vector<std::string> values{"libfoo", "libbar"};
+    CPPUNIT_ASSERT(StringMatcher(QueryCmp::ENDSWITH, "bar").match(values));
+    CPPUNIT_ASSERT(!StringMatcher(QueryCmp::NOT | QueryCmp::ENDSWITH, "bar").match(values));
+    CPPUNIT_ASSERT(!StringMatcher(QueryCmp::IENDSWITH, "BAZ").match(values));
+    CPPUNIT_ASSERT(StringMatcher(QueryCmp::NOT | QueryCmp::IENDSWITH, "BAZ").match(values));
+    CPPUNIT_ASSERT(StringMatcher(QueryCmp::ICONTAINS, std::vector<std::string>{"X", "BFO"}).match(values));
+    CPPUNIT_ASSERT(!StringMatcher(QueryCmp::CONTAINS, "foo").match(std::vector<std::string>{}));
+    CPPUNIT_ASSERT(StringMatcher(QueryCmp::NOT | QueryCmp::CONTAINS, "foo").match(std::vector<std::string>{}));
+}
+
+
+void SackMatchStringTest::test_matcher_glob() {
+    // literal globs and globs with a trailing '*' are matched without fnmatch, the results must not change
+    const std::string values[]{"", "kernel", "KERNEL", "kernel-core", "Kernel-Core", "kernel*", "xkernel"};
+    const std::string patterns[]{
+        "",
+        "*",
+        "kernel",
+        "KeRnEl",
+        "kernel*",
+        "KERNEL*",
+        "kernel-*",
+        "*kernel",
+        "kernel-c?re",
+        "[kK]ernel*",
+        "kernel\\*",
+        "kernel@(|-core)",
+        "!(kernel)"};
+
+    for (const auto & pattern : patterns) {
+        const StringMatcher glob(QueryCmp::GLOB, pattern);
+        const StringMatcher iglob(QueryCmp::IGLOB, pattern);
+        for (const auto & value : values) {
+            CPPUNIT_ASSERT_EQUAL_MESSAGE(
+                pattern + " ~ " + value, fnmatch(pattern.c_str(), value.c_str(), FNM_EXTMATCH) == 0, glob.match(value));
+            CPPUNIT_ASSERT_EQUAL_MESSAGE(
+                pattern + " ~ " + value,
+                fnmatch(pattern.c_str(), value.c_str(), FNM_CASEFOLD | FNM_EXTMATCH) == 0,
+                iglob.match(value));
+        }
+    }
+}
+
+
+void SackMatchStringTest::test_matcher_invalid() {
+    CPPUNIT_ASSERT_THROW(StringMatcher(QueryCmp::NOT, "PATTERN"), libdnf5::AssertionError);
+    CPPUNIT_ASSERT_THROW(StringMatcher(QueryCmp::GT, std::vector<std::string>{}), libdnf5::AssertionError);
+    CPPUNIT_ASSERT_THROW(StringMatcher(QueryCmp::REGEX, "a[b"), std::regex_error);
+    CPPUNIT_ASSERT_THROW(StringMatcher(QueryCmp::IREGEX, std::vector<std::string>{"a", "(b"}), std::regex_error);
+}
+
+
+void SackMatchStringTest::test_matcher_performance() {
+    std::vector<std::string> values;
+    for (int i = 0; i < 80000; ++i) {
+        values.push_back("FEDORA-2024-" + std::to_string(i * 7919 % 100000));
+    }
+
+    const QueryCmp cmps[]{
+        QueryCmp::REGEX, QueryCmp::IREGEX, QueryCmp::IEXACT, QueryCmp::ICONTAINS, QueryCmp::IGLOB, QueryCmp::GLOB};
+    const std::vector<std::string> patterns{
+        "fedora-2024-1*", "FEDORA-2024-[2-3]+", "FEDORA-2024-7919", "2024-99", "x"};
+    const std::size_t expected_matches[]{53, 57, 1, 897, 8888, 1};
+    for (std::size_t i = 0; i < std::size(cmps); ++i) {
+        const StringMatcher matcher(cmps[i], patterns);
+        std::size_t matched = 0;
+        for (const auto & value : values) {
+            if (matcher.match(value)) {
+                ++matched;
+            }
+        }
+
+        std::size_t reference_matched = 0;
+        for (const auto & value : values) {
+            if (std::any_of(patterns.begin(), patterns.end(), [&](const std::string & pattern) {
+                    return reference_match_string(value, cmps[i], pattern);
+                })) {
+                ++reference_matched;
+            }
+        }
+
+        CPPUNIT_ASSERT_EQUAL(reference_matched, matched);
+        CPPUNIT_ASSERT_EQUAL(expected_matches[i], matched);
+    }
+}
@@ -28,13 +28,31 @@
 
 class SackMatchStringTest : public CppUnit::TestCase {
     CPPUNIT_TEST_SUITE(SackMatchStringTest);
+
+#ifndef WITH_PERFORMANCE_TESTS
     CPPUNIT_TEST(test);
     CPPUNIT_TEST(test_invalid);
+    CPPUNIT_TEST(test_matcher_multiple_patterns);
+    CPPUNIT_TEST(test_matcher_multiple_values);
+    CPPUNIT_TEST(test_matcher_glob);
+    CPPUNIT_TEST(test_matcher_invalid);
+#endif
+
+#ifdef WITH_PERFORMANCE_TESTS
+    CPPUNIT_TEST(test_matcher_performance);
+#endif
+
     CPPUNIT_TEST_SUITE_END();
 
 public:
     void test();
     void test_invalid();
+    void test_matcher_multiple_patterns();
+    void test_matcher_multiple_values();
+    void test_matcher_glob();
+    void test_matcher_invalid();
+
+    void test_matcher_performance();
 };
 
 
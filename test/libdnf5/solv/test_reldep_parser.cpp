@@ -22,6 +22,8 @@
 
 #include "solv/reldep_parser.hpp"
 
+#include <string>
+
 CPPUNIT_TEST_SUITE_REGISTRATION(ReldepParserTest);
 
 
@@ -110,3 +112,71 @@ void ReldepParserTest::test_parser() {
         "must fail",
         !dep_parser.parse(reldep_str));
 }
+
+
+void ReldepParserTest::test_parser_white_space() {
+    libdnf5::solv::ReldepParser dep_parser;
+
+    // any white space separates the elements, trailing white space is ignored
+    CPPUNIT_ASSERT(dep_parser.parse("dnf\t>=\n1.0-1 \r"));
+    CPPUNIT_ASSERT_EQUAL(std::string("dnf"), dep_parser.get_name());
+    CPPUNIT_ASSERT(dep_parser.get_cmp_type() == libdnf5::rpm::Reldep::CmpType::GTE);
+    CPPUNIT_ASSERT_EQUAL(std::string("1.0-1"), dep_parser.get_evr());
+
+    // the operator does not need to be separated by white space
+    CPPUNIT_ASSERT(dep_parser.parse("dnf <1.0"));
+    CPPUNIT_ASSERT_EQUAL(std::string("dnf"), dep_parser.get_name());
+    CPPUNIT_ASSERT(dep_parser.get_cmp_type() == libdnf5::rpm::Reldep::CmpType::LT);
+    CPPUNIT_ASSERT_EQUAL(std::string("1.0"), dep_parser.get_evr());
+
+    // without white space in front of the operator the whole string is the name
+    CPPUNIT_ASSERT(dep_parser.parse("dnf>=1.0"));
+    CPPUNIT_ASSERT_EQUAL(std::string("dnf>=1.0"), dep_parser.get_name());
+    CPPUNIT_ASSERT(dep_parser.get_cmp_type() == libdnf5::rpm::Reldep::CmpType::NONE);
+    CPPUNIT_ASSERT_EQUAL(std::string(), dep_parser.get_evr());
+    CPPUNIT_ASSERT(!dep_parser.parse("dnf>= 1.0"));
+
+    // the evr is kept as it is after the longest operator
+    CPPUNIT_ASSERT(dep_parser.parse("dnf <==1.0"));
+    CPPUNIT_ASSERT(dep_parser.get_cmp_type() == libdnf5::rpm::Reldep::CmpType::LTE);
+    CPPUNIT_ASSERT_EQUAL(std::string("=1.0"), dep_parser.get_evr());
+
+    CPPUNIT_ASSERT(dep_parser.parse("dnf "));
+    CPPUNIT_ASSERT_EQUAL(std::string("dnf"), dep_parser.get_name());
+    CPPUNIT_ASSERT(dep_parser.get_cmp_type() == libdnf5::rpm::Reldep::CmpType::NONE);
+
+    CPPUNIT_ASSERT(dep_parser.parse(""));
+    CPPUNIT_ASSERT(dep_parser.get_name_cstr() == nullptr);
+
+    CPPUNIT_ASSERT(!dep_parser.parse("dnf >="));
+    CPPUNIT_ASSERT(!dep_parser.parse("dnf >= \t"));
+    CPPUNIT_ASSERT(!dep_parser.parse("dnf = 1.0 2.0"));
+    CPPUNIT_ASSERT(!dep_parser.parse("dnf 1.0 = 2.0"));
+
+    // long strings are parsed as well
+    const std::string long_name(10000, 'a');
+    CPPUNIT_ASSERT(dep_parser.parse(long_name + " = 1"));
+    CPPUNIT_ASSERT_EQUAL(long_name, dep_parser.get_name());
+}
+
+
+void ReldepParserTest::test_parser_performance() {
+    const std::string reldeps[]{
+        "dnf",
+        "libdnf5 >= 5.2.0-1.fc41",
+        "/usr/bin/python3",
+        "python3.13dist(requests) < 3",
+        "glibc(x86-64) = 2.40-3.fc41",
+        "invalid = 1 2"};
+
+    libdnf5::solv::ReldepParser dep_parser;
+    std::size_t parsed = 0;
+    for (int i = 0; i < 200000; ++i) {
+        for (const auto & reldep : reldeps) {
+            if (dep_parser.parse(reldep)) {
+                ++parsed;
+            }
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(std::size_t{200000 * 5}, parsed);
+}
@@ -27,7 +27,16 @@
 
 class ReldepParserTest : public CppUnit::TestCase {
     CPPUNIT_TEST_SUITE(ReldepParserTest);
+
+#ifndef WITH_PERFORMANCE_TESTS
     CPPUNIT_TEST(test_parser);
+    CPPUNIT_TEST(test_parser_white_space);
+#endif
+
+#ifdef WITH_PERFORMANCE_TESTS
+    CPPUNIT_TEST(test_parser_performance);
+#endif
+
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -35,6 +44,9 @@ public:
     void tearDown() override;
 
     void test_parser();
+    void test_parser_white_space();
+
+    void test_parser_performance();
 
 private:
 };
@@ -0,0 +1,202 @@
+// Copyright Contributors to the DNF5 project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include "test_vendor_change_manager.hpp"
+
+#include "solv/pool.hpp"
+#include "solv/vendor_change_manager.hpp"
+
+#include <fmt/format.h>
+#include <libdnf5/rpm/package_query.hpp>
+
+#include <array>
+#include <fstream>
+#include <vector>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(VendorChangeManagerTest);
+
+namespace {
+
+// Synthetic packages get vendors "Fedora Project", "RPM Fusion", "Internal Rebuilds" in turn,
+// see BaseTestCase::add_repo_synthetic()
+constexpr std::array<const char *, 3> SYNTHETIC_VENDORS{"Fedora Project", "RPM Fusion", "Internal Rebuilds"};
+
+constexpr const char * FEDORA_TO_RPMFUSION_POLICY = R"(version = '1.2'
+
+[[outgoing_vendors]]
+vendor = 'Fedora Project'
+
+[[incoming_vendors]]
+vendor = 'RPM Fusion'
+)";
+
+}  // namespace
+
+
+std::filesystem::path VendorChangeManagerTest::write_policy(const std::string & name, const std::string & content) {
+    auto path = temp_dir->get_path() / name;
+    std::ofstream policy_file(path);
+    policy_file << content;
+    return path;
+}
+
+
+Id VendorChangeManagerTest::get_solvable_id(const std::string & name) {
+    libdnf5::rpm::PackageQuery query(base);
+    query.filter_name(name);
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(1), query.size());
+    return (*query.begin()).get_id().id;
+}
+
+
+void VendorChangeManagerTest::test_vendor_change() {
+    add_repo_synthetic("synthetic", 6);
+    auto & pool = libdnf5::get_rpm_pool(base.get_weak_ptr());
+
+    libdnf5::solv::VendorChangeManager manager(pool);
+    manager.load_vendor_change_policy(write_policy("fedora_to_rpmfusion.conf", FEDORA_TO_RPMFUSION_POLICY));
+
+    // synth-0 and synth-3 are "Fedora Project", synth-1 is "RPM Fusion", synth-2 is "Internal Rebuilds"
+    auto & fedora = *pool.id2solvable(get_solvable_id("synth-0"));
+    auto & fedora2 = *pool.id2solvable(get_solvable_id("synth-3"));
+    auto & rpmfusion = *pool.id2solvable(get_solvable_id("synth-1"));
+    auto & internal = *pool.id2solvable(get_solvable_id("synth-2"));
+
+    // Repeated checks must return the same result when answered from the caches
+    for (int round = 0; round < 2; ++round) {
+        CPPUNIT_ASSERT(manager.is_vendor_change_allowed(fedora, fedora2));
+        CPPUNIT_ASSERT(manager.is_vendor_change_allowed(fedora, rpmfusion));
+        CPPUNIT_ASSERT(!manager.is_vendor_change_allowed(rpmfusion, fedora));
+        CPPUNIT_ASSERT(!manager.is_vendor_change_allowed(fedora, internal));
+        CPPUNIT_ASSERT(!manager.is_vendor_change_allowed(internal, rpmfusion));
+    }
+
+    // Bypassed incoming solvables are always accepted
+    auto & bypassed = manager.get_incoming_vendor_bypassed_solvables();
+    bypassed = libdnf5::solv::SolvMap(pool.get_nsolvables());
+    bypassed.add(get_solvable_id("synth-2"));
+    CPPUNIT_ASSERT(manager.is_vendor_change_allowed(fedora, internal));
+}
+
+
+void VendorChangeManagerTest::test_package_filters() {
+    add_repo_synthetic("synthetic", 12);
+    auto & pool = libdnf5::get_rpm_pool(base.get_weak_ptr());
+
+    libdnf5::solv::VendorChangeManager manager(pool);
+    manager.load_vendor_change_policy(write_policy("filtered.conf", R"(version = '1.2'
+
+[[outgoing_vendors]]
+vendor = 'Fedora Project'
+
+[[incoming_vendors]]
+vendor = 'RPM Fusion'
+
+[[incoming_packages]]
+filters = [ { filter = 'name', value = 'synth-1*', comparator = 'GLOB' } ]
+
+[[outgoing_packages]]
+filters = [ { filter = 'name', value = 'synth-9' } ]
+exclude = true
+
+[[outgoing_packages]]
+filters = [ { filter = 'arch', value = 'x86_64' } ]
+)"));
+
+    // synth-3 and synth-9 are x86_64 "Fedora Project", synth-0 is noarch "Fedora Project",
+    // synth-1 and synth-4 are "RPM Fusion"
+    auto & synth0 = *pool.id2solvable(get_solvable_id("synth-0"));
+    auto & synth3 = *pool.id2solvable(get_solvable_id("synth-3"));
+    auto & synth9 = *pool.id2solvable(get_solvable_id("synth-9"));
+    auto & synth1 = *pool.id2solvable(get_solvable_id("synth-1"));
+    auto & synth4 = *pool.id2solvable(get_solvable_id("synth-4"));
+
+    for (int round = 0; round < 2; ++round) {
+        CPPUNIT_ASSERT(manager.is_vendor_change_allowed(synth3, synth1));
+        CPPUNIT_ASSERT(!manager.is_vendor_change_allowed(synth3, synth4));
+        CPPUNIT_ASSERT(!manager.is_vendor_change_allowed(synth9, synth1));
+        CPPUNIT_ASSERT(!manager.is_vendor_change_allowed(synth0, synth1));
+    }
+}
+
+
+void VendorChangeManagerTest::test_policy_added_after_use() {
+    add_repo_synthetic("synthetic", 6);
+    auto & pool = libdnf5::get_rpm_pool(base.get_weak_ptr());
+
+    libdnf5::solv::VendorChangeManager manager(pool);
+    manager.load_vendor_change_policy(write_policy("fedora_to_rpmfusion.conf", FEDORA_TO_RPMFUSION_POLICY));
+
+    auto & rpmfusion = *pool.id2solvable(get_solvable_id("synth-1"));
+    auto & internal = *pool.id2solvable(get_solvable_id("synth-2"));
+    CPPUNIT_ASSERT(!manager.is_vendor_change_allowed(rpmfusion, internal));
+
+    // A newly loaded policy must not be hidden by the cached decisions
+    manager.load_vendor_change_policy(write_policy("rpmfusion_to_internal.conf", R"(version = '1.2'
+
+[[outgoing_vendors]]
+vendor = 'RPM Fusion'
+
+[[incoming_vendors]]
+vendor = 'Internal Rebuilds'
+)"));
+    CPPUNIT_ASSERT(manager.is_vendor_change_allowed(rpmfusion, internal));
+}
+
+
+void VendorChangeManagerTest::test_vendor_change_performance() {
+    constexpr std::size_t package_count = 100000;
+    constexpr int policy_count = 20;
+    constexpr int rounds = 10;
+
+    add_repo_synthetic("synthetic", package_count);
+    auto & pool = libdnf5::get_rpm_pool(base.get_weak_ptr());
+
+    // Policies between all vendor pairs, most of them with package filters that reject the packages,
+    // so that the check has to evaluate many policies before the last, permissive one.
+    libdnf5::solv::VendorChangeManager manager(pool);
+    for (int idx = 0; idx < policy_count; ++idx) {
+        const auto * outgoing_vendor = SYNTHETIC_VENDORS[static_cast<std::size_t>(idx) % SYNTHETIC_VENDORS.size()];
+        const auto * incoming_vendor =
+            SYNTHETIC_VENDORS[static_cast<std::size_t>(idx + 1) % SYNTHETIC_VENDORS.size()];
+        std::string policy = fmt::format(
+            "version = '1.2'\n\n"
+            "[[outgoing_vendors]]\nvendor = '{}'\n\n"
+            "[[incoming_vendors]]\nvendor = '{}'\n\n",
+            outgoing_vendor,
+            incoming_vendor);
+        if (idx < policy_count - 3) {
+            policy += fmt::format(
+                "[[outgoing_packages]]\n"
+                "filters = [ {{ filter = 'name', value = 'synth-*{}', comparator = 'GLOB' }},"
+                " {{ filter = 'release', value = '3', comparator = 'GT' }} ]\n\n"
+                "[[incoming_packages]]\n"
+                "filters = [ {{ filter = 'name', value = 'nonexistent-{}' }} ]\n",
+                idx % 10,
+                idx);
+        } else {
+            policy +=
+                "[[incoming_packages]]\n"
+                "filters = [ { filter = 'arch', value = 'src', comparator = 'NOT_EXACT' } ]\n";
+        }
+        manager.load_vendor_change_policy(write_policy(fmt::format("{:02}.conf", idx), policy));
+    }
+
+    std::vector<Solvable *> solvables;
+    libdnf5::rpm::PackageQuery query(base);
+    for (const auto & pkg : query) {
+        solvables.push_back(pool.id2solvable(pkg.get_id().id));
+    }
+
+    // The solver checks the same candidate transitions repeatedly, emulate it by several rounds
+    std::size_t allowed = 0;
+    for (int round = 0; round < rounds; ++round) {
+        for (std::size_t idx = 1; idx < solvables.size(); ++idx) {
+            if (manager.is_vendor_change_allowed(*solvables[idx - 1], *solvables[idx])) {
+                ++allowed;
+            }
+        }
+    }
+    CPPUNIT_ASSERT(allowed > 0);
+}
@@ -0,0 +1,47 @@
+// Copyright Contributors to the DNF5 project.
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBDNF5_TEST_SOLV_VENDOR_CHANGE_MANAGER_HPP
+#define LIBDNF5_TEST_SOLV_VENDOR_CHANGE_MANAGER_HPP
+
+#include "../shared/base_test_case.hpp"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <filesystem>
+#include <string>
+
+extern "C" {
+#include <solv/pooltypes.h>
+}
+
+
+class VendorChangeManagerTest : public BaseTestCase {
+    CPPUNIT_TEST_SUITE(VendorChangeManagerTest);
+
+#ifndef WITH_PERFORMANCE_TESTS
+    CPPUNIT_TEST(test_vendor_change);
+    CPPUNIT_TEST(test_package_filters);
+    CPPUNIT_TEST(test_policy_added_after_use);
+#endif
+
+#ifdef WITH_PERFORMANCE_TESTS
+    CPPUNIT_TEST(test_vendor_change_performance);
+#endif
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void test_vendor_change();
+    void test_package_filters();
+    void test_policy_added_after_use();
+
+    void test_vendor_change_performance();
+
+private:
+    std::filesystem::path write_policy(const std::string & name, const std::string & content);
+    Id get_solvable_id(const std::string & name);
+};
+
+
+#endif  // LIBDNF5_TEST_SOLV_VENDOR_CHANGE_MANAGER_HPP
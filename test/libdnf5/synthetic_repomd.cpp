@@ -0,0 +1,273 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+
+#include "synthetic_repomd.hpp"
+
+#include "utils/checksum.hpp"
+
+#include <libdnf5/utils/format.hpp>
+#include <libdnf5/utils/fs/file.hpp>
+
+#include <array>
+#include <fstream>
+#include <set>
+
+
+void write_repomd(
+    const std::filesystem::path & repo_path, const std::vector<std::pair<std::string, std::string>> & data_files) {
+    std::ofstream repomd(repo_path / "repodata" / "repomd.xml");
+    repomd << "<repomd xmlns=\"http://linux.duke.edu/metadata/repo\">\n  <revision>1550000000</revision>\n";
+    for (const auto & [type, file_name] : data_files) {
+        const auto file_path = repo_path / "repodata" / file_name;
+        const auto checksum = libdnf5::utils::get_sha256_hex(libdnf5::utils::fs::File(file_path, "r").read());
+        const auto size = std::filesystem::file_size(file_path);
+        repomd << fmt::format("  <data type=\"{}\">\n", type);
+        repomd << fmt::format("    <checksum type=\"sha256\">{}</checksum>\n", checksum);
+        repomd << fmt::format("    <open-checksum type=\"sha256\">{}</open-checksum>\n", checksum);
+        repomd << fmt::format("    <location href=\"repodata/{}\" />\n", file_name);
+        repomd << fmt::format("    <size>{0}</size>\n    <open-size>{0}</open-size>\n", size);
+        repomd << "  </data>\n";
+    }
+    repomd << "</repomd>\n";
+}
+
+
+std::filesystem::path write_repo_comps(
+    const std::filesystem::path & dir, const std::string & repoid, const std::string & comps) {
+    auto repo_path = dir / repoid;
+    std::filesystem::create_directories(repo_path / "repodata");
+    std::ofstream(repo_path / "repodata" / "comps.xml") << comps;
+    std::ofstream(repo_path / "repodata" / "primary.xml")
+        << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           "<metadata xmlns=\"http://linux.duke.edu/metadata/common\" packages=\"0\">\n</metadata>\n";
+    write_repomd(repo_path, {{"primary", "primary.xml"}, {"group", "comps.xml"}});
+
+    return repo_path;
+}
+
+
+std::filesystem::path write_repo_repomd_synthetic(
+    const std::filesystem::path & dir,
+    const std::string & repoid,
+    std::size_t package_count,
+    std::size_t release_offset) {
+    constexpr std::array<const char *, 3> vendors{"Fedora Project", "RPM Fusion", "Internal Rebuilds"};
+    constexpr std::array<const char *, 3> advisory_types{"security", "bugfix", "enhancement"};
+    constexpr std::array<const char *, 4> severities{"Low", "Moderate", "Important", "Critical"};
+
+    auto repo_path = dir / (repoid + "-repomd");
+    std::filesystem::create_directories(repo_path / "repodata");
+    std::ofstream primary(repo_path / "repodata" / "primary.xml");
+    std::ofstream filelists(repo_path / "repodata" / "filelists.xml");
+    primary << fmt::format(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<metadata xmlns=\"http://linux.duke.edu/metadata/common\" xmlns:rpm=\"http://linux.duke.edu/metadata/rpm\" "
+        "packages=\"{}\">\n",
+        package_count);
+    filelists << fmt::format(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<filelists xmlns=\"http://linux.duke.edu/metadata/filelists\" packages=\"{}\">\n",
+        package_count);
+
+    std::vector<std::string> files;
+    for (std::size_t idx = 0; idx < package_count; ++idx) {
+        const char * arch = idx % 5 == 0 ? "noarch" : "x86_64";
+        const auto version = fmt::format("1.{}", idx % 10);
+        const auto release = idx % 7 + 1 + release_offset;
+        const auto pkgid = fmt::format("{:064x}", idx * 1000 + release_offset);
+
+        // Only binaries and configuration files are listed in primary, the same as createrepo_c does
+        files = {fmt::format("/usr/lib64/libsynth{}.so.1", idx), fmt::format("/usr/lib64/libsynth{}.so.1.0.0", idx)};
+        if (idx % 3 == 0) {
+            files.push_back(fmt::format("/usr/bin/synth{}", idx));
+        }
+        if (idx % 6 == 0) {
+            files.push_back(fmt::format("/etc/synth-{}.conf", idx));
+        }
+        files.push_back(fmt::format("/usr/share/doc/synth-{}/README", idx));
+        files.push_back(fmt::format("/usr/share/licenses/synth-{}/LICENSE", idx));
+        for (std::size_t data = 0; data < idx % 8; ++data) {
+            files.push_back(fmt::format("/usr/share/synth-{}/data-{}.dat", idx, data));
+        }
+
+        primary << fmt::format(
+            "<package type=\"rpm\">\n"
+            "  <name>synth-{0}</name>\n"
+            "  <arch>{1}</arch>\n"
+            "  <version epoch=\"0\" ver=\"{2}\" rel=\"{3}\"/>\n"
+            "  <checksum type=\"sha256\" pkgid=\"YES\">{4}</checksum>\n"
+            "  <summary>Synthetic package {0}</summary>\n"
+            "  <description>Synthetic package {0} generated for performance tests.</description>\n"
+            "  <packager>Packager</packager>\n"
+            "  <url>http://example.com/synth-{0}</url>\n"
+            "  <time file=\"1550000000\" build=\"1550000000\"/>\n"
+            "  <size package=\"{5}\" installed=\"{6}\" archive=\"{7}\"/>\n"
+            "  <location href=\"Packages/synth-{0}-{2}-{3}.{1}.rpm\"/>\n"
+            "  <format>\n"
+            "    <rpm:license>MIT</rpm:license>\n"
+            "    <rpm:vendor>{8}</rpm:vendor>\n"
+            "    <rpm:group>Unspecified</rpm:group>\n"
+            "    <rpm:buildhost>localhost</rpm:buildhost>\n"
+            "    <rpm:sourcerpm>synth-{0}-{2}-{3}.src.rpm</rpm:sourcerpm>\n"
+            "    <rpm:header-range start=\"4504\" end=\"{9}\"/>\n"
+            "    <rpm:provides>\n"
+            "      <rpm:entry name=\"synth-{0}\" flags=\"EQ\" epoch=\"0\" ver=\"{2}\" rel=\"{3}\"/>\n"
+            "      <rpm:entry name=\"libsynth{0}.so.1()(64bit)\"/>\n"
+            "      <rpm:entry name=\"libsynth{0}.so.1(SYNTH_1.0)(64bit)\"/>\n",
+            idx,
+            arch,
+            version,
+            release,
+            pkgid,
+            10000 + idx % 1000 * 100,
+            40000 + idx % 1000 * 400,
+            41000 + idx % 1000 * 400,
+            vendors[idx % vendors.size()],
+            6000 + idx % 1000);
+        if (idx % 5 != 0) {
+            primary << fmt::format(
+                "      <rpm:entry name=\"synth-{}(x86-64)\" flags=\"EQ\" epoch=\"0\" ver=\"{}\" rel=\"{}\"/>\n",
+                idx,
+                version,
+                release);
+        }
+        if (idx == 0) {
+            primary << "      <rpm:entry name=\"rtld(GNU_HASH)\"/>\n";
+        }
+        primary << "    </rpm:provides>\n";
+
+        // Each package requires libraries of up to three previously generated packages, the same as
+        // write_repo_synthetic() generates, and some packages require a binary of another package.
+        if (idx > 0) {
+            primary << "    <rpm:requires>\n      <rpm:entry name=\"rtld(GNU_HASH)\"/>\n";
+            for (auto req : std::set<std::size_t>{idx - 1, idx / 2, idx / 3}) {
+                primary << fmt::format("      <rpm:entry name=\"libsynth{}.so.1()(64bit)\"/>\n", req);
+            }
+            primary << fmt::format("      <rpm:entry name=\"libsynth{}.so.1(SYNTH_1.0)(64bit)\"/>\n", idx - 1);
+            if (idx % 4 == 1 && idx > 4) {
+                primary << fmt::format("      <rpm:entry name=\"/usr/bin/synth{}\"/>\n", idx / 4 * 3);
+            }
+            primary << "    </rpm:requires>\n";
+        }
+        for (const auto & file : files) {
+            if (file.starts_with("/usr/bin/") || file.starts_with("/etc/")) {
+                primary << fmt::format("    <file>{}</file>\n", file);
+            }
+        }
+        primary << "  </format>\n</package>\n";
+
+        filelists << fmt::format(
+            "<package pkgid=\"{}\" name=\"synth-{}\" arch=\"{}\">\n"
+            "  <version epoch=\"0\" ver=\"{}\" rel=\"{}\"/>\n",
+            pkgid,
+            idx,
+            arch,
+            version,
+            release);
+        for (const auto & file : files) {
+            filelists << fmt::format("  <file>{}</file>\n", file);
+        }
+        filelists << fmt::format("  <file type=\"dir\">/usr/share/synth-{}</file>\n</package>\n", idx);
+    }
+    primary << "</metadata>\n";
+    filelists << "</filelists>\n";
+    primary.close();
+    filelists.close();
+
+    // One advisory for every block of ten packages
+    std::ofstream updateinfo(repo_path / "repodata" / "updateinfo.xml");
+    updateinfo << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<updates>\n";
+    for (std::size_t block = 0; block * 10 < package_count; ++block) {
+        const char * type = advisory_types[block % advisory_types.size()];
+        updateinfo << fmt::format(
+            "  <update from=\"synthetic@example.com\" status=\"stable\" type=\"{0}\" version=\"1\">\n"
+            "    <id>SYNTH-{1}-{2}</id>\n"
+            "    <title>Synthetic {0} update {2}</title>\n"
+            "    <release>Synthetic</release>\n"
+            "    <issued date=\"2019-02-22 15:30:01\"/>\n"
+            "    <severity>{3}</severity>\n"
+            "    <references>\n"
+            "      <reference href=\"https://bugzilla.example.com/{2}\" id=\"{2}\" type=\"bugzilla\" title=\"{2}\"/>\n",
+            type,
+            release_offset,
+            block,
+            severities[block % severities.size()]);
+        if (block % advisory_types.size() == 0) {
+            updateinfo << fmt::format(
+                "      <reference href=\"https://cve.example.com/CVE-2019-{0}\" id=\"CVE-2019-{0}\" type=\"cve\" "
+                "title=\"CVE-2019-{0}\"/>\n",
+                block);
+        }
+        updateinfo << "    </references>\n"
+                      "    <description>Synthetic advisory</description>\n"
+                      "    <pkglist>\n"
+                      "      <collection short=\"synthetic\">\n"
+                      "        <name>Synthetic</name>\n";
+        for (std::size_t idx = block * 10; idx < block * 10 + 10 && idx < package_count; ++idx) {
+            const char * arch = idx % 5 == 0 ? "noarch" : "x86_64";
+            updateinfo << fmt::format(
+                "        <package name=\"synth-{0}\" version=\"1.{1}\" release=\"{2}\" epoch=\"0\" arch=\"{3}\">\n"
+                "          <filename>synth-{0}-1.{1}-{2}.{3}.rpm</filename>\n"
+                "        </package>\n",
+                idx,
+                idx % 10,
+                idx % 7 + 1 + release_offset,
+                arch);
+        }
+        updateinfo << "      </collection>\n    </pkglist>\n  </update>\n";
+    }
+    updateinfo << "</updates>\n";
+    updateinfo.close();
+
+    // One group for every block of hundred packages, each lists twenty of them
+    std::ofstream comps(repo_path / "repodata" / "comps.xml");
+    comps << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<comps>\n";
+    const std::size_t group_count = (package_count + 99) / 100;
+    for (std::size_t group = 0; group < group_count; ++group) {
+        comps << fmt::format(
+            "  <group>\n    <id>synth-group-{0}</id>\n    <name>Synthetic group {0}</name>\n"
+            "    <description>Synthetic group {0}</description>\n    <packagelist>\n",
+            group);
+        for (std::size_t idx = group * 100; idx < group * 100 + 20 && idx < package_count; ++idx) {
+            comps << fmt::format(
+                "      <packagereq type=\"{}\">synth-{}</packagereq>\n",
+                idx % 4 == 0 ? "mandatory" : (idx % 4 == 1 ? "default" : "optional"),
+                idx);
+        }
+        comps << "    </packagelist>\n  </group>\n";
+    }
+    comps << "  <environment>\n    <id>synth-environment</id>\n    <name>Synthetic environment</name>\n"
+             "    <grouplist>\n";
+    for (std::size_t group = 0; group < 10 && group < group_count; ++group) {
+        comps << fmt::format("      <groupid>synth-group-{}</groupid>\n", group);
+    }
+    comps << "    </grouplist>\n  </environment>\n</comps>\n";
+    comps.close();
+
+    write_repomd(
+        repo_path,
+        {{"primary", "primary.xml"},
+         {"filelists", "filelists.xml"},
+         {"updateinfo", "updateinfo.xml"},
+         {"group", "comps.xml"}});
+
+    return repo_path;
+}
@@ -0,0 +1,51 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+
+#ifndef TEST_LIBDNF5_SYNTHETIC_REPOMD_HPP
+#define TEST_LIBDNF5_SYNTHETIC_REPOMD_HPP
+
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+// Generators of repomd repositories for tests. Each writes a repo into `dir` and returns its path.
+
+// Write a repomd repo with `package_count` synthetic packages.
+// The packages have the same NEVRAs and library dependencies as those of write_repo_synthetic(). The repo also
+// contains filelists, an advisory for every ten packages and a group for every hundred packages.
+// Intended for performance tests, the generated content is deterministic.
+std::filesystem::path write_repo_repomd_synthetic(
+    const std::filesystem::path & dir,
+    const std::string & repoid,
+    std::size_t package_count,
+    std::size_t release_offset = 0);
+
+// Write a repomd repo with the `comps` xml content and no packages.
+std::filesystem::path write_repo_comps(
+    const std::filesystem::path & dir, const std::string & repoid, const std::string & comps);
+
+// Write repodata/repomd.xml of the repo in `repo_path` listing the <type, file name> pairs of `data_files`.
+void write_repomd(
+    const std::filesystem::path & repo_path, const std::vector<std::pair<std::string, std::string>> & data_files);
+
+#endif  // TEST_LIBDNF5_SYNTHETIC_REPOMD_HPP
@@ -21,6 +21,7 @@
 #include "base_test_case.hpp"
 
 #include "logger_redirector.hpp"
+#include "synthetic_repo.hpp"
 #include "test_logger.hpp"
 #include "utils.hpp"
 
@@ -69,6 +70,13 @@ libdnf5::repo::RepoWeakPtr BaseTestCase::add_repo_solv(const std::string & repoi
 }
 
 
+libdnf5::repo::RepoWeakPtr BaseTestCase::add_repo_synthetic(
+    const std::string & repoid, std::size_t package_count, std::size_t release_offset) {
+    auto repo_path = write_repo_synthetic(temp_dir->get_path(), repoid, package_count, release_offset);
+    return repo_sack->create_repo_from_libsolv_testcase(repoid.c_str(), repo_path.native());
+}
+
+
 libdnf5::advisory::Advisory BaseTestCase::get_advisory(const std::string & name) {
     // This is used for testing queries as well, hence we don't use the AdvisoryQuery facility for filtering
     libdnf5::advisory::AdvisorySet advisories = libdnf5::advisory::AdvisoryQuery(base);
@@ -57,6 +57,10 @@ public:
     // Add (load) a repo from PROJECT_SOURCE_DIR/test/data/repos-solv/<repoid>.repo
     libdnf5::repo::RepoWeakPtr add_repo_solv(const std::string & repoid);
 
+    // Generate a repo with write_repo_synthetic() into the temp_dir and add (load) it.
+    libdnf5::repo::RepoWeakPtr add_repo_synthetic(
+        const std::string & repoid, std::size_t package_count, std::size_t release_offset = 0);
+
     libdnf5::advisory::Advisory get_advisory(const std::string & name);
 
     libdnf5::comps::Environment get_environment(const std::string & environmentid, bool installed = false);
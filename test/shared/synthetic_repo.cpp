@@ -0,0 +1,59 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "synthetic_repo.hpp"
+
+#include <libdnf5/utils/format.hpp>
+
+#include <array>
+#include <fstream>
+#include <set>
+
+
+std::filesystem::path write_repo_synthetic(
+    const std::filesystem::path & dir,
+    const std::string & repoid,
+    std::size_t package_count,
+    std::size_t release_offset) {
+    constexpr std::array<const char *, 3> vendors{"Fedora Project", "RPM Fusion", "Internal Rebuilds"};
+
+    auto repo_path = dir / (repoid + ".repo");
+    std::ofstream repo_file(repo_path);
+    repo_file << "=Ver: 3.0\n";
+    for (std::size_t idx = 0; idx < package_count; ++idx) {
+        const char * arch = idx % 5 == 0 ? "noarch" : "x86_64";
+        const auto release = idx % 7 + 1 + release_offset;
+        repo_file << fmt::format("=Pkg: synth-{} 1.{} {} {}\n", idx, idx % 10, release, arch);
+        repo_file << fmt::format("=Prv: synth-{} = 1.{}-{}\n", idx, idx % 10, release);
+        repo_file << fmt::format("=Prv: libsynth{}.so.1()(64bit)\n", idx);
+        std::set<std::size_t> required;
+        if (idx > 0) {
+            required = {idx - 1, idx / 2, idx / 3};
+        }
+        for (auto req : required) {
+            repo_file << fmt::format("=Req: libsynth{}.so.1()(64bit)\n", req);
+        }
+        repo_file << fmt::format("=Fls: /usr/lib64/libsynth{}.so.1\n", idx);
+        repo_file << fmt::format("=Vnd: {}\n", vendors[idx % vendors.size()]);
+    }
+    repo_file.close();
+
+    return repo_path;
+}
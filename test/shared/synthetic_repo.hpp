@@ -0,0 +1,39 @@
+// Copyright Contributors to the DNF5 project.
+// Copyright Contributors to the libdnf project.
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This file is part of libdnf: https://github.com/rpm-software-management/libdnf/
+//
+// Libdnf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Libdnf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with libdnf.  If not, see <https://www.gnu.org/licenses/>.
+
+
+
+#ifndef TEST_LIBDNF5_SYNTHETIC_REPO_HPP
+#define TEST_LIBDNF5_SYNTHETIC_REPO_HPP
+
+#include <filesystem>
+#include <string>
+
+
+// Write a libsolv testcase repo with `package_count` synthetic packages into `dir` and return its path.
+// Each package provides a library and requires libraries of up to three previously generated packages.
+// `release_offset` is added to the release of every package to generate newer versions of the same packages.
+// Intended for performance tests, the generated content is deterministic.
+std::filesystem::path write_repo_synthetic(
+    const std::filesystem::path & dir,
+    const std::string & repoid,
+    std::size_t package_count,
+    std::size_t release_offset = 0);
+
+#endif  // TEST_LIBDNF5_SYNTHETIC_REPO_HPP